@@ -116,6 +116,31 @@ typedef struct _ClutterLayoutInfo       ClutterLayoutInfo;
 typedef struct _ClutterTransformInfo    ClutterTransformInfo;
 typedef struct _ClutterAnimationInfo    ClutterAnimationInfo;
 
+/*< private >
+ * ClutterActorTypedProperty:
+ *
+ * The animatable properties of #ClutterActor which transitions can set
+ * without going through #GValue, see clutter_actor_get_typed_property().
+ */
+typedef enum _ClutterActorTypedProperty
+{
+  CLUTTER_ACTOR_TYPED_PROPERTY_NONE = 0,
+
+  CLUTTER_ACTOR_TYPED_PROPERTY_X,
+  CLUTTER_ACTOR_TYPED_PROPERTY_Y,
+  CLUTTER_ACTOR_TYPED_PROPERTY_Z_POSITION,
+  CLUTTER_ACTOR_TYPED_PROPERTY_OPACITY,
+  CLUTTER_ACTOR_TYPED_PROPERTY_TRANSLATION_X,
+  CLUTTER_ACTOR_TYPED_PROPERTY_TRANSLATION_Y,
+  CLUTTER_ACTOR_TYPED_PROPERTY_TRANSLATION_Z,
+  CLUTTER_ACTOR_TYPED_PROPERTY_SCALE_X,
+  CLUTTER_ACTOR_TYPED_PROPERTY_SCALE_Y,
+  CLUTTER_ACTOR_TYPED_PROPERTY_SCALE_Z,
+  CLUTTER_ACTOR_TYPED_PROPERTY_ROTATION_ANGLE_X,
+  CLUTTER_ACTOR_TYPED_PROPERTY_ROTATION_ANGLE_Y,
+  CLUTTER_ACTOR_TYPED_PROPERTY_ROTATION_ANGLE_Z,
+} ClutterActorTypedProperty;
+
 struct _SizeRequest
 {
   guint  age;
@@ -281,6 +306,25 @@ void                            _clutter_actor_detach_clone
 void                            _clutter_actor_queue_redraw_on_clones                   (ClutterActor *actor);
 void                            _clutter_actor_queue_relayout_on_clones                 (ClutterActor *actor);
 void                            _clutter_actor_queue_only_relayout                      (ClutterActor *actor);
+
+gboolean clutter_actor_resolve_deferred_relayout (ClutterActor *self);
+
+void clutter_actor_reallocate (ClutterActor *self);
+
+void clutter_actor_finish_deferred_relayout (ClutterActor *self);
+
+ClutterActorTypedProperty clutter_actor_get_typed_property (ClutterActor *self,
+                                                            GParamSpec   *pspec);
+
+void clutter_actor_set_typed_property (ClutterActor              *self,
+                                       ClutterActorTypedProperty  property,
+                                       double                     value);
+
+#ifdef CLUTTER_ENABLE_DEBUG
+void clutter_actor_take_size_request_stats (unsigned int *n_hits,
+                                            unsigned int *n_misses);
+#endif
+
 void                            clutter_actor_clear_stage_views_recursive               (ClutterActor *actor);
 
 float                           clutter_actor_get_real_resource_scale                   (ClutterActor *actor);
@@ -677,9 +677,16 @@ typedef enum
                               */
 } MapStateChange;
 
-/* 3 entries should be a good compromise, few layout managers
- * will ask for 3 different preferred size in each allocation cycle */
-#define N_CACHED_SIZE_REQUESTS 3
+/* 4 entries should be a good compromise, few layout managers
+ * will ask for more than 3 different preferred sizes in each allocation
+ * cycle, and the least recently used entry is the one replaced */
+#define N_CACHED_SIZE_REQUESTS 4
+
+#ifdef CLUTTER_ENABLE_DEBUG
+/* statistics of the size request caches, see CLUTTER_DEBUG=size-requests */
+static unsigned int n_size_request_hits = 0;
+static unsigned int n_size_request_misses = 0;
+#endif
 
 struct _ClutterActorPrivate
 {
@@ -690,6 +697,17 @@ struct _ClutterActorPrivate
   SizeRequest width_requests[N_CACHED_SIZE_REQUESTS];
   SizeRequest height_requests[N_CACHED_SIZE_REQUESTS];
 
+  /* the size requests at the time a relayout was deferred; the parent
+   * only needs a relayout if they changed, see
+   * clutter_actor_resolve_deferred_relayout() */
+  SizeRequest deferred_width_requests[N_CACHED_SIZE_REQUESTS];
+  SizeRequest deferred_height_requests[N_CACHED_SIZE_REQUESTS];
+
+  /* the box last passed to clutter_actor_allocate() by the parent, and
+   * the request mode at that time */
+  ClutterActorBox parent_allocation;
+  ClutterRequestMode allocation_request_mode;
+
   /* An age of 0 means the entry is not set */
   guint cached_height_age;
   guint cached_width_age;
@@ -705,6 +723,12 @@ struct _ClutterActorPrivate
   /* the cached transformation matrix; see apply_transform() */
   CoglMatrix transform;
 
+  /* the cached transformation from the actor to its top-level, and the
+   * paint volume in eye coordinates; see ensure_absolute_transform() */
+  CoglMatrix absolute_transform;
+  ClutterActor *absolute_transform_root;
+  ClutterPaintVolume absolute_paint_volume;
+
   float resource_scale;
 
   guint8 opacity;
@@ -791,6 +815,15 @@ struct _ClutterActorPrivate
 
   ClutterColor bg_color;
 
+  /* The paint nodes built for the actor itself (background, content and
+   * the paint_node() virtual) on the last paint; reused as long as the
+   * actor didn't queue a redraw and nothing they depend on changed.
+   */
+  ClutterPaintNode *retained_paint_node;
+  float retained_paint_node_width;
+  float retained_paint_node_height;
+  guint8 retained_paint_node_opacity;
+
 #ifdef CLUTTER_ENABLE_DEBUG
   /* a string used for debugging messages */
   gchar *debug_name;
@@ -843,6 +876,8 @@ struct _ClutterActorPrivate
   guint last_paint_volume_valid     : 1;
   guint in_clone_paint              : 1;
   guint transform_valid             : 1;
+  guint absolute_transform_valid    : 1;
+  guint absolute_paint_volume_valid : 1;
   /* This is TRUE if anything has queued a redraw since we were last
      painted. In this case effect_to_redraw will point to an effect
      the redraw was queued from or it will be NULL if the redraw was
@@ -859,6 +894,14 @@ struct _ClutterActorPrivate
   guint had_effects_on_last_paint_volume_update : 1;
   guint absolute_origin_changed     : 1;
   guint needs_update_stage_views    : 1;
+  guint needs_paint_node_update     : 1;
+  /* the last allocation used a fixed position or size */
+  guint allocation_was_fixed        : 1;
+  /* queued in the stage to resolve a deferred relayout */
+  guint relayout_deferred           : 1;
+  /* a descendant deferred its relayout, so our size requests may be
+   * outdated until the stage has resolved it */
+  guint has_deferred_relayouts      : 1;
 };
 
 enum
@@ -1732,6 +1775,8 @@ clutter_actor_real_unmap (ClutterActor *self)
 
   CLUTTER_ACTOR_UNSET_FLAGS (self, CLUTTER_ACTOR_MAPPED);
 
+  g_clear_pointer (&priv->retained_paint_node, clutter_paint_node_unref);
+
   if (priv->unmapped_paint_branch_counter == 0)
     {
       /* clear the contents of the last paint volume, so that hiding + moving +
@@ -2528,9 +2573,43 @@ clutter_actor_notify_if_geometry_changed (ClutterActor          *self,
   g_object_thaw_notify (obj);
 }
 
+static void
+invalidate_absolute_transform (ClutterActor *actor)
+{
+  actor->priv->absolute_transform_valid = FALSE;
+  actor->priv->absolute_paint_volume_valid = FALSE;
+}
+
+static ClutterActorTraverseVisitFlags
+invalidate_absolute_transform_cb (ClutterActor *actor,
+                                  int           depth,
+                                  gpointer      user_data)
+{
+  invalidate_absolute_transform (actor);
+
+  return CLUTTER_ACTOR_TRAVERSE_VISIT_CONTINUE;
+}
+
+/* Called when @actor is added to or removed from a parent; the absolute
+ * transforms cached in its subtree were relative to the old top-level */
+static void
+hierarchy_changed (ClutterActor *actor)
+{
+  if (CLUTTER_ACTOR_IN_DESTRUCTION (actor))
+    return;
+
+  _clutter_actor_traverse (actor,
+                           CLUTTER_ACTOR_TRAVERSE_DEPTH_FIRST,
+                           invalidate_absolute_transform_cb,
+                           NULL,
+                           NULL);
+}
+
 static void
 absolute_geometry_changed (ClutterActor *actor)
 {
+  invalidate_absolute_transform (actor);
+
   queue_update_stage_views (actor);
 }
 
@@ -2776,15 +2855,240 @@ clutter_actor_needs_relayout (ClutterActor *self)
           priv->needs_allocation);
 }
 
+/* Whether the allocation of @self doesn't depend on its size requests */
+static inline gboolean
+clutter_actor_has_fixed_layout (ClutterActor *self)
+{
+  ClutterActorPrivate *priv = self->priv;
+
+  return (priv->position_set ||
+          priv->min_width_set ||
+          priv->natural_width_set ||
+          priv->min_height_set ||
+          priv->natural_height_set ||
+          priv->request_mode == CLUTTER_REQUEST_CONTENT_SIZE);
+}
+
+/*
+ * Whether a relayout of @self can be handled without relaying out its
+ * parent right away. This is only possible for an actor that has been
+ * allocated by its parent according to its size requests, and whose
+ * layout is otherwise valid; the stage then checks whether the size
+ * requests changed before relaying out, and if they didn't, only
+ * allocates @self again using the same box.
+ */
+static gboolean
+clutter_actor_can_defer_relayout (ClutterActor *self)
+{
+  ClutterActorPrivate *priv = self->priv;
+
+  if (G_UNLIKELY (clutter_paint_debug_flags &
+                  CLUTTER_DEBUG_DISABLE_DEFERRED_RELAYOUT))
+    return FALSE;
+
+  if (priv->parent == NULL ||
+      priv->parent->flags & CLUTTER_ACTOR_NO_LAYOUT ||
+      !CLUTTER_ACTOR_IS_MAPPED (self))
+    return FALSE;
+
+  if (priv->needs_width_request ||
+      priv->needs_height_request ||
+      priv->needs_allocation ||
+      priv->needs_compute_expand)
+    return FALSE;
+
+  if (priv->allocation_was_fixed || clutter_actor_has_fixed_layout (self))
+    return FALSE;
+
+  return _clutter_actor_get_stage_internal (self) != NULL;
+}
+
+/* Copies the size requests of @src that are set to the start of @dest,
+ * and clears the rest of @dest */
+static void
+copy_set_size_requests (SizeRequest       *dest,
+                        const SizeRequest *src)
+{
+  int i, n_set = 0;
+
+  for (i = 0; i < N_CACHED_SIZE_REQUESTS; i++)
+    {
+      if (src[i].age != 0)
+        dest[n_set++] = src[i];
+    }
+
+  memset (dest + n_set, 0,
+          (N_CACHED_SIZE_REQUESTS - n_set) * sizeof (SizeRequest));
+}
+
+static void
+clutter_actor_defer_relayout (ClutterActor *self)
+{
+  ClutterActorPrivate *priv = self->priv;
+  ClutterActor *stage = _clutter_actor_get_stage_internal (self);
+  ClutterActor *iter;
+
+  copy_set_size_requests (priv->deferred_width_requests,
+                          priv->width_requests);
+  copy_set_size_requests (priv->deferred_height_requests,
+                          priv->height_requests);
+
+  priv->relayout_deferred = TRUE;
+
+  /* Even if the ancestors don't need a relayout, their paint volumes
+   * may depend on ours */
+  for (iter = priv->parent; iter != NULL; iter = iter->priv->parent)
+    {
+      iter->priv->needs_paint_volume_update = TRUE;
+      iter->priv->has_deferred_relayouts = TRUE;
+    }
+
+  clutter_stage_defer_actor_relayout (CLUTTER_STAGE (stage), self);
+}
+
+static gboolean
+clutter_actor_size_requests_changed (ClutterActor      *self,
+                                     const SizeRequest *size_requests,
+                                     ClutterOrientation orientation)
+{
+  int i;
+
+  for (i = 0; i < N_CACHED_SIZE_REQUESTS; i++)
+    {
+      const SizeRequest *sr = &size_requests[i];
+      float min_size, natural_size;
+
+      /* the set entries come first, see clutter_actor_defer_relayout() */
+      if (sr->age == 0)
+        break;
+
+      if (orientation == CLUTTER_ORIENTATION_HORIZONTAL)
+        clutter_actor_get_preferred_width (self, sr->for_size,
+                                           &min_size,
+                                           &natural_size);
+      else
+        clutter_actor_get_preferred_height (self, sr->for_size,
+                                            &min_size,
+                                            &natural_size);
+
+      if (min_size != sr->min_size || natural_size != sr->natural_size)
+        return TRUE;
+    }
+
+  return FALSE;
+}
+
+/*
+ * clutter_actor_resolve_deferred_relayout:
+ * @self: a #ClutterActor
+ *
+ * Checks whether the size requests of @self, which deferred its
+ * relayout, changed since its parent allocated it. If they did, the
+ * relayout is propagated to the parent.
+ *
+ * Return value: %TRUE if @self can be allocated again in place, using
+ *   clutter_actor_reallocate()
+ */
+gboolean
+clutter_actor_resolve_deferred_relayout (ClutterActor *self)
+{
+  ClutterActorPrivate *priv = self->priv;
+
+  if (!priv->relayout_deferred)
+    return FALSE;
+
+  priv->relayout_deferred = FALSE;
+
+  if (CLUTTER_ACTOR_IN_DESTRUCTION (self) || priv->parent == NULL)
+    return FALSE;
+
+  if (CLUTTER_ACTOR_IS_MAPPED (self) &&
+      !priv->needs_compute_expand &&
+      !priv->allocation_was_fixed &&
+      !clutter_actor_has_fixed_layout (self) &&
+      priv->request_mode == priv->allocation_request_mode &&
+      !clutter_actor_size_requests_changed (self,
+                                            priv->deferred_width_requests,
+                                            CLUTTER_ORIENTATION_HORIZONTAL) &&
+      !clutter_actor_size_requests_changed (self,
+                                            priv->deferred_height_requests,
+                                            CLUTTER_ORIENTATION_VERTICAL))
+    {
+      CLUTTER_NOTE (LAYOUT, "Size requests of '%s' unchanged, skipping "
+                    "relayout of the parent",
+                    _clutter_actor_get_debug_name (self));
+      return TRUE;
+    }
+
+  _clutter_actor_queue_only_relayout (priv->parent);
+
+  return FALSE;
+}
+
+/*
+ * clutter_actor_reallocate:
+ * @self: a #ClutterActor
+ *
+ * Allocates @self again using the box it was last allocated by its
+ * parent, after clutter_actor_resolve_deferred_relayout() found its
+ * size requests unchanged.
+ */
+void
+clutter_actor_reallocate (ClutterActor *self)
+{
+  ClutterActorPrivate *priv = self->priv;
+
+  if (!priv->needs_allocation ||
+      priv->parent == NULL ||
+      !CLUTTER_ACTOR_IS_MAPPED (self))
+    return;
+
+  clutter_actor_allocate (self, &priv->parent_allocation);
+}
+
+/* Clears the has_deferred_relayouts flag on the ancestors of @self */
+void
+clutter_actor_finish_deferred_relayout (ClutterActor *self)
+{
+  ClutterActor *iter;
+
+  for (iter = self->priv->parent;
+       iter != NULL && iter->priv->has_deferred_relayouts;
+       iter = iter->priv->parent)
+    iter->priv->has_deferred_relayouts = FALSE;
+}
+
+/* Makes sure size requests of @self take deferred relayouts of its
+ * descendants into account */
+static inline void
+clutter_actor_ensure_deferred_relayouts (ClutterActor *self)
+{
+  ClutterActor *stage;
+
+  if (G_LIKELY (!self->priv->has_deferred_relayouts))
+    return;
+
+  stage = _clutter_actor_get_stage_internal (self);
+  if (stage != NULL)
+    clutter_stage_resolve_deferred_relayouts (CLUTTER_STAGE (stage));
+
+  self->priv->has_deferred_relayouts = FALSE;
+}
+
 static void
 clutter_actor_real_queue_relayout (ClutterActor *self)
 {
   ClutterActorPrivate *priv = self->priv;
+  gboolean defer_relayout;
 
   /* no point in queueing a redraw on a destroyed actor */
   if (CLUTTER_ACTOR_IN_DESTRUCTION (self))
     return;
 
+  defer_relayout = clutter_actor_can_defer_relayout (self);
+  if (defer_relayout)
+    clutter_actor_defer_relayout (self);
+
   priv->needs_width_request  = TRUE;
   priv->needs_height_request = TRUE;
   priv->needs_allocation     = TRUE;
@@ -2808,7 +3112,7 @@ clutter_actor_real_queue_relayout (ClutterActor *self)
            */
           priv->parent->priv->needs_paint_volume_update = TRUE;
         }
-      else
+      else if (!defer_relayout)
         {
           _clutter_actor_queue_only_relayout (priv->parent);
         }
@@ -2956,8 +3260,6 @@ clutter_actor_apply_transform_to_point (ClutterActor             *self,
  * instead.
  *
  */
-/* XXX: We should consider caching the stage relative modelview along with
- * the actor itself */
 static void
 _clutter_actor_get_relative_transformation_matrix (ClutterActor *self,
                                                    ClutterActor *ancestor,
@@ -3157,6 +3459,38 @@ out:
   cogl_matrix_multiply (matrix, matrix, &priv->transform);
 }
 
+/* Ensures the cached transformation from the actor's coordinate space to
+ * the one of its top-level (usually the stage). The cache is invalidated
+ * through transform_changed(), which walks the affected subtree, and by
+ * hierarchy_changed() for the subtree of a reparented actor. */
+static void
+ensure_absolute_transform (ClutterActor *self)
+{
+  ClutterActorPrivate *priv = self->priv;
+
+  if (priv->absolute_transform_valid)
+    return;
+
+  if (priv->parent != NULL)
+    {
+      ClutterActorPrivate *parent_priv = priv->parent->priv;
+
+      ensure_absolute_transform (priv->parent);
+
+      priv->absolute_transform = parent_priv->absolute_transform;
+      priv->absolute_transform_root = parent_priv->absolute_transform_root;
+      _clutter_actor_apply_modelview_transform (self,
+                                                &priv->absolute_transform);
+    }
+  else
+    {
+      cogl_matrix_init_identity (&priv->absolute_transform);
+      priv->absolute_transform_root = self;
+    }
+
+  priv->absolute_transform_valid = TRUE;
+}
+
 /*
  * clutter_actor_apply_relative_transformation_matrix:
  * @self: The actor whose coordinate space you want to transform from.
@@ -3196,6 +3530,22 @@ _clutter_actor_apply_relative_transformation_matrix (ClutterActor *self,
   if (self == ancestor)
     return;
 
+  ensure_absolute_transform (self);
+
+  if (ancestor == NULL)
+    {
+      _clutter_actor_apply_modelview_transform (self->priv->absolute_transform_root,
+                                                matrix);
+      cogl_matrix_multiply (matrix, matrix, &self->priv->absolute_transform);
+      return;
+    }
+
+  if (ancestor == self->priv->absolute_transform_root)
+    {
+      cogl_matrix_multiply (matrix, matrix, &self->priv->absolute_transform);
+      return;
+    }
+
   if (self->priv->parent != NULL)
     _clutter_actor_apply_relative_transformation_matrix (self->priv->parent,
                                                          ancestor,
@@ -3515,10 +3865,17 @@ _clutter_actor_update_last_paint_volume (ClutterActor *self)
       return;
     }
 
-  _clutter_paint_volume_copy_static (pv, &priv->last_paint_volume);
+  if (!priv->absolute_paint_volume_valid)
+    {
+      _clutter_paint_volume_copy_static (pv, &priv->absolute_paint_volume);
+      _clutter_paint_volume_transform_relative (&priv->absolute_paint_volume,
+                                                NULL); /* eye coordinates */
+
+      priv->absolute_paint_volume_valid = TRUE;
+    }
 
-  _clutter_paint_volume_transform_relative (&priv->last_paint_volume,
-                                            NULL); /* eye coordinates */
+  _clutter_paint_volume_copy_static (&priv->absolute_paint_volume,
+                                     &priv->last_paint_volume);
 
   priv->last_paint_volume_valid = TRUE;
 }
@@ -3649,7 +4006,7 @@ clutter_actor_real_paint (ClutterActor        *actor,
     }
 }
 
-static gboolean
+static void
 clutter_actor_paint_node (ClutterActor        *actor,
                           ClutterPaintNode    *root,
                           ClutterPaintContext *paint_context)
@@ -3710,21 +4067,104 @@ clutter_actor_paint_node (ClutterActor        *actor,
 
   if (CLUTTER_ACTOR_GET_CLASS (actor)->paint_node != NULL)
     CLUTTER_ACTOR_GET_CLASS (actor)->paint_node (actor, root);
+}
+
+static gboolean
+can_retain_paint_nodes (ClutterActor *actor)
+{
+  ClutterActorPrivate *priv = actor->priv;
 
-  if (clutter_paint_node_get_n_children (root) == 0)
+  if (G_UNLIKELY (clutter_paint_debug_flags &
+                  CLUTTER_DEBUG_DISABLE_PAINT_NODE_CACHE))
     return FALSE;
 
-#ifdef CLUTTER_ENABLE_DEBUG
-  if (CLUTTER_HAS_DEBUG (PAINT))
+  /* The stage clear node depends on the framebuffer being painted */
+  if (CLUTTER_ACTOR_IS_TOPLEVEL (actor))
+    return FALSE;
+
+  if (priv->content != NULL &&
+      !_clutter_content_can_retain_paint_nodes (priv->content))
+    return FALSE;
+
+  return TRUE;
+}
+
+/* Root and layer nodes hold on to a framebuffer of their own, which must
+ * not be kept alive across frames */
+static gboolean
+paint_node_references_framebuffer (ClutterPaintNode *node)
+{
+  ClutterPaintNode *child;
+
+  if (CLUTTER_IS_ROOT_NODE (node) || CLUTTER_IS_LAYER_NODE (node))
+    return TRUE;
+
+  for (child = clutter_paint_node_get_first_child (node);
+       child != NULL;
+       child = clutter_paint_node_get_next_sibling (child))
     {
-      /* dump the tree only if we have one */
-      _clutter_paint_node_dump_tree (root);
+      if (paint_node_references_framebuffer (child))
+        return TRUE;
     }
-#endif /* CLUTTER_ENABLE_DEBUG */
 
-  clutter_paint_node_paint (root, paint_context);
+  return FALSE;
+}
 
-  return TRUE;
+static ClutterPaintNode *
+clutter_actor_get_paint_nodes (ClutterActor        *actor,
+                               ClutterPaintContext *paint_context)
+{
+  ClutterActorPrivate *priv = actor->priv;
+  CoglFramebuffer *framebuffer;
+  ClutterPaintNode *root;
+  float width, height;
+  guint8 opacity;
+
+  framebuffer = clutter_paint_context_get_base_framebuffer (paint_context);
+  width = clutter_actor_box_get_width (&priv->allocation);
+  height = clutter_actor_box_get_height (&priv->allocation);
+  opacity = clutter_actor_get_paint_opacity_internal (actor);
+
+  if (!can_retain_paint_nodes (actor))
+    {
+      g_clear_pointer (&priv->retained_paint_node, clutter_paint_node_unref);
+    }
+  else if (priv->retained_paint_node &&
+           !priv->needs_paint_node_update &&
+           priv->retained_paint_node_width == width &&
+           priv->retained_paint_node_height == height &&
+           priv->retained_paint_node_opacity == opacity)
+    {
+      /* The retained root node only points to the framebuffer while it
+       * is being painted */
+      _clutter_dummy_node_set_framebuffer (priv->retained_paint_node,
+                                           framebuffer);
+      return clutter_paint_node_ref (priv->retained_paint_node);
+    }
+
+  /* XXX - this will go away in 2.0, when we can get rid of this
+   * stuff and switch to a pure retained render tree of PaintNodes
+   * for the entire frame, starting from the Stage; the paint()
+   * virtual function can then be called directly.
+   */
+  root = _clutter_dummy_node_new (actor, framebuffer);
+  clutter_paint_node_set_static_name (root, "Root");
+
+  clutter_actor_paint_node (actor, root, paint_context);
+
+  g_clear_pointer (&priv->retained_paint_node, clutter_paint_node_unref);
+
+  if (can_retain_paint_nodes (actor) &&
+      !paint_node_references_framebuffer (root))
+    {
+      priv->retained_paint_node = clutter_paint_node_ref (root);
+      priv->retained_paint_node_width = width;
+      priv->retained_paint_node_height = height;
+      priv->retained_paint_node_opacity = opacity;
+      priv->needs_paint_node_update = FALSE;
+    }
+
+  return root;
 }
 
 /**
@@ -3973,23 +4413,26 @@ clutter_actor_continue_paint (ClutterActor        *self,
      actual actor */
   if (priv->next_effect_to_paint == NULL)
     {
-      CoglFramebuffer *framebuffer;
-      ClutterPaintNode *dummy;
+      ClutterPaintNode *root;
 
-      /* XXX - this will go away in 2.0, when we can get rid of this
-       * stuff and switch to a pure retained render tree of PaintNodes
-       * for the entire frame, starting from the Stage; the paint()
-       * virtual function can then be called directly.
-       */
-      framebuffer = clutter_paint_context_get_base_framebuffer (paint_context);
-      dummy = _clutter_dummy_node_new (self, framebuffer);
-      clutter_paint_node_set_static_name (dummy, "Root");
+      root = clutter_actor_get_paint_nodes (self, paint_context);
 
-      /* XXX - for 1.12, we use the return value of paint_node() to
-       * decide whether we should emit the ::paint signal.
-       */
-      clutter_actor_paint_node (self, dummy, paint_context);
-      clutter_paint_node_unref (dummy);
+      if (clutter_paint_node_get_n_children (root) > 0)
+        {
+#ifdef CLUTTER_ENABLE_DEBUG
+          if (CLUTTER_HAS_DEBUG (PAINT))
+            {
+              /* dump the tree only if we have one */
+              _clutter_paint_node_dump_tree (root);
+            }
+#endif /* CLUTTER_ENABLE_DEBUG */
+
+          clutter_paint_node_paint (root, paint_context);
+        }
+
+      if (root == priv->retained_paint_node)
+        _clutter_dummy_node_set_framebuffer (root, NULL);
+      clutter_paint_node_unref (root);
 
       /* XXX:2.0 - Call the paint() virtual directly */
       if (g_signal_has_handler_pending (self, actor_signals[PAINT],
@@ -4244,6 +4687,8 @@ remove_child (ClutterActor *self,
   child->priv->parent = NULL;
   child->priv->prev_sibling = NULL;
   child->priv->next_sibling = NULL;
+
+  hierarchy_changed (child);
 }
 
 typedef enum
@@ -5693,6 +6138,7 @@ clutter_actor_dispose (GObject *object)
     }
 
   g_clear_pointer (&priv->stage_views, g_list_free);
+  g_clear_pointer (&priv->retained_paint_node, clutter_paint_node_unref);
 
   G_OBJECT_CLASS (clutter_actor_parent_class)->dispose (object);
 }
@@ -8050,6 +8496,7 @@ clutter_actor_init (ClutterActor *self)
   priv->needs_allocation = TRUE;
   priv->needs_paint_volume_update = TRUE;
   priv->needs_update_stage_views = TRUE;
+  priv->needs_paint_node_update = TRUE;
 
   priv->cached_width_age = 1;
   priv->cached_height_age = 1;
@@ -8395,6 +8842,7 @@ _clutter_actor_queue_redraw_full (ClutterActor             *self,
     }
 
   priv->is_dirty = TRUE;
+  priv->needs_paint_node_update = TRUE;
 }
 
 /**
@@ -8864,11 +9312,13 @@ clutter_actor_adjust_height (ClutterActor *self,
 
 }
 
-/* looks for a cached size request for this for_size. If not
- * found, returns the oldest entry so it can be overwritten */
+/* looks for a cached size request for this for_size, and marks it as
+ * the most recently used one. If not found, returns the least recently
+ * used entry so it can be overwritten */
 static gboolean
 _clutter_actor_get_cached_size_request (gfloat         for_size,
                                         SizeRequest   *cached_size_requests,
+                                        guint         *cached_age,
                                         SizeRequest  **result)
 {
   guint i;
@@ -8885,6 +9335,7 @@ _clutter_actor_get_cached_size_request (gfloat         for_size,
           sr->for_size == for_size)
         {
           CLUTTER_NOTE (LAYOUT, "Size cache hit for size: %.2f", for_size);
+          sr->age = (*cached_age)++;
           *result = sr;
           return TRUE;
         }
@@ -8899,6 +9350,36 @@ _clutter_actor_get_cached_size_request (gfloat         for_size,
   return FALSE;
 }
 
+static inline void
+clutter_actor_count_size_request (gboolean found_in_cache)
+{
+#ifdef CLUTTER_ENABLE_DEBUG
+  if (found_in_cache)
+    n_size_request_hits++;
+  else
+    n_size_request_misses++;
+#endif
+}
+
+#ifdef CLUTTER_ENABLE_DEBUG
+/*
+ * clutter_actor_take_size_request_stats:
+ *
+ * Retrieves the number of size requests answered from, and missing in,
+ * the size request caches of all actors since the last call.
+ */
+void
+clutter_actor_take_size_request_stats (unsigned int *n_hits,
+                                       unsigned int *n_misses)
+{
+  *n_hits = n_size_request_hits;
+  *n_misses = n_size_request_misses;
+
+  n_size_request_hits = 0;
+  n_size_request_misses = 0;
+}
+#endif
+
 static void
 clutter_actor_update_preferred_size_for_constraints (ClutterActor *self,
                                                      ClutterOrientation direction,
@@ -8977,6 +9458,8 @@ clutter_actor_get_preferred_width (ClutterActor *self,
 
   priv = self->priv;
 
+  clutter_actor_ensure_deferred_relayouts (self);
+
   info = _clutter_actor_get_layout_info_or_defaults (self);
 
   /* we shortcircuit the case of a fixed size set using set_width() */
@@ -9025,6 +9508,7 @@ clutter_actor_get_preferred_width (ClutterActor *self,
       found_in_cache =
         _clutter_actor_get_cached_size_request (for_height,
                                                 priv->width_requests,
+                                                &priv->cached_width_age,
                                                 &cached_size_request);
     }
   else
@@ -9034,9 +9518,12 @@ clutter_actor_get_preferred_width (ClutterActor *self,
       cached_size_request = &priv->width_requests[0];
     }
 
+  clutter_actor_count_size_request (found_in_cache);
+
   if (!found_in_cache)
     {
       gfloat minimum_width, natural_width;
+      gfloat request_for_height = for_height;
       ClutterActorClass *klass;
 
       minimum_width = natural_width = 0;
@@ -9075,7 +9562,8 @@ clutter_actor_get_preferred_width (ClutterActor *self,
 
       cached_size_request->min_size = minimum_width;
       cached_size_request->natural_size = natural_width;
-      cached_size_request->for_size = for_height;
+      /* the cache is looked up with the size including the margin */
+      cached_size_request->for_size = request_for_height;
       cached_size_request->age = priv->cached_width_age;
 
       priv->cached_width_age += 1;
@@ -9142,6 +9630,8 @@ clutter_actor_get_preferred_height (ClutterActor *self,
 
   priv = self->priv;
 
+  clutter_actor_ensure_deferred_relayouts (self);
+
   info = _clutter_actor_get_layout_info_or_defaults (self);
 
   /* we shortcircuit the case of a fixed size set using set_height() */
@@ -9190,6 +9680,7 @@ clutter_actor_get_preferred_height (ClutterActor *self,
       found_in_cache =
         _clutter_actor_get_cached_size_request (for_width,
                                                 priv->height_requests,
+                                                &priv->cached_height_age,
                                                 &cached_size_request);
     }
   else
@@ -9198,9 +9689,12 @@ clutter_actor_get_preferred_height (ClutterActor *self,
       cached_size_request = &priv->height_requests[0];
     }
 
+  clutter_actor_count_size_request (found_in_cache);
+
   if (!found_in_cache)
     {
       gfloat minimum_height, natural_height;
+      gfloat request_for_width = for_width;
       ClutterActorClass *klass;
 
       minimum_height = natural_height = 0;
@@ -9239,7 +9733,8 @@ clutter_actor_get_preferred_height (ClutterActor *self,
 
       cached_size_request->min_size = minimum_height;
       cached_size_request->natural_size = natural_height;
-      cached_size_request->for_size = for_width;
+      /* the cache is looked up with the size including the margin */
+      cached_size_request->for_size = request_for_width;
       cached_size_request->age = priv->cached_height_age;
 
       priv->cached_height_age += 1;
@@ -9550,6 +10045,11 @@ clutter_actor_allocate (ClutterActor          *self,
                                 ? priv->parent->priv->absolute_origin_changed
                                 : FALSE;
 
+  /* remember how the parent allocated us, for reallocating in place */
+  priv->parent_allocation = *box;
+  priv->allocation_request_mode = priv->request_mode;
+  priv->allocation_was_fixed = clutter_actor_has_fixed_layout (self);
+
   if (!CLUTTER_ACTOR_IS_TOPLEVEL (self) &&
       !CLUTTER_ACTOR_IS_MAPPED (self) &&
       !clutter_actor_has_mapped_clones (self))
@@ -11996,6 +12496,8 @@ clutter_actor_add_child_internal (ClutterActor              *self,
 
   g_assert (child->priv->parent == self);
 
+  hierarchy_changed (child);
+
   self->priv->n_children += 1;
 
   self->priv->age += 1;
@@ -13678,6 +14180,167 @@ clutter_actor_set_final_state (ClutterAnimatable *animatable,
   g_free (p_name);
 }
 
+/*
+ * clutter_actor_get_typed_property:
+ * @self: a #ClutterActor
+ * @pspec: the #GParamSpec of an animatable property of @self
+ *
+ * Checks whether @pspec is one of the commonly animated properties of
+ * #ClutterActor which transitions can set directly, using
+ * clutter_actor_set_typed_property(), instead of going through
+ * #GValue and clutter_animatable_set_final_state().
+ *
+ * Return value: the typed property, or %CLUTTER_ACTOR_TYPED_PROPERTY_NONE
+ */
+ClutterActorTypedProperty
+clutter_actor_get_typed_property (ClutterActor *self,
+                                  GParamSpec   *pspec)
+{
+  ClutterAnimatableInterface *iface = CLUTTER_ANIMATABLE_GET_IFACE (self);
+
+  if (pspec->owner_type != CLUTTER_TYPE_ACTOR ||
+      (pspec->flags & CLUTTER_PARAM_ANIMATABLE) == 0)
+    return CLUTTER_ACTOR_TYPED_PROPERTY_NONE;
+
+  /* subclasses may override how properties are interpolated and set */
+  if (iface->set_final_state != clutter_actor_set_final_state ||
+      iface->interpolate_value != NULL)
+    return CLUTTER_ACTOR_TYPED_PROPERTY_NONE;
+
+  switch (pspec->param_id)
+    {
+    case PROP_X:
+      return CLUTTER_ACTOR_TYPED_PROPERTY_X;
+
+    case PROP_Y:
+      return CLUTTER_ACTOR_TYPED_PROPERTY_Y;
+
+    case PROP_Z_POSITION:
+      return CLUTTER_ACTOR_TYPED_PROPERTY_Z_POSITION;
+
+    case PROP_OPACITY:
+      return CLUTTER_ACTOR_TYPED_PROPERTY_OPACITY;
+
+    case PROP_TRANSLATION_X:
+      return CLUTTER_ACTOR_TYPED_PROPERTY_TRANSLATION_X;
+
+    case PROP_TRANSLATION_Y:
+      return CLUTTER_ACTOR_TYPED_PROPERTY_TRANSLATION_Y;
+
+    case PROP_TRANSLATION_Z:
+      return CLUTTER_ACTOR_TYPED_PROPERTY_TRANSLATION_Z;
+
+    case PROP_SCALE_X:
+      return CLUTTER_ACTOR_TYPED_PROPERTY_SCALE_X;
+
+    case PROP_SCALE_Y:
+      return CLUTTER_ACTOR_TYPED_PROPERTY_SCALE_Y;
+
+    case PROP_SCALE_Z:
+      return CLUTTER_ACTOR_TYPED_PROPERTY_SCALE_Z;
+
+    case PROP_ROTATION_ANGLE_X:
+      return CLUTTER_ACTOR_TYPED_PROPERTY_ROTATION_ANGLE_X;
+
+    case PROP_ROTATION_ANGLE_Y:
+      return CLUTTER_ACTOR_TYPED_PROPERTY_ROTATION_ANGLE_Y;
+
+    case PROP_ROTATION_ANGLE_Z:
+      return CLUTTER_ACTOR_TYPED_PROPERTY_ROTATION_ANGLE_Z;
+
+    default:
+      return CLUTTER_ACTOR_TYPED_PROPERTY_NONE;
+    }
+}
+
+/*
+ * clutter_actor_set_typed_property:
+ * @self: a #ClutterActor
+ * @property: a property returned by clutter_actor_get_typed_property()
+ * @value: the new value
+ *
+ * Sets an animatable property like clutter_actor_set_animatable_property(),
+ * without boxing the value in a #GValue.
+ */
+void
+clutter_actor_set_typed_property (ClutterActor              *self,
+                                  ClutterActorTypedProperty  property,
+                                  double                     value)
+{
+  GObject *obj = G_OBJECT (self);
+
+  switch (property)
+    {
+    case CLUTTER_ACTOR_TYPED_PROPERTY_X:
+      g_object_freeze_notify (obj);
+      clutter_actor_set_x_internal (self, value);
+      g_object_thaw_notify (obj);
+      break;
+
+    case CLUTTER_ACTOR_TYPED_PROPERTY_Y:
+      g_object_freeze_notify (obj);
+      clutter_actor_set_y_internal (self, value);
+      g_object_thaw_notify (obj);
+      break;
+
+    case CLUTTER_ACTOR_TYPED_PROPERTY_Z_POSITION:
+      clutter_actor_set_z_position_internal (self, value);
+      break;
+
+    case CLUTTER_ACTOR_TYPED_PROPERTY_OPACITY:
+      clutter_actor_set_opacity_internal (self, (guint) value);
+      break;
+
+    case CLUTTER_ACTOR_TYPED_PROPERTY_TRANSLATION_X:
+      clutter_actor_set_translation_internal (self, value,
+                                              obj_props[PROP_TRANSLATION_X]);
+      break;
+
+    case CLUTTER_ACTOR_TYPED_PROPERTY_TRANSLATION_Y:
+      clutter_actor_set_translation_internal (self, value,
+                                              obj_props[PROP_TRANSLATION_Y]);
+      break;
+
+    case CLUTTER_ACTOR_TYPED_PROPERTY_TRANSLATION_Z:
+      clutter_actor_set_translation_internal (self, value,
+                                              obj_props[PROP_TRANSLATION_Z]);
+      break;
+
+    case CLUTTER_ACTOR_TYPED_PROPERTY_SCALE_X:
+      clutter_actor_set_scale_factor_internal (self, value,
+                                               obj_props[PROP_SCALE_X]);
+      break;
+
+    case CLUTTER_ACTOR_TYPED_PROPERTY_SCALE_Y:
+      clutter_actor_set_scale_factor_internal (self, value,
+                                               obj_props[PROP_SCALE_Y]);
+      break;
+
+    case CLUTTER_ACTOR_TYPED_PROPERTY_SCALE_Z:
+      clutter_actor_set_scale_factor_internal (self, value,
+                                               obj_props[PROP_SCALE_Z]);
+      break;
+
+    case CLUTTER_ACTOR_TYPED_PROPERTY_ROTATION_ANGLE_X:
+      clutter_actor_set_rotation_angle_internal (self, value,
+                                                 obj_props[PROP_ROTATION_ANGLE_X]);
+      break;
+
+    case CLUTTER_ACTOR_TYPED_PROPERTY_ROTATION_ANGLE_Y:
+      clutter_actor_set_rotation_angle_internal (self, value,
+                                                 obj_props[PROP_ROTATION_ANGLE_Y]);
+      break;
+
+    case CLUTTER_ACTOR_TYPED_PROPERTY_ROTATION_ANGLE_Z:
+      clutter_actor_set_rotation_angle_internal (self, value,
+                                                 obj_props[PROP_ROTATION_ANGLE_Z]);
+      break;
+
+    case CLUTTER_ACTOR_TYPED_PROPERTY_NONE:
+      g_assert_not_reached ();
+    }
+}
+
 static ClutterActor *
 clutter_actor_get_actor (ClutterAnimatable *animatable)
 {
@@ -15922,6 +16585,7 @@ _clutter_actor_get_paint_volume_mutable (ClutterActor *self)
     }
 
   priv->had_effects_on_last_paint_volume_update = has_paint_volume_override_effects;
+  priv->absolute_paint_volume_valid = FALSE;
 
   if (_clutter_actor_get_paint_volume_real (self, &priv->paint_volume))
     {
@@ -39,9 +39,11 @@
 #include "clutter-build-config.h"
 
 #include "clutter-actor-private.h"
+#include "clutter-canvas.h"
 #include "clutter-content-private.h"
 
 #include "clutter-debug.h"
+#include "clutter-image.h"
 #include "clutter-marshal.h"
 #include "clutter-private.h"
 
@@ -319,6 +321,28 @@ _clutter_content_paint_content (ClutterContent      *content,
                                                       paint_context);
 }
 
+/*< private >
+ * _clutter_content_can_retain_paint_nodes:
+ * @content: a #ClutterContent
+ *
+ * Checks whether the paint nodes created by @content only change when
+ * the content is invalidated, so that they can be kept around and reused
+ * by the actor across frames.
+ *
+ * This is only known to be true for the content types implemented by
+ * Clutter itself; other implementations may depend on per-frame state,
+ * such as the paint context or a clip region.
+ *
+ * Return value: %TRUE if the paint nodes can be retained
+ */
+gboolean
+_clutter_content_can_retain_paint_nodes (ClutterContent *content)
+{
+  GType type = G_OBJECT_TYPE (content);
+
+  return type == CLUTTER_TYPE_IMAGE || type == CLUTTER_TYPE_CANVAS;
+}
+
 /**
  * clutter_content_get_preferred_size:
  * @content: a #ClutterContent
@@ -111,6 +111,7 @@ static const GDebugKey clutter_debug_keys[] = {
   { "layout", CLUTTER_DEBUG_LAYOUT },
   { "clipping", CLUTTER_DEBUG_CLIPPING },
   { "oob-transforms", CLUTTER_DEBUG_OOB_TRANSFORMS },
+  { "size-requests", CLUTTER_DEBUG_SIZE_REQUESTS },
 };
 #endif /* CLUTTER_ENABLE_DEBUG */
 
@@ -128,6 +129,8 @@ static const GDebugKey clutter_paint_debug_keys[] = {
   { "continuous-redraw", CLUTTER_DEBUG_CONTINUOUS_REDRAW },
   { "paint-deform-tiles", CLUTTER_DEBUG_PAINT_DEFORM_TILES },
   { "damage-region", CLUTTER_DEBUG_PAINT_DAMAGE_REGION },
+  { "disable-paint-node-cache", CLUTTER_DEBUG_DISABLE_PAINT_NODE_CACHE },
+  { "disable-deferred-relayout", CLUTTER_DEBUG_DISABLE_DEFERRED_RELAYOUT },
 };
 
 #define ENVIRONMENT_GROUP       "Environment"
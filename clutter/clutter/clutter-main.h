@@ -53,6 +53,7 @@ typedef enum
   CLUTTER_DEBUG_EVENTLOOP           = 1 << 14,
   CLUTTER_DEBUG_CLIPPING            = 1 << 15,
   CLUTTER_DEBUG_OOB_TRANSFORMS      = 1 << 16,
+  CLUTTER_DEBUG_SIZE_REQUESTS       = 1 << 17,
 } ClutterDebugFlag;
 
 typedef enum
@@ -71,6 +72,8 @@ typedef enum
   CLUTTER_DEBUG_CONTINUOUS_REDRAW          = 1 << 6,
   CLUTTER_DEBUG_PAINT_DEFORM_TILES         = 1 << 7,
   CLUTTER_DEBUG_PAINT_DAMAGE_REGION        = 1 << 8,
+  CLUTTER_DEBUG_DISABLE_PAINT_NODE_CACHE   = 1 << 9,
+  CLUTTER_DEBUG_DISABLE_DEFERRED_RELAYOUT  = 1 << 10,
 } ClutterDrawDebugFlag;
 
 /**
@@ -36,6 +36,21 @@
 #include "cogl/clutter-stage-cogl.h"
 #include "clutter/x11/clutter-backend-x11.h"
 
+/* All durations are in microseconds */
+typedef struct _ClutterFrameStats
+{
+  int64_t frame_counter;
+  int64_t dispatch_time_us;
+
+  int64_t before_paint_us;
+  int64_t layout_us;
+  int64_t paint_us;
+  int64_t pick_us;
+  int64_t flush_us;
+  int64_t swap_us;
+  int64_t presentation_latency_us;
+} ClutterFrameStats;
+
 CLUTTER_EXPORT
 GList * clutter_stage_peek_stage_views (ClutterStage *stage);
 
@@ -62,6 +77,11 @@ CLUTTER_EXPORT
 void clutter_stage_view_assign_next_scanout (ClutterStageView *stage_view,
                                              CoglScanout      *scanout);
 
+CLUTTER_EXPORT
+int clutter_stage_view_get_frame_stats (ClutterStageView  *stage_view,
+                                        ClutterFrameStats *stats,
+                                        int                max_stats);
+
 CLUTTER_EXPORT
 gboolean clutter_actor_has_damage (ClutterActor *actor);
 
@@ -114,6 +114,8 @@ gpointer                _clutter_paint_node_create                      (GType g
 ClutterPaintNode *      _clutter_transform_node_new                     (const CoglMatrix            *matrix);
 ClutterPaintNode *      _clutter_dummy_node_new                         (ClutterActor                *actor,
                                                                          CoglFramebuffer             *framebuffer);
+void                    _clutter_dummy_node_set_framebuffer             (ClutterPaintNode            *node,
+                                                                         CoglFramebuffer             *framebuffer);
 
 void                    _clutter_paint_node_dump_tree                   (ClutterPaintNode            *root);
 
@@ -363,6 +363,27 @@ _clutter_dummy_node_new (ClutterActor    *actor,
   return res;
 }
 
+/*
+ * _clutter_dummy_node_set_framebuffer:
+ * @node: a dummy node
+ * @framebuffer: (nullable): the framebuffer to draw into
+ *
+ * Changes the framebuffer the children of @node draw into. Root nodes that
+ * are kept across frames unset it after painting, so that they don't keep
+ * the framebuffer alive.
+ */
+void
+_clutter_dummy_node_set_framebuffer (ClutterPaintNode *node,
+                                     CoglFramebuffer  *framebuffer)
+{
+  ClutterDummyNode *dnode = (ClutterDummyNode *) node;
+
+  if (framebuffer)
+    cogl_object_ref (framebuffer);
+  cogl_clear_object (&dnode->framebuffer);
+  dnode->framebuffer = framebuffer;
+}
+
 /*
  * Pipeline node
  */
@@ -284,6 +284,9 @@ PangoDirection _clutter_pango_unichar_direction (gunichar ch);
 PangoDirection _clutter_pango_find_base_dir     (const gchar *text,
                                                  gint         length);
 
+CLUTTER_EXPORT
+guint _clutter_text_get_n_shared_layout_hits    (void);
+
 typedef struct _ClutterPlane
 {
   graphene_vec3_t v0;
@@ -34,6 +34,7 @@
 
 #include "clutter-property-transition.h"
 
+#include "clutter-actor-private.h"
 #include "clutter-animatable.h"
 #include "clutter-debug.h"
 #include "clutter-interval.h"
@@ -45,6 +46,9 @@ struct _ClutterPropertyTransitionPrivate
   char *property_name;
 
   GParamSpec *pspec;
+
+  /* set if the property can be set without going through GValue */
+  ClutterActorTypedProperty typed_property;
 };
 
 enum
@@ -109,6 +113,12 @@ clutter_property_transition_attached (ClutterTransition *transition,
   if (priv->pspec == NULL)
     return;
 
+  priv->typed_property = CLUTTER_ACTOR_TYPED_PROPERTY_NONE;
+  if (CLUTTER_IS_ACTOR (animatable))
+    priv->typed_property =
+      clutter_actor_get_typed_property (CLUTTER_ACTOR (animatable),
+                                        priv->pspec);
+
   interval = clutter_transition_get_interval (transition);
   if (interval == NULL)
     return;
@@ -123,7 +133,78 @@ clutter_property_transition_detached (ClutterTransition *transition,
   ClutterPropertyTransition *self = CLUTTER_PROPERTY_TRANSITION (transition);
   ClutterPropertyTransitionPrivate *priv = self->priv;
 
-  priv->pspec = NULL; 
+  priv->pspec = NULL;
+  priv->typed_property = CLUTTER_ACTOR_TYPED_PROPERTY_NONE;
+}
+
+/*
+ * Interpolates the common numeric properties of actors like
+ * clutter_interval_compute_value() does, but sets the result directly
+ * instead of boxing it in a GValue, which matters with hundreds of
+ * concurrent transitions.
+ */
+static gboolean
+clutter_property_transition_compute_typed_value (ClutterPropertyTransition *self,
+                                                 ClutterAnimatable         *animatable,
+                                                 ClutterInterval           *interval,
+                                                 gdouble                    progress)
+{
+  ClutterPropertyTransitionPrivate *priv = self->priv;
+  GValue *initial, *final;
+  GType value_type;
+  gdouble value;
+
+  /* subclasses of ClutterInterval and progress functions may
+   * interpolate differently */
+  if (G_OBJECT_TYPE (interval) != CLUTTER_TYPE_INTERVAL)
+    return FALSE;
+
+  value_type = clutter_interval_get_value_type (interval);
+  if (value_type != G_PARAM_SPEC_VALUE_TYPE (priv->pspec) ||
+      _clutter_has_progress_function (value_type))
+    return FALSE;
+
+  initial = clutter_interval_peek_initial_value (interval);
+  final = clutter_interval_peek_final_value (interval);
+
+  switch (value_type)
+    {
+    case G_TYPE_FLOAT:
+      {
+        gdouble ia = g_value_get_float (initial);
+        gdouble ib = g_value_get_float (final);
+
+        value = (progress * (ib - ia)) + ia;
+      }
+      break;
+
+    case G_TYPE_DOUBLE:
+      {
+        gdouble ia = g_value_get_double (initial);
+        gdouble ib = g_value_get_double (final);
+
+        value = (progress * (ib - ia)) + ia;
+      }
+      break;
+
+    case G_TYPE_UINT:
+      {
+        guint ia = g_value_get_uint (initial);
+        guint ib = g_value_get_uint (final);
+
+        value = (guint) ((progress * (ib - (gdouble) ia)) + ia);
+      }
+      break;
+
+    default:
+      return FALSE;
+    }
+
+  clutter_actor_set_typed_property (CLUTTER_ACTOR (animatable),
+                                    priv->typed_property,
+                                    value);
+
+  return TRUE;
 }
 
 static void
@@ -144,6 +225,13 @@ clutter_property_transition_compute_value (ClutterTransition *transition,
 
   clutter_property_transition_ensure_interval (self, animatable, interval);
 
+  if (priv->typed_property != CLUTTER_ACTOR_TYPED_PROPERTY_NONE &&
+      clutter_property_transition_compute_typed_value (self,
+                                                       animatable,
+                                                       interval,
+                                                       progress))
+    return;
+
   p_type = G_PARAM_SPEC_VALUE_TYPE (priv->pspec);
   i_type = clutter_interval_get_value_type (interval);
 
@@ -343,6 +431,7 @@ clutter_property_transition_set_property_name (ClutterPropertyTransition *transi
   g_free (priv->property_name);
   priv->property_name = g_strdup (property_name);
   priv->pspec = NULL;
+  priv->typed_property = CLUTTER_ACTOR_TYPED_PROPERTY_NONE;
 
   animatable =
     clutter_transition_get_animatable (CLUTTER_TRANSITION (transition));
@@ -350,6 +439,11 @@ clutter_property_transition_set_property_name (ClutterPropertyTransition *transi
     {
       priv->pspec = clutter_animatable_find_property (animatable,
                                                       priv->property_name);
+
+      if (priv->pspec != NULL && CLUTTER_IS_ACTOR (animatable))
+        priv->typed_property =
+          clutter_actor_get_typed_property (CLUTTER_ACTOR (animatable),
+                                            priv->pspec);
     }
 
   g_object_notify_by_pspec (G_OBJECT (transition),
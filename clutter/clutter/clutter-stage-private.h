@@ -144,6 +144,11 @@ void            clutter_stage_queue_actor_relayout      (ClutterStage *stage,
 void clutter_stage_dequeue_actor_relayout (ClutterStage *stage,
                                            ClutterActor *actor);
 
+void clutter_stage_defer_actor_relayout (ClutterStage *stage,
+                                         ClutterActor *actor);
+
+void clutter_stage_resolve_deferred_relayouts (ClutterStage *stage);
+
 GList * clutter_stage_get_views_for_rect (ClutterStage          *stage,
                                           const graphene_rect_t *rect);
 
@@ -68,4 +68,11 @@ void clutter_stage_view_schedule_update (ClutterStageView *view);
 void clutter_stage_view_notify_presented (ClutterStageView *view,
                                           ClutterFrameInfo *frame_info);
 
+void clutter_stage_view_record_swap_timings (ClutterStageView *view,
+                                             int64_t           flush_us,
+                                             int64_t           swap_us);
+
+void clutter_stage_view_add_pick_time (ClutterStageView *view,
+                                       int64_t           pick_us);
+
 #endif /* __CLUTTER_STAGE_VIEW_PRIVATE_H__ */
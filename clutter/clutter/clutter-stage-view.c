@@ -48,6 +48,8 @@ enum
 
 static GParamSpec *obj_props[PROP_LAST];
 
+#define N_FRAME_STATS 128
+
 typedef struct _ClutterStageViewPrivate
 {
   char *name;
@@ -80,6 +82,17 @@ typedef struct _ClutterStageViewPrivate
   float refresh_rate;
   ClutterFrameClock *frame_clock;
 
+  struct {
+    ClutterFrameStats frames[N_FRAME_STATS];
+    int next_idx;
+    int n_frames;
+
+    /* Statistics of the frame currently being dispatched, and the ring
+     * index of the last painted frame still waiting for presentation. */
+    ClutterFrameStats current;
+    int pending_presentation_idx;
+  } frame_stats;
+
   guint dirty_viewport   : 1;
   guint dirty_projection : 1;
 } ClutterStageViewPrivate;
@@ -1067,6 +1080,22 @@ handle_frame_clock_before_frame (ClutterFrameClock *frame_clock,
   _clutter_stage_process_queued_events (priv->stage);
 }
 
+static void
+clutter_stage_view_commit_frame_stats (ClutterStageView *view)
+{
+  ClutterStageViewPrivate *priv =
+    clutter_stage_view_get_instance_private (view);
+  int idx = priv->frame_stats.next_idx;
+
+  priv->frame_stats.frames[idx] = priv->frame_stats.current;
+  priv->frame_stats.next_idx = (idx + 1) % N_FRAME_STATS;
+  priv->frame_stats.n_frames = MIN (priv->frame_stats.n_frames + 1,
+                                    N_FRAME_STATS);
+  priv->frame_stats.pending_presentation_idx = idx;
+
+  priv->frame_stats.current.pick_us = 0;
+}
+
 static ClutterFrameResult
 handle_frame_clock_frame (ClutterFrameClock *frame_clock,
                           int64_t            frame_count,
@@ -1077,8 +1106,10 @@ handle_frame_clock_frame (ClutterFrameClock *frame_clock,
   ClutterStageViewPrivate *priv =
     clutter_stage_view_get_instance_private (view);
   ClutterStage *stage = priv->stage;
+  ClutterFrameStats *stats = &priv->frame_stats.current;
   g_autoptr (GSList) devices = NULL;
   ClutterFrameResult result;
+  int64_t layout_start_us;
 
   if (CLUTTER_ACTOR_IN_DESTRUCTION (stage))
     return CLUTTER_FRAME_RESULT_IDLE;
@@ -1089,28 +1120,52 @@ handle_frame_clock_frame (ClutterFrameClock *frame_clock,
   if (!clutter_actor_is_mapped (CLUTTER_ACTOR (stage)))
     return CLUTTER_FRAME_RESULT_IDLE;
 
+  /* Picking happens between frames, so it is accounted to the next one */
+  *stats = (ClutterFrameStats) {
+    .frame_counter = frame_count,
+    .dispatch_time_us = g_get_monotonic_time (),
+    .pick_us = stats->pick_us,
+  };
+
   _clutter_run_repaint_functions (CLUTTER_REPAINT_FLAGS_PRE_PAINT);
   clutter_stage_emit_before_update (stage, view);
 
+  layout_start_us = g_get_monotonic_time ();
+  stats->before_paint_us = layout_start_us - stats->dispatch_time_us;
+
   clutter_stage_maybe_relayout (CLUTTER_ACTOR (stage));
   clutter_stage_update_actor_stage_views (stage);
   clutter_stage_maybe_finish_queue_redraws (stage);
 
+  stats->layout_us = g_get_monotonic_time () - layout_start_us;
+
   devices = clutter_stage_find_updated_devices (stage);
 
   if (clutter_stage_view_has_redraw_clip (view))
     {
       ClutterStageWindow *stage_window;
+      int64_t before_paint_start_us;
+      int64_t paint_start_us;
 
+      before_paint_start_us = g_get_monotonic_time ();
       clutter_stage_emit_before_paint (stage, view);
+      paint_start_us = g_get_monotonic_time ();
+      stats->before_paint_us += paint_start_us - before_paint_start_us;
 
       stage_window = _clutter_stage_get_window (stage);
       _clutter_stage_window_redraw_view (stage_window, view);
 
+      /* The journal flush and swap are recorded by the stage window while
+       * redrawing; whatever remains is the time spent painting. */
+      stats->paint_us = (g_get_monotonic_time () - paint_start_us -
+                         stats->flush_us - stats->swap_us);
+
       clutter_stage_emit_after_paint (stage, view);
 
       _clutter_stage_window_finish_frame (stage_window);
 
+      clutter_stage_view_commit_frame_stats (view);
+
       result = CLUTTER_FRAME_RESULT_PENDING_PRESENTED;
     }
   else
@@ -1137,11 +1192,77 @@ clutter_stage_view_notify_presented (ClutterStageView *view,
 {
   ClutterStageViewPrivate *priv =
     clutter_stage_view_get_instance_private (view);
+  int idx = priv->frame_stats.pending_presentation_idx;
+
+  if (idx != -1 && frame_info->presentation_time != 0)
+    {
+      ClutterFrameStats *stats = &priv->frame_stats.frames[idx];
+
+      stats->presentation_latency_us =
+        frame_info->presentation_time - stats->dispatch_time_us;
+    }
+  priv->frame_stats.pending_presentation_idx = -1;
 
   clutter_stage_presented (priv->stage, view, frame_info);
   clutter_frame_clock_notify_presented (priv->frame_clock, frame_info);
 }
 
+void
+clutter_stage_view_record_swap_timings (ClutterStageView *view,
+                                        int64_t           flush_us,
+                                        int64_t           swap_us)
+{
+  ClutterStageViewPrivate *priv =
+    clutter_stage_view_get_instance_private (view);
+
+  priv->frame_stats.current.flush_us = flush_us;
+  priv->frame_stats.current.swap_us = swap_us;
+}
+
+void
+clutter_stage_view_add_pick_time (ClutterStageView *view,
+                                  int64_t           pick_us)
+{
+  ClutterStageViewPrivate *priv =
+    clutter_stage_view_get_instance_private (view);
+
+  priv->frame_stats.current.pick_us += pick_us;
+}
+
+/**
+ * clutter_stage_view_get_frame_stats: (skip)
+ * @view: a #ClutterStageView
+ * @stats: (out caller-allocates) (array length=max_stats): return location
+ *   for the frame statistics
+ * @max_stats: the number of elements in @stats
+ *
+ * Copies the statistics of the most recently painted frames of @view,
+ * oldest first. A presentation latency of 0 means the frame has not been
+ * presented yet, or the presentation time was not known.
+ *
+ * Returns: the number of frames copied into @stats
+ */
+int
+clutter_stage_view_get_frame_stats (ClutterStageView  *view,
+                                    ClutterFrameStats *stats,
+                                    int                max_stats)
+{
+  ClutterStageViewPrivate *priv =
+    clutter_stage_view_get_instance_private (view);
+  int n_stats;
+  int first_idx;
+  int i;
+
+  n_stats = MIN (priv->frame_stats.n_frames, max_stats);
+  first_idx = (priv->frame_stats.next_idx - n_stats + N_FRAME_STATS) %
+              N_FRAME_STATS;
+
+  for (i = 0; i < n_stats; i++)
+    stats[i] = priv->frame_stats.frames[(first_idx + i) % N_FRAME_STATS];
+
+  return n_stats;
+}
+
 static void
 sanity_check_framebuffer (ClutterStageView *view)
 {
@@ -1323,6 +1444,7 @@ clutter_stage_view_init (ClutterStageView *view)
   priv->dirty_projection = TRUE;
   priv->scale = 1.0;
   priv->refresh_rate = 60.0;
+  priv->frame_stats.pending_presentation_idx = -1;
 }
 
 static void
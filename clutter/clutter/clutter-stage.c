@@ -120,6 +120,11 @@ struct _ClutterStagePrivate
   GSList *pending_relayouts;
   GList *pending_queue_redraws;
 
+  /* Actors which deferred relaying out their parent, and those which
+   * turned out to only need to be allocated in place */
+  GSList *deferred_relayouts;
+  GSList *pending_reallocations;
+
   gint sync_delay;
 
   GTimer *fps_timer;
@@ -147,6 +152,7 @@ struct _ClutterStagePrivate
   guint min_size_changed       : 1;
   guint motion_events_enabled  : 1;
   guint actor_needs_immediate_relayout : 1;
+  guint resolving_deferred_relayouts : 1;
 };
 
 enum
@@ -1208,6 +1214,70 @@ clutter_stage_dequeue_actor_relayout (ClutterStage *stage,
     }
 }
 
+void
+clutter_stage_defer_actor_relayout (ClutterStage *stage,
+                                    ClutterActor *actor)
+{
+  ClutterStagePrivate *priv = stage->priv;
+
+  if (priv->deferred_relayouts == NULL && priv->pending_relayouts == NULL)
+    clutter_stage_schedule_update (stage);
+
+  priv->deferred_relayouts = g_slist_prepend (priv->deferred_relayouts,
+                                              g_object_ref (actor));
+}
+
+/*
+ * Resolves the relayouts deferred by actors, by checking whether their
+ * size requests changed. If they did, their parents are queued for
+ * relayout, which may in turn be deferred and resolved in the next
+ * iteration; otherwise the actors are only allocated again, leaving
+ * their parents and siblings untouched.
+ */
+void
+clutter_stage_resolve_deferred_relayouts (ClutterStage *stage)
+{
+  ClutterStagePrivate *priv = stage->priv;
+  g_autoptr (GSList) resolved_list = NULL;
+  GSList *l;
+
+  if (priv->deferred_relayouts == NULL ||
+      priv->resolving_deferred_relayouts)
+    return;
+
+  priv->resolving_deferred_relayouts = TRUE;
+
+  while (priv->deferred_relayouts != NULL)
+    {
+      g_autoptr (GSList) stolen_list = NULL;
+
+      stolen_list = g_steal_pointer (&priv->deferred_relayouts);
+      for (l = stolen_list; l; l = l->next)
+        {
+          ClutterActor *deferred_actor = l->data;
+
+          if (_clutter_actor_get_stage_internal (deferred_actor) ==
+              CLUTTER_ACTOR (stage) &&
+              clutter_actor_resolve_deferred_relayout (deferred_actor))
+            {
+              priv->pending_reallocations =
+                g_slist_prepend (priv->pending_reallocations,
+                                 g_object_ref (deferred_actor));
+            }
+
+          resolved_list = g_slist_prepend (resolved_list, deferred_actor);
+        }
+    }
+
+  for (l = resolved_list; l; l = l->next)
+    {
+      clutter_actor_finish_deferred_relayout (l->data);
+      g_object_unref (l->data);
+    }
+
+  priv->resolving_deferred_relayouts = FALSE;
+}
+
 void
 clutter_stage_maybe_relayout (ClutterActor *actor)
 {
@@ -1218,13 +1288,17 @@ clutter_stage_maybe_relayout (ClutterActor *actor)
   int count = 0;
 
   /* No work to do? Avoid the extraneous debug log messages too. */
-  if (priv->pending_relayouts == NULL)
+  if (priv->pending_relayouts == NULL &&
+      priv->deferred_relayouts == NULL &&
+      priv->pending_reallocations == NULL)
     return;
 
   COGL_TRACE_BEGIN_SCOPED (ClutterStageRelayout, "Layout");
 
   CLUTTER_NOTE (ACTOR, ">>> Recomputing layout");
 
+  clutter_stage_resolve_deferred_relayouts (stage);
+
   stolen_list = g_steal_pointer (&priv->pending_relayouts);
   for (l = stolen_list; l; l = l->next)
     {
@@ -1252,8 +1326,44 @@ clutter_stage_maybe_relayout (ClutterActor *actor)
       count++;
     }
 
+  /* Done after the full relayouts, which may already have allocated
+   * some of these actors again */
+  g_clear_pointer (&stolen_list, g_slist_free);
+  stolen_list = g_steal_pointer (&priv->pending_reallocations);
+  for (l = stolen_list; l; l = l->next)
+    {
+      g_autoptr (ClutterActor) queued_actor = l->data;
+
+      if (CLUTTER_ACTOR_IN_RELAYOUT (queued_actor))  /* avoid reentrancy */
+        continue;
+
+      CLUTTER_NOTE (ACTOR, "    Reallocation of actor %s",
+                    _clutter_actor_get_debug_name (queued_actor));
+
+      CLUTTER_SET_PRIVATE_FLAGS (queued_actor, CLUTTER_IN_RELAYOUT);
+      clutter_actor_reallocate (queued_actor);
+      CLUTTER_UNSET_PRIVATE_FLAGS (queued_actor, CLUTTER_IN_RELAYOUT);
+
+      count++;
+    }
+
   CLUTTER_NOTE (ACTOR, "<<< Completed recomputing layout of %d subtrees", count);
 
+#ifdef CLUTTER_ENABLE_DEBUG
+  if (CLUTTER_HAS_DEBUG (SIZE_REQUESTS))
+    {
+      unsigned int n_hits, n_misses;
+
+      clutter_actor_take_size_request_stats (&n_hits, &n_misses);
+      CLUTTER_NOTE (SIZE_REQUESTS,
+                    "Size request cache: %u hits, %u misses (%.1f%% hits)",
+                    n_hits, n_misses,
+                    n_hits + n_misses > 0
+                      ? 100.0 * n_hits / (n_hits + n_misses)
+                      : 0.0);
+    }
+#endif
+
   if (count)
     priv->needs_update_devices = TRUE;
 }
@@ -1483,6 +1593,7 @@ _clutter_stage_do_pick_on_view (ClutterStage     *stage,
   if (mode != priv->cached_pick_mode)
     {
       ClutterPickContext *pick_context;
+      int64_t pick_start_us = g_get_monotonic_time ();
 
       _clutter_stage_clear_pick_stack (stage);
 
@@ -1497,6 +1608,10 @@ _clutter_stage_do_pick_on_view (ClutterStage     *stage,
       clutter_pick_context_destroy (pick_context);
 
       add_pick_stack_weak_refs (stage);
+
+      clutter_stage_view_add_pick_time (view,
+                                        g_get_monotonic_time () -
+                                        pick_start_us);
     }
 
   /* Search all "painted" pickable actors from front to back. A linear search
@@ -1703,6 +1818,14 @@ clutter_stage_dispose (GObject *object)
                      (GDestroyNotify) g_object_unref);
   priv->pending_relayouts = NULL;
 
+  g_slist_free_full (priv->deferred_relayouts,
+                     (GDestroyNotify) g_object_unref);
+  priv->deferred_relayouts = NULL;
+
+  g_slist_free_full (priv->pending_reallocations,
+                     (GDestroyNotify) g_object_unref);
+  priv->pending_reallocations = NULL;
+
   /* this will release the reference on the stage */
   stage_manager = clutter_stage_manager_get_default ();
   _clutter_stage_manager_remove_stage (stage_manager, stage);
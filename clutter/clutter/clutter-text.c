@@ -77,9 +77,16 @@
  * actual allocated width
  *
  * since we might get multiple queries from layout managers doing a
- * double-pass allocations, like tabular ones, we should use 6 slots
+ * double-pass allocations, like tabular ones, and animations which ask
+ * for the preferred size at many widths, we should use 8 slots
  */
-#define N_CACHED_LAYOUTS        6
+#define N_CACHED_LAYOUTS        8
+
+/* Number of layouts kept in the cache shared between all text actors */
+#define N_SHARED_LAYOUTS        64
+
+/* Number of contexts used to create the shared layouts */
+#define N_SHARED_CONTEXTS       4
 
 typedef struct _LayoutCache     LayoutCache;
 
@@ -91,12 +98,83 @@ struct _LayoutCache
    */
   PangoLayout *layout;
 
-  /* A number representing the age of this cache (so that when a
-   * new layout is needed the last used cache is replaced)
+  /* The parameters the layout was created with */
+  gint width;
+  gint height;
+  PangoEllipsizeMode ellipsize;
+
+  /* Whether the layout comes from the cache shared between actors */
+  gboolean shared;
+
+  /* A number representing the last time this cache was used (so that
+   * when a new layout is needed the least recently used cache is
+   * replaced)
    */
   guint age;
 };
 
+/* Layouts of non-editable text are shared between actors with the same
+ * contents, attributes, font and layout parameters, so that the text only
+ * needs to be shaped, and its glyphs cached, once. The layouts are created
+ * using private PangoContexts, since the context of each actor is updated
+ * whenever it is retrieved.
+ */
+typedef struct _SharedLayout
+{
+  guint hash;
+  PangoLayout *layout;
+} SharedLayout;
+
+static GQueue shared_layouts = G_QUEUE_INIT;
+static GQueue shared_contexts = G_QUEUE_INIT;
+static guint n_shared_layout_hits = 0;
+
+/* Number of worker threads shaping text for actors using
+ * ClutterText:async-layout */
+#define N_ASYNC_LAYOUT_THREADS  2
+
+/* Pango font maps may only be used from one thread at a time, so each
+ * worker thread shapes with a font map of its own. They render through
+ * the renderer of the default font map, sharing its glyph cache. The
+ * lock is held whenever the fonts are used: in the worker while
+ * shaping, and in the main thread whenever a layout shaped with the
+ * font map is used, see clutter_text_lock_async_font_maps(). */
+typedef struct _AsyncFontMap
+{
+  GRecMutex lock;
+  PangoFontMap *font_map;
+} AsyncFontMap;
+
+typedef struct _AsyncLayoutJob
+{
+  ClutterText *text;
+
+  /* The value of ClutterTextPrivate::layout_generation when the job was
+   * queued; if it changed, the result is outdated */
+  guint generation;
+
+  gint width;
+  gint height;
+  PangoEllipsizeMode ellipsize;
+
+  /* Layout set up in the main thread, with the context of the actor;
+   * only read by the worker thread, to create the layout to shape */
+  PangoLayout *template;
+  PangoFontDescription *font_desc;
+  cairo_font_options_t *font_options;
+  double resolution;
+  PangoLanguage *language;
+  PangoDirection direction;
+
+  AsyncFontMap *async_font_map;
+  PangoLayout *layout;
+} AsyncLayoutJob;
+
+static GThreadPool *async_layout_pool = NULL;
+static AsyncFontMap async_font_maps[N_ASYNC_LAYOUT_THREADS];
+static GPrivate async_font_map_key;
+static gint next_async_font_map = 0;
+
 struct _ClutterTextInputFocus
 {
   ClutterInputFocus parent_instance;
@@ -187,6 +265,15 @@ struct _ClutterTextPrivate
   ClutterInputContentHintFlags input_hints;
   ClutterInputContentPurpose input_purpose;
 
+  /* Asynchronous layout; the job currently being shaped, if any, and the
+   * layout shown until it is done */
+  AsyncLayoutJob *async_job;
+  PangoLayout *previous_layout;
+  guint layout_generation;
+
+  /* Mask of the async font maps used by the layouts of the actor */
+  guint async_font_maps_used;
+
   /* bitfields */
   guint alignment               : 2;
   guint wrap                    : 1;
@@ -211,6 +298,8 @@ struct _ClutterTextPrivate
   guint paint_volume_valid      : 1;
   guint show_password_hint      : 1;
   guint password_hint_visible   : 1;
+  guint async_layout            : 1;
+  guint layout_escaped          : 1;
   guint resolved_direction      : 4;
 };
 
@@ -249,6 +338,7 @@ enum
   PROP_SELECTED_TEXT_COLOR_SET,
   PROP_INPUT_HINTS,
   PROP_INPUT_PURPOSE,
+  PROP_ASYNC_LAYOUT,
 
   PROP_LAST
 };
@@ -705,6 +795,91 @@ clutter_text_ensure_effective_attributes (ClutterText *self)
     }
 }
 
+static PangoDirection
+clutter_text_resolve_direction (ClutterText *text,
+                                const gchar *contents,
+                                gsize        contents_len)
+{
+  ClutterTextPrivate *priv = text->priv;
+  PangoDirection pango_dir;
+
+  if (priv->password_char != 0)
+    pango_dir = PANGO_DIRECTION_NEUTRAL;
+  else
+    pango_dir = _clutter_pango_find_base_dir (contents, contents_len);
+
+  if (pango_dir == PANGO_DIRECTION_NEUTRAL)
+    {
+      ClutterBackend *backend = clutter_get_default_backend ();
+      ClutterTextDirection text_dir;
+
+      if (clutter_actor_has_key_focus (CLUTTER_ACTOR (text)))
+        {
+          ClutterSeat *seat;
+          ClutterKeymap *keymap;
+
+          seat = clutter_backend_get_default_seat (backend);
+          keymap = clutter_seat_get_keymap (seat);
+          pango_dir = clutter_keymap_get_direction (keymap);
+        }
+      else
+        {
+          text_dir = clutter_actor_get_text_direction (CLUTTER_ACTOR (text));
+
+          if (text_dir == CLUTTER_TEXT_DIRECTION_RTL)
+            pango_dir = PANGO_DIRECTION_RTL;
+          else
+            pango_dir = PANGO_DIRECTION_LTR;
+       }
+    }
+
+  priv->resolved_direction = pango_dir;
+
+  return pango_dir;
+}
+
+/* Applies everything but the text to a newly created layout. Layouts
+ * which may outlive the actor's attributes, or are used from another
+ * thread, need a copy of the attributes, since these may be changed in
+ * place by whoever set them. */
+static void
+clutter_text_setup_layout (ClutterText       *text,
+                           PangoLayout       *layout,
+                           gint               width,
+                           gint               height,
+                           PangoEllipsizeMode ellipsize,
+                           gboolean           copy_attributes)
+{
+  ClutterTextPrivate *priv = text->priv;
+
+  pango_layout_set_font_description (layout, priv->font_desc);
+
+  /* This will merge the markup attributes and the attributes
+   * property if needed */
+  clutter_text_ensure_effective_attributes (text);
+
+  if (priv->effective_attrs != NULL && copy_attributes)
+    {
+      PangoAttrList *attrs = pango_attr_list_copy (priv->effective_attrs);
+
+      pango_layout_set_attributes (layout, attrs);
+      pango_attr_list_unref (attrs);
+    }
+  else if (priv->effective_attrs != NULL)
+    {
+      pango_layout_set_attributes (layout, priv->effective_attrs);
+    }
+
+  pango_layout_set_alignment (layout, priv->alignment);
+  pango_layout_set_single_paragraph_mode (layout, priv->single_line_mode);
+  pango_layout_set_justify (layout, priv->justify);
+  pango_layout_set_wrap (layout, priv->wrap_mode);
+
+  pango_layout_set_ellipsize (layout, ellipsize);
+  pango_layout_set_width (layout, width);
+  pango_layout_set_height (layout, height);
+}
+
 static PangoLayout *
 clutter_text_create_layout_no_cache (ClutterText       *text,
 				     gint               width,
@@ -717,7 +892,6 @@ clutter_text_create_layout_no_cache (ClutterText       *text,
   gsize contents_len;
 
   layout = clutter_actor_create_pango_layout (CLUTTER_ACTOR (text), NULL);
-  pango_layout_set_font_description (layout, priv->font_desc);
 
   contents = clutter_text_get_display_text (text);
   contents_len = strlen (contents);
@@ -753,70 +927,650 @@ clutter_text_create_layout_no_cache (ClutterText       *text,
     {
       PangoDirection pango_dir;
 
-      if (priv->password_char != 0)
-        pango_dir = PANGO_DIRECTION_NEUTRAL;
-      else
-        pango_dir = _clutter_pango_find_base_dir (contents, contents_len);
+      pango_dir = clutter_text_resolve_direction (text, contents, contents_len);
+      pango_context_set_base_dir (clutter_actor_get_pango_context (CLUTTER_ACTOR (text)), pango_dir);
+
+      pango_layout_set_text (layout, contents, contents_len);
+    }
+
+  clutter_text_setup_layout (text, layout, width, height, ellipsize, FALSE);
+
+  g_free (contents);
+
+  return layout;
+}
+
+static gboolean
+font_options_equal (const cairo_font_options_t *a,
+                    const cairo_font_options_t *b)
+{
+  if (a == NULL || b == NULL)
+    return a == b;
+
+  return cairo_font_options_equal (a, b);
+}
+
+/* Whether the shared context @a is configured like @b, apart from the
+ * base direction, which is checked against @direction */
+static gboolean
+pango_context_equal (PangoContext   *a,
+                     PangoContext   *b,
+                     PangoDirection  direction)
+{
+  return (pango_context_get_font_map (a) == pango_context_get_font_map (b) &&
+          pango_context_get_base_dir (a) == direction &&
+          pango_cairo_context_get_resolution (a) ==
+          pango_cairo_context_get_resolution (b) &&
+          font_options_equal (pango_cairo_context_get_font_options (a),
+                              pango_cairo_context_get_font_options (b)) &&
+          pango_font_description_equal (pango_context_get_font_description (a),
+                                        pango_context_get_font_description (b)));
+}
+
+/*
+ * Returns a context with the same configuration as the one of @text,
+ * but with @direction as base direction, that can be used for shared
+ * layouts. The returned context is owned by the shared cache; layouts
+ * hold their own reference.
+ */
+static PangoContext *
+get_shared_pango_context (ClutterText    *text,
+                          PangoDirection  direction)
+{
+  PangoContext *actor_context =
+    clutter_actor_get_pango_context (CLUTTER_ACTOR (text));
+  PangoContext *context;
+  GList *l;
+
+  for (l = shared_contexts.head; l; l = l->next)
+    {
+      context = l->data;
+
+      if (pango_context_equal (context, actor_context, direction))
+        return context;
+    }
+
+  context = clutter_actor_create_pango_context (CLUTTER_ACTOR (text));
+  pango_context_set_base_dir (context, direction);
+
+  g_queue_push_head (&shared_contexts, context);
+  if (shared_contexts.length > N_SHARED_CONTEXTS)
+    g_object_unref (g_queue_pop_tail (&shared_contexts));
+
+  return context;
+}
+
+static gboolean
+pango_attr_list_collect (PangoAttribute *attr,
+                         gpointer        user_data)
+{
+  GSList **attrs = user_data;
+
+  *attrs = g_slist_prepend (*attrs, attr);
+
+  /* Don't remove anything from the list */
+  return FALSE;
+}
+
+static gboolean
+pango_attr_list_equal_compat (PangoAttrList *a,
+                              PangoAttrList *b)
+{
+  GSList *attrs_a = NULL, *attrs_b = NULL;
+  GSList *la, *lb;
+  gboolean equal = TRUE;
+
+  if (a == NULL || b == NULL)
+    return a == b;
 
-      if (pango_dir == PANGO_DIRECTION_NEUTRAL)
+  if (a == b)
+    return TRUE;
+
+  pango_attr_list_filter (a, pango_attr_list_collect, &attrs_a);
+  pango_attr_list_filter (b, pango_attr_list_collect, &attrs_b);
+
+  for (la = attrs_a, lb = attrs_b;
+       la != NULL && lb != NULL;
+       la = la->next, lb = lb->next)
+    {
+      PangoAttribute *attr_a = la->data;
+      PangoAttribute *attr_b = lb->data;
+
+      if (attr_a->start_index != attr_b->start_index ||
+          attr_a->end_index != attr_b->end_index ||
+          !pango_attribute_equal (attr_a, attr_b))
         {
-          ClutterBackend *backend = clutter_get_default_backend ();
-          ClutterTextDirection text_dir;
+          equal = FALSE;
+          break;
+        }
+    }
 
-          if (clutter_actor_has_key_focus (CLUTTER_ACTOR (text)))
-            {
-              ClutterSeat *seat;
-              ClutterKeymap *keymap;
+  if (la != NULL || lb != NULL)
+    equal = FALSE;
 
-              seat = clutter_backend_get_default_seat (backend);
-              keymap = clutter_seat_get_keymap (seat);
-              pango_dir = clutter_keymap_get_direction (keymap);
-            }
-          else
-            {
-              text_dir = clutter_actor_get_text_direction (CLUTTER_ACTOR (text));
+  g_slist_free (attrs_a);
+  g_slist_free (attrs_b);
+
+  return equal;
+}
+
+static gboolean
+shared_layout_matches (SharedLayout      *shared,
+                       guint              hash,
+                       ClutterText       *text,
+                       PangoContext      *context,
+                       const gchar       *contents,
+                       gint               width,
+                       gint               height,
+                       PangoEllipsizeMode ellipsize)
+{
+  ClutterTextPrivate *priv = text->priv;
+  PangoLayout *layout = shared->layout;
+
+  return (shared->hash == hash &&
+          pango_layout_get_context (layout) == context &&
+          pango_layout_get_width (layout) == width &&
+          pango_layout_get_height (layout) == height &&
+          pango_layout_get_ellipsize (layout) == ellipsize &&
+          pango_layout_get_alignment (layout) == priv->alignment &&
+          pango_layout_get_single_paragraph_mode (layout) == priv->single_line_mode &&
+          pango_layout_get_justify (layout) == priv->justify &&
+          pango_layout_get_wrap (layout) == priv->wrap_mode &&
+          strcmp (pango_layout_get_text (layout), contents) == 0 &&
+          pango_font_description_equal (pango_layout_get_font_description (layout),
+                                        priv->font_desc) &&
+          pango_attr_list_equal_compat (pango_layout_get_attributes (layout),
+                                        priv->effective_attrs));
+}
+
+/*
+ * Like clutter_text_create_layout_no_cache(), but looks up the layout in
+ * the cache shared between all text actors first. Only usable for
+ * non-editable text; see clutter_text_can_share_layout().
+ */
+static PangoLayout *
+clutter_text_create_shared_layout (ClutterText       *text,
+                                   gint               width,
+                                   gint               height,
+                                   PangoEllipsizeMode ellipsize)
+{
+  ClutterTextPrivate *priv = text->priv;
+  SharedLayout *shared;
+  PangoContext *context;
+  PangoDirection direction;
+  gchar *contents;
+  gsize contents_len;
+  guint hash;
+  GList *l;
+
+  contents = clutter_text_get_display_text (text);
+  contents_len = strlen (contents);
+
+  direction = clutter_text_resolve_direction (text, contents, contents_len);
+  context = get_shared_pango_context (text, direction);
+
+  clutter_text_ensure_effective_attributes (text);
+
+  hash = g_str_hash (contents);
+  hash = hash * 31 + pango_font_description_hash (priv->font_desc);
+  hash = hash * 31 + width;
+  hash = hash * 31 + height;
+  hash = hash * 31 + ellipsize;
+
+  for (l = shared_layouts.head; l; l = l->next)
+    {
+      shared = l->data;
 
-              if (text_dir == CLUTTER_TEXT_DIRECTION_RTL)
-                pango_dir = PANGO_DIRECTION_RTL;
-              else
-                pango_dir = PANGO_DIRECTION_LTR;
-           }
+      if (shared_layout_matches (shared, hash, text, context, contents,
+                                 width, height, ellipsize))
+        {
+          CLUTTER_NOTE (ACTOR, "ClutterText: %p: shared layout cache hit",
+                        text);
+
+          /* Move to the front so the cache is evicted in LRU order */
+          g_queue_unlink (&shared_layouts, l);
+          g_queue_push_head_link (&shared_layouts, l);
+
+          n_shared_layout_hits++;
+
+          g_free (contents);
+
+          return g_object_ref (shared->layout);
         }
+    }
 
-      pango_context_set_base_dir (clutter_actor_get_pango_context (CLUTTER_ACTOR (text)), pango_dir);
+  shared = g_new0 (SharedLayout, 1);
+  shared->hash = hash;
+  shared->layout = pango_layout_new (context);
+  pango_layout_set_text (shared->layout, contents, contents_len);
+  clutter_text_setup_layout (text, shared->layout,
+                             width, height, ellipsize,
+                             TRUE);
 
-      priv->resolved_direction = pango_dir;
+  cogl_pango_ensure_glyph_cache_for_layout (shared->layout);
 
-      pango_layout_set_text (layout, contents, contents_len);
+  g_queue_push_head (&shared_layouts, shared);
+  if (shared_layouts.length > N_SHARED_LAYOUTS)
+    {
+      SharedLayout *oldest = g_queue_pop_tail (&shared_layouts);
+
+      g_object_unref (oldest->layout);
+      g_free (oldest);
     }
 
-  /* This will merge the markup attributes and the attributes
-   * property if needed */
-  clutter_text_ensure_effective_attributes (text);
+  g_free (contents);
 
-  if (priv->effective_attrs != NULL)
-    pango_layout_set_attributes (layout, priv->effective_attrs);
+  return g_object_ref (shared->layout);
+}
 
-  pango_layout_set_alignment (layout, priv->alignment);
-  pango_layout_set_single_paragraph_mode (layout, priv->single_line_mode);
-  pango_layout_set_justify (layout, priv->justify);
-  pango_layout_set_wrap (layout, priv->wrap_mode);
+/*
+ * Creates a job for shaping a layout like the one of
+ * clutter_text_create_layout_no_cache() in a worker thread. Everything
+ * needed from the actor is copied, as it can't be accessed from the
+ * worker thread.
+ */
+static AsyncLayoutJob *
+clutter_text_create_async_layout_job (ClutterText       *text,
+                                      gint               width,
+                                      gint               height,
+                                      PangoEllipsizeMode ellipsize)
+{
+  ClutterTextPrivate *priv = text->priv;
+  PangoContext *actor_context =
+    clutter_actor_get_pango_context (CLUTTER_ACTOR (text));
+  const cairo_font_options_t *font_options;
+  AsyncLayoutJob *job;
+  gchar *contents;
+  gsize contents_len;
 
-  pango_layout_set_ellipsize (layout, ellipsize);
-  pango_layout_set_width (layout, width);
-  pango_layout_set_height (layout, height);
+  contents = clutter_text_get_display_text (text);
+  contents_len = strlen (contents);
+
+  job = g_new0 (AsyncLayoutJob, 1);
+  job->text = g_object_ref (text);
+  job->generation = priv->layout_generation;
+  job->width = width;
+  job->height = height;
+  job->ellipsize = ellipsize;
+
+  job->template = pango_layout_new (actor_context);
+  pango_layout_set_text (job->template, contents, contents_len);
+  clutter_text_setup_layout (text, job->template,
+                             width, height, ellipsize,
+                             TRUE);
+
+  job->font_desc =
+    pango_font_description_copy (pango_context_get_font_description (actor_context));
+  font_options = pango_cairo_context_get_font_options (actor_context);
+  if (font_options)
+    job->font_options = cairo_font_options_copy (font_options);
+  job->resolution = pango_cairo_context_get_resolution (actor_context);
+  job->language = pango_context_get_language (actor_context);
+  job->direction = clutter_text_resolve_direction (text, contents,
+                                                   contents_len);
 
   g_free (contents);
 
-  return layout;
+  return job;
+}
+
+/* Returns the cache slot to be used for a new layout; a free one, or
+ * the least recently used one after releasing its layout */
+static LayoutCache *
+clutter_text_get_layout_cache_slot (ClutterText *text)
+{
+  ClutterTextPrivate *priv = text->priv;
+  LayoutCache *oldest_cache = priv->cached_layouts;
+  int i;
+
+  for (i = 0; i < N_CACHED_LAYOUTS; i++)
+    {
+      if (priv->cached_layouts[i].layout == NULL)
+        return priv->cached_layouts + i;
+
+      if (priv->cached_layouts[i].age < oldest_cache->age)
+        oldest_cache = priv->cached_layouts + i;
+    }
+
+  g_clear_object (&oldest_cache->layout);
+
+  return oldest_cache;
+}
+
+/* Returns the most recently used layout, or NULL if there is none */
+static PangoLayout *
+clutter_text_get_last_layout (ClutterText *text)
+{
+  ClutterTextPrivate *priv = text->priv;
+  LayoutCache *newest_cache = NULL;
+  int i;
+
+  for (i = 0; i < N_CACHED_LAYOUTS; i++)
+    {
+      LayoutCache *cache = priv->cached_layouts + i;
+
+      if (cache->layout == NULL)
+        continue;
+
+      if (newest_cache == NULL || cache->age > newest_cache->age)
+        newest_cache = cache;
+    }
+
+  return newest_cache ? newest_cache->layout : NULL;
+}
+
+static void
+async_layout_job_free (AsyncLayoutJob *job)
+{
+  g_clear_object (&job->layout);
+  g_object_unref (job->template);
+  pango_font_description_free (job->font_desc);
+  g_clear_pointer (&job->font_options, cairo_font_options_destroy);
+  g_object_unref (job->text);
+  g_free (job);
+}
+
+static void
+ensure_async_font_maps (void)
+{
+  CoglPangoFontMap *default_font_map =
+    COGL_PANGO_FONT_MAP (clutter_get_font_map ());
+  int i;
+
+  for (i = 0; i < N_ASYNC_LAYOUT_THREADS; i++)
+    {
+      AsyncFontMap *async_font_map = &async_font_maps[i];
+
+      g_rec_mutex_init (&async_font_map->lock);
+      async_font_map->font_map =
+        cogl_pango_font_map_new_sharing_renderer (default_font_map);
+    }
+}
+
+static AsyncFontMap *
+get_thread_async_font_map (void)
+{
+  AsyncFontMap *async_font_map;
+
+  async_font_map = g_private_get (&async_font_map_key);
+  if (async_font_map == NULL)
+    {
+      int index = g_atomic_int_add (&next_async_font_map, 1);
+
+      /* Pool threads may be replaced over time, and then share the
+       * font maps of previous threads */
+      async_font_map = &async_font_maps[index % N_ASYNC_LAYOUT_THREADS];
+      g_private_set (&async_font_map_key, async_font_map);
+    }
+
+  return async_font_map;
+}
+
+/*
+ * Locks the async font maps used by the layouts of @text, so that they
+ * can be used from the main thread. This is needed around any use of
+ * the cached layouts, except for editable text, which never uses layouts
+ * shaped in worker threads.
+ *
+ * Returns the mask of the locked font maps, to be passed to
+ * clutter_text_unlock_async_font_maps().
+ */
+static guint
+clutter_text_lock_async_font_maps (ClutterText *text)
+{
+  guint locked = text->priv->async_font_maps_used;
+  int i;
+
+  for (i = 0; i < N_ASYNC_LAYOUT_THREADS; i++)
+    {
+      if (locked & (1 << i))
+        g_rec_mutex_lock (&async_font_maps[i].lock);
+    }
+
+  return locked;
+}
+
+static void
+clutter_text_unlock_async_font_maps (guint locked)
+{
+  int i;
+
+  for (i = N_ASYNC_LAYOUT_THREADS - 1; i >= 0; i--)
+    {
+      if (locked & (1 << i))
+        g_rec_mutex_unlock (&async_font_maps[i].lock);
+    }
+}
+
+static gboolean
+async_layout_job_complete (gpointer user_data)
+{
+  AsyncLayoutJob *job = user_data;
+  ClutterText *text = job->text;
+  ClutterTextPrivate *priv = text->priv;
+  AsyncFontMap *async_font_map = job->async_font_map;
+  guint font_map_mask = 1 << (async_font_map - async_font_maps);
+  guint locked;
+
+  if (priv->async_job == job)
+    priv->async_job = NULL;
+
+  /* Even an outdated layout uses the fonts when it is freed */
+  locked = clutter_text_lock_async_font_maps (text);
+  if (!(locked & font_map_mask))
+    g_rec_mutex_lock (&async_font_map->lock);
+
+  if (job->generation == priv->layout_generation)
+    {
+      LayoutCache *cache = clutter_text_get_layout_cache_slot (text);
+
+      CLUTTER_NOTE (ACTOR, "ClutterText: %p: async layout done for %dx%d",
+                    text, job->width, job->height);
+
+      cache->layout = g_object_ref (job->layout);
+      cache->width = job->width;
+      cache->height = job->height;
+      cache->ellipsize = job->ellipsize;
+      cache->shared = FALSE;
+      cache->age = priv->cache_age++;
+
+      priv->async_font_maps_used |= font_map_mask;
+
+      cogl_pango_ensure_glyph_cache_for_layout (cache->layout);
+
+      g_clear_object (&priv->previous_layout);
+
+      clutter_text_dirty_paint_volume (text);
+    }
+
+  /* An outdated result is dropped, but the layout still needs to be
+   * requested again */
+  if (!CLUTTER_ACTOR_IN_DESTRUCTION (text))
+    clutter_actor_queue_relayout (CLUTTER_ACTOR (text));
+
+  async_layout_job_free (job);
+
+  if (!(locked & font_map_mask))
+    g_rec_mutex_unlock (&async_font_map->lock);
+  clutter_text_unlock_async_font_maps (locked);
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+shape_layout_in_thread (gpointer data,
+                        gpointer user_data)
+{
+  AsyncLayoutJob *job = data;
+  AsyncFontMap *async_font_map = get_thread_async_font_map ();
+  PangoLayout *template = job->template;
+  PangoContext *context;
+  PangoLayout *layout;
+  PangoRectangle ink_rect;
+
+  g_rec_mutex_lock (&async_font_map->lock);
+
+  context =
+    cogl_pango_font_map_create_context (COGL_PANGO_FONT_MAP (async_font_map->font_map));
+  pango_context_set_font_description (context, job->font_desc);
+  pango_cairo_context_set_font_options (context, job->font_options);
+  pango_cairo_context_set_resolution (context, job->resolution);
+  pango_context_set_language (context, job->language);
+  pango_context_set_base_dir (context, job->direction);
+
+  layout = pango_layout_new (context);
+  pango_layout_set_text (layout, pango_layout_get_text (template), -1);
+  pango_layout_set_font_description (layout,
+                                     pango_layout_get_font_description (template));
+  pango_layout_set_attributes (layout, pango_layout_get_attributes (template));
+  pango_layout_set_alignment (layout, pango_layout_get_alignment (template));
+  pango_layout_set_single_paragraph_mode (layout,
+                                          pango_layout_get_single_paragraph_mode (template));
+  pango_layout_set_justify (layout, pango_layout_get_justify (template));
+  pango_layout_set_wrap (layout, pango_layout_get_wrap (template));
+  pango_layout_set_ellipsize (layout, pango_layout_get_ellipsize (template));
+  pango_layout_set_width (layout, pango_layout_get_width (template));
+  pango_layout_set_height (layout, pango_layout_get_height (template));
+
+  /* Retrieving the extents lays out, and thus shapes, the whole text;
+   * the ink extents need the glyph extents, which are cached as well */
+  pango_layout_get_extents (layout, &ink_rect, NULL);
+
+  g_object_unref (context);
+
+  g_rec_mutex_unlock (&async_font_map->lock);
+
+  job->async_font_map = async_font_map;
+  job->layout = layout;
+
+  g_idle_add_full (G_PRIORITY_DEFAULT,
+                   async_layout_job_complete,
+                   job, NULL);
+}
+
+/*
+ * Queues shaping of the layout for the given parameters in a worker
+ * thread, unless another layout is already being shaped; once that one
+ * is done, the actor is relaid out, and the layout requested again.
+ *
+ * Returns the layout to use in the meantime: the most recently used one
+ * if any, the last layout before the contents changed, or an empty
+ * placeholder.
+ */
+static PangoLayout *
+clutter_text_queue_async_layout (ClutterText       *text,
+                                 gint               width,
+                                 gint               height,
+                                 PangoEllipsizeMode ellipsize)
+{
+  ClutterTextPrivate *priv = text->priv;
+  PangoLayout *layout;
+
+  if (priv->async_job == NULL)
+    {
+      AsyncLayoutJob *job;
+
+      CLUTTER_NOTE (ACTOR, "ClutterText: %p: queueing async layout for %dx%d",
+                    text, width, height);
+
+      job = clutter_text_create_async_layout_job (text, width, height,
+                                                  ellipsize);
+
+      if (G_UNLIKELY (async_layout_pool == NULL))
+        {
+          ensure_async_font_maps ();
+          async_layout_pool = g_thread_pool_new (shape_layout_in_thread,
+                                                 NULL,
+                                                 N_ASYNC_LAYOUT_THREADS,
+                                                 FALSE,
+                                                 NULL);
+        }
+
+      priv->async_job = job;
+      g_thread_pool_push (async_layout_pool, job, NULL);
+    }
+
+  layout = clutter_text_get_last_layout (text);
+  if (layout != NULL)
+    return layout;
+
+  if (priv->previous_layout == NULL)
+    {
+      priv->previous_layout =
+        clutter_actor_create_pango_layout (CLUTTER_ACTOR (text), NULL);
+      pango_layout_set_font_description (priv->previous_layout,
+                                         priv->font_desc);
+    }
+
+  return priv->previous_layout;
+}
+
+static gboolean
+clutter_text_uses_async_layout (ClutterText *text)
+{
+  ClutterTextPrivate *priv = text->priv;
+
+  /* Layouts handed out by clutter_text_get_layout() are used without
+   * the font map locks, so they must be shaped in the main thread */
+  return (priv->async_layout &&
+          !priv->editable &&
+          !priv->layout_escaped);
+}
+
+static gboolean
+clutter_text_can_share_layout (ClutterText *text)
+{
+  ClutterTextPrivate *priv = text->priv;
+
+  /* Editable text has a cursor, preedit string and selection which are
+   * tied to the actor. Layouts handed out by clutter_text_get_layout()
+   * may be modified by the caller, so they must be the actor's own. */
+  return (!priv->editable &&
+          priv->password_char == 0 &&
+          !priv->layout_escaped);
+}
+
+/* Drops the cached layouts coming from the shared cache, so that they
+ * are recreated as layouts owned by @text */
+static void
+clutter_text_unshare_layouts (ClutterText *text)
+{
+  ClutterTextPrivate *priv = text->priv;
+  int i;
+
+  for (i = 0; i < N_CACHED_LAYOUTS; i++)
+    {
+      LayoutCache *cache = priv->cached_layouts + i;
+
+      if (cache->shared)
+        {
+          g_clear_object (&cache->layout);
+          cache->shared = FALSE;
+        }
+    }
 }
 
 static void
 clutter_text_dirty_cache (ClutterText *text)
 {
   ClutterTextPrivate *priv = text->priv;
+  guint locked;
   int i;
 
+  /* Any layout being shaped asynchronously is now outdated */
+  priv->layout_generation++;
+
+  locked = clutter_text_lock_async_font_maps (text);
+
+  /* Keep showing the last layout until the new one is ready */
+  if (clutter_text_uses_async_layout (text))
+    {
+      PangoLayout *last_layout = clutter_text_get_last_layout (text);
+
+      if (last_layout != NULL)
+        g_set_object (&priv->previous_layout, last_layout);
+    }
+
   /* Delete the cached layouts so they will be recreated the next time
      they are needed */
   for (i = 0; i < N_CACHED_LAYOUTS; i++)
@@ -826,9 +1580,31 @@ clutter_text_dirty_cache (ClutterText *text)
 	priv->cached_layouts[i].layout = NULL;
       }
 
+  clutter_text_unlock_async_font_maps (locked);
+
   clutter_text_dirty_paint_volume (text);
 }
 
+/*
+ * Drops all layouts that were shaped in worker threads, including the
+ * one shown while shaping, so that they are recreated in the main thread
+ * when needed.
+ */
+static void
+clutter_text_drop_async_layouts (ClutterText *text)
+{
+  ClutterTextPrivate *priv = text->priv;
+  guint locked;
+
+  locked = clutter_text_lock_async_font_maps (text);
+
+  clutter_text_dirty_cache (text);
+  g_clear_object (&priv->previous_layout);
+  priv->async_font_maps_used = 0;
+
+  clutter_text_unlock_async_font_maps (locked);
+}
+
 /*
  * clutter_text_set_font_description_internal:
  * @self: a #ClutterText
@@ -1005,7 +1781,7 @@ clutter_text_create_layout (ClutterText *text,
     }
 
   /* Search for a cached layout with the same width and keep
-   * track of the oldest one
+   * track of the least recently used one
    */
   for (i = 0; i < N_CACHED_LAYOUTS; i++)
     {
@@ -1017,10 +1793,9 @@ clutter_text_create_layout (ClutterText *text,
 	}
       else
         {
-          PangoLayout *cached = priv->cached_layouts[i].layout;
-          gint cached_width = pango_layout_get_width (cached);
-	  gint cached_height = pango_layout_get_height (cached);
-	  gint cached_ellipsize = pango_layout_get_ellipsize (cached);
+          gint cached_width = priv->cached_layouts[i].width;
+	  gint cached_height = priv->cached_layouts[i].height;
+	  gint cached_ellipsize = priv->cached_layouts[i].ellipsize;
 
 	  if (cached_width == width &&
 	      cached_height == height &&
@@ -1035,6 +1810,7 @@ clutter_text_create_layout (ClutterText *text,
                             allocation_width,
                             allocation_height);
 
+              priv->cached_layouts[i].age = priv->cache_age++;
               return priv->cached_layouts[i].layout;
 	    }
 
@@ -1066,6 +1842,7 @@ clutter_text_create_layout (ClutterText *text,
 				allocation_width,
 				allocation_height);
 
+                  priv->cached_layouts[i].age = priv->cache_age++;
 		  return priv->cached_layouts[i].layout;
 		}
 	    }
@@ -1085,15 +1862,32 @@ clutter_text_create_layout (ClutterText *text,
 
   /* If we make it here then we didn't have a cached version so we
      need to recreate the layout */
-  if (oldest_cache->layout)
-    g_object_unref (oldest_cache->layout);
+  g_clear_object (&oldest_cache->layout);
 
-  oldest_cache->layout =
-    clutter_text_create_layout_no_cache (text, width, height, ellipsize);
+  if (clutter_text_uses_async_layout (text))
+    {
+      return clutter_text_queue_async_layout (text, width, height, ellipsize);
+    }
+  else if (clutter_text_can_share_layout (text))
+    {
+      oldest_cache->layout =
+        clutter_text_create_shared_layout (text, width, height, ellipsize);
+      oldest_cache->shared = TRUE;
+    }
+  else
+    {
+      oldest_cache->layout =
+        clutter_text_create_layout_no_cache (text, width, height, ellipsize);
+      oldest_cache->shared = FALSE;
 
-  cogl_pango_ensure_glyph_cache_for_layout (oldest_cache->layout);
+      cogl_pango_ensure_glyph_cache_for_layout (oldest_cache->layout);
+    }
 
-  /* Mark the 'time' this cache was created and advance the time */
+  oldest_cache->width = width;
+  oldest_cache->height = height;
+  oldest_cache->ellipsize = ellipsize;
+
+  /* Mark the 'time' this cache was used and advance the time */
   oldest_cache->age = priv->cache_age++;
   return oldest_cache->layout;
 }
@@ -1128,6 +1922,28 @@ maybe_create_text_layout_with_resource_scale (ClutterText *text,
                                         resource_scale);
 }
 
+/*
+ * Like clutter_text_get_layout(), for use within ClutterText; the layout
+ * doesn't escape the actor, so it may still be shared with other actors.
+ */
+static PangoLayout *
+clutter_text_get_layout_internal (ClutterText *self)
+{
+  PangoLayout *layout;
+  gfloat width, height;
+
+  if (self->priv->editable && self->priv->single_line_mode)
+    return clutter_text_create_layout (self, -1, -1);
+
+  clutter_actor_get_size (CLUTTER_ACTOR (self), &width, &height);
+  layout = maybe_create_text_layout_with_resource_scale (self, width, height);
+
+  if (!layout)
+    layout = clutter_text_create_layout (self, width, height);
+
+  return layout;
+}
+
 /**
  * clutter_text_coords_to_position:
  * @self: a #ClutterText
@@ -1149,6 +1965,7 @@ clutter_text_coords_to_position (ClutterText *self,
   gint px, py;
   gint trailing;
   gfloat resource_scale;
+  guint locked;
 
   g_return_val_if_fail (CLUTTER_IS_TEXT (self), 0);
 
@@ -1160,9 +1977,11 @@ clutter_text_coords_to_position (ClutterText *self,
   px = logical_pixels_to_pango (x - self->priv->text_logical_x, resource_scale);
   py = logical_pixels_to_pango (y - self->priv->text_logical_y, resource_scale);
 
-  pango_layout_xy_to_index (clutter_text_get_layout (self),
+  locked = clutter_text_lock_async_font_maps (self);
+  pango_layout_xy_to_index (clutter_text_get_layout_internal (self),
                             px, py,
                             &index_, &trailing);
+  clutter_text_unlock_async_font_maps (locked);
 
   return index_ + trailing;
 }
@@ -1180,6 +1999,7 @@ clutter_text_position_to_coords_internal (ClutterText *self,
   gint password_char_bytes = 1;
   gint index_;
   gsize n_bytes;
+  guint locked;
 
   g_return_val_if_fail (CLUTTER_IS_TEXT (self), FALSE);
 
@@ -1232,9 +2052,11 @@ clutter_text_position_to_coords_internal (ClutterText *self,
       g_string_free (tmp, TRUE);
     }
 
-  pango_layout_get_cursor_pos (clutter_text_get_layout (self),
+  locked = clutter_text_lock_async_font_maps (self);
+  pango_layout_get_cursor_pos (clutter_text_get_layout_internal (self),
                                index_,
                                &rect, NULL);
+  clutter_text_unlock_async_font_maps (locked);
 
   if (x)
     {
@@ -1608,6 +2430,10 @@ clutter_text_set_property (GObject      *gobject,
       clutter_text_set_single_line_mode (self, g_value_get_boolean (value));
       break;
 
+    case PROP_ASYNC_LAYOUT:
+      clutter_text_set_async_layout (self, g_value_get_boolean (value));
+      break;
+
     case PROP_SELECTED_TEXT_COLOR:
       clutter_text_set_selected_text_color (self, clutter_value_get_color (value));
       break;
@@ -1709,6 +2535,10 @@ clutter_text_get_property (GObject    *gobject,
       g_value_set_boolean (value, priv->single_line_mode);
       break;
 
+    case PROP_ASYNC_LAYOUT:
+      g_value_set_boolean (value, priv->async_layout);
+      break;
+
     case PROP_ELLIPSIZE:
       g_value_set_enum (value, priv->ellipsize);
       break;
@@ -1753,7 +2583,7 @@ clutter_text_dispose (GObject *gobject)
   ClutterTextPrivate *priv = self->priv;
 
   /* get rid of the entire cache */
-  clutter_text_dirty_cache (self);
+  clutter_text_drop_async_layouts (self);
 
   g_clear_signal_handler (&priv->direction_changed_id, self);
   g_clear_signal_handler (&priv->settings_changed_id,
@@ -1805,7 +2635,8 @@ clutter_text_foreach_selection_rectangle (ClutterText              *self,
                                           gpointer                  user_data)
 {
   ClutterTextPrivate *priv = self->priv;
-  PangoLayout *layout = clutter_text_get_layout (self);
+  guint locked = clutter_text_lock_async_font_maps (self);
+  PangoLayout *layout = clutter_text_get_layout_internal (self);
   gchar *utf8 = clutter_text_get_display_text (self);
   gint lines;
   gint start_index;
@@ -1884,6 +2715,8 @@ clutter_text_foreach_selection_rectangle (ClutterText              *self,
     }
 
   g_free (utf8);
+
+  clutter_text_unlock_async_font_maps (locked);
 }
 
 static void
@@ -1904,7 +2737,7 @@ paint_selection_rectangle (ClutterText           *self,
   ClutterActor *actor = CLUTTER_ACTOR (self);
   guint8 paint_opacity = clutter_actor_get_paint_opacity (actor);
   CoglPipeline *color_pipeline = cogl_pipeline_copy (default_color_pipeline);
-  PangoLayout *layout = clutter_text_get_layout (self);
+  PangoLayout *layout = clutter_text_get_layout_internal (self);
   CoglColor cogl_color = { 0, };
   const ClutterColor *color;
 
@@ -2004,11 +2837,13 @@ clutter_text_move_word_backward (ClutterText *self,
 
   if (clutter_text_buffer_get_length (get_buffer (self)) > 0 && start > 0)
     {
-      PangoLayout *layout = clutter_text_get_layout (self);
+      guint locked = clutter_text_lock_async_font_maps (self);
+      PangoLayout *layout = clutter_text_get_layout_internal (self);
       PangoLogAttr *log_attrs = NULL;
       gint n_attrs = 0;
 
       pango_layout_get_log_attrs (layout, &log_attrs, &n_attrs);
+      clutter_text_unlock_async_font_maps (locked);
 
       retval = start - 1;
       while (retval > 0 && !log_attrs[retval].is_word_start)
@@ -2030,11 +2865,13 @@ clutter_text_move_word_forward (ClutterText *self,
   n_chars = clutter_text_buffer_get_length (get_buffer (self));
   if (n_chars > 0 && start < n_chars)
     {
-      PangoLayout *layout = clutter_text_get_layout (self);
+      guint locked = clutter_text_lock_async_font_maps (self);
+      PangoLayout *layout = clutter_text_get_layout_internal (self);
       PangoLogAttr *log_attrs = NULL;
       gint n_attrs = 0;
 
       pango_layout_get_log_attrs (layout, &log_attrs, &n_attrs);
+      clutter_text_unlock_async_font_maps (locked);
 
       retval = start + 1;
       while (retval < n_chars && !log_attrs[retval].is_word_end)
@@ -2056,8 +2893,11 @@ clutter_text_move_line_start (ClutterText *self,
   gint index_;
   gint position;
   const gchar *text;
+  guint locked;
+
+  locked = clutter_text_lock_async_font_maps (self);
 
-  layout = clutter_text_get_layout (self);
+  layout = clutter_text_get_layout_internal (self);
   text = clutter_text_buffer_get_text (get_buffer (self));
 
   if (start == 0)
@@ -2070,11 +2910,14 @@ clutter_text_move_line_start (ClutterText *self,
                                 &line_no, NULL);
 
   layout_line = pango_layout_get_line_readonly (layout, line_no);
+  if (layout_line)
+    pango_layout_line_x_to_index (layout_line, 0, &index_, NULL);
+
+  clutter_text_unlock_async_font_maps (locked);
+
   if (!layout_line)
     return FALSE;
 
-  pango_layout_line_x_to_index (layout_line, 0, &index_, NULL);
-
   position = bytes_to_offset (text, index_);
 
   return position;
@@ -2092,8 +2935,11 @@ clutter_text_move_line_end (ClutterText *self,
   gint trailing;
   gint position;
   const gchar *text;
+  guint locked;
 
-  layout = clutter_text_get_layout (self);
+  locked = clutter_text_lock_async_font_maps (self);
+
+  layout = clutter_text_get_layout_internal (self);
   text = clutter_text_buffer_get_text (get_buffer (self));
 
   if (start == 0)
@@ -2106,10 +2952,14 @@ clutter_text_move_line_end (ClutterText *self,
                                 &line_no, NULL);
 
   layout_line = pango_layout_get_line_readonly (layout, line_no);
+  if (layout_line)
+    pango_layout_line_x_to_index (layout_line, G_MAXINT, &index_, &trailing);
+
+  clutter_text_unlock_async_font_maps (locked);
+
   if (!layout_line)
     return FALSE;
 
-  pango_layout_line_x_to_index (layout_line, G_MAXINT, &index_, &trailing);
   index_ += trailing;
 
   position = bytes_to_offset (text, index_);
@@ -2567,6 +3417,7 @@ clutter_text_paint (ClutterActor        *self,
   float alloc_width;
   float alloc_height;
   float resource_scale;
+  guint locked;
 
   fb = clutter_paint_context_get_framebuffer (paint_context);
 
@@ -2622,6 +3473,8 @@ clutter_text_paint (ClutterActor        *self,
       !clutter_text_should_draw_cursor (text))
     return;
 
+  locked = clutter_text_lock_async_font_maps (text);
+
   resource_scale = clutter_actor_get_resource_scale (CLUTTER_ACTOR (self));
 
   clutter_actor_box_scale (&alloc, resource_scale);
@@ -2764,6 +3617,8 @@ clutter_text_paint (ClutterActor        *self,
 
   if (clip_set)
     cogl_framebuffer_pop_clip (fb);
+
+  clutter_text_unlock_async_font_maps (locked);
 }
 
 static void
@@ -2840,6 +3695,7 @@ clutter_text_get_paint_volume (ClutterActor       *self,
       PangoRectangle ink_rect;
       graphene_point3d_t origin;
       float resource_scale;
+      guint locked;
 
       /* If the text is single line editable then it gets clipped to
          the allocation anyway so we can just use that */
@@ -2858,8 +3714,10 @@ clutter_text_get_paint_volume (ClutterActor       *self,
 
       _clutter_paint_volume_init_static (&priv->paint_volume, self);
 
-      layout = clutter_text_get_layout (text);
+      locked = clutter_text_lock_async_font_maps (text);
+      layout = clutter_text_get_layout_internal (text);
       pango_layout_get_extents (layout, &ink_rect, NULL);
+      clutter_text_unlock_async_font_maps (locked);
 
       origin.x = pango_to_logical_pixels (ink_rect.x, resource_scale);
       origin.y = pango_to_logical_pixels (ink_rect.y, resource_scale);
@@ -2910,11 +3768,14 @@ clutter_text_get_preferred_width (ClutterActor *self,
   gint logical_width;
   gfloat layout_width;
   gfloat resource_scale;
+  guint locked;
 
   resource_scale = clutter_actor_get_resource_scale (self);
 
+  locked = clutter_text_lock_async_font_maps (text);
   layout = clutter_text_create_layout (text, -1, -1);
   pango_layout_get_extents (layout, NULL, &logical_rect);
+  clutter_text_unlock_async_font_maps (locked);
 
   /* the X coordinate of the logical rectangle might be non-zero
    * according to the Pango documentation; hence, we need to offset
@@ -2966,12 +3827,15 @@ clutter_text_get_preferred_height (ClutterActor *self,
       gint logical_height;
       gfloat layout_height;
       gfloat resource_scale;
+      guint locked;
 
       resource_scale = clutter_actor_get_resource_scale (self);
 
       if (priv->single_line_mode)
         for_width = -1;
 
+      locked = clutter_text_lock_async_font_maps (CLUTTER_TEXT (self));
+
       layout = create_text_layout_with_scale (CLUTTER_TEXT (self),
                                               for_width, -1, resource_scale);
 
@@ -3009,6 +3873,8 @@ clutter_text_get_preferred_height (ClutterActor *self,
 
       if (natural_height_p)
         *natural_height_p = layout_height;
+
+      clutter_text_unlock_async_font_maps (locked);
     }
 }
 
@@ -3018,6 +3884,7 @@ clutter_text_allocate (ClutterActor           *self,
 {
   ClutterText *text = CLUTTER_TEXT (self);
   ClutterActorClass *parent_class;
+  guint locked;
 
   /* Ensure that there is a cached layout with the right width so
    * that we don't need to create the text during the paint run
@@ -3026,12 +3893,14 @@ clutter_text_allocate (ClutterActor           *self,
    * to have any limit on the layout size, since the paint will clip
    * it to the allocation of the actor
    */
+  locked = clutter_text_lock_async_font_maps (text);
   if (text->priv->editable && text->priv->single_line_mode)
     clutter_text_create_layout (text, -1, -1);
   else
     maybe_create_text_layout_with_resource_scale (text,
                                                   box->x2 - box->x1,
                                                   box->y2 - box->y1);
+  clutter_text_unlock_async_font_maps (locked);
 
   parent_class = CLUTTER_ACTOR_CLASS (clutter_text_parent_class);
   parent_class->allocate (self, box);
@@ -3233,7 +4102,7 @@ clutter_text_real_move_up (ClutterText         *self,
   gint x;
   const gchar *text;
 
-  layout = clutter_text_get_layout (self);
+  layout = clutter_text_get_layout_internal (self);
   text = clutter_text_buffer_get_text (get_buffer (self));
 
   if (priv->position == 0)
@@ -3290,7 +4159,7 @@ clutter_text_real_move_down (ClutterText         *self,
   gint pos;
   const gchar *text;
 
-  layout = clutter_text_get_layout (self);
+  layout = clutter_text_get_layout_internal (self);
   text = clutter_text_buffer_get_text (get_buffer (self));
 
   if (priv->position == 0)
@@ -4348,6 +5217,22 @@ clutter_text_class_init (ClutterTextClass *klass)
   obj_props[PROP_INPUT_PURPOSE] = pspec;
   g_object_class_install_property (gobject_class, PROP_INPUT_PURPOSE, pspec);
 
+  /**
+   * ClutterText:async-layout:
+   *
+   * Whether the text should be shaped in a worker thread instead of
+   * blocking painting and layout. Until the new layout is ready, the
+   * previous one is used. Has no effect on editable text, nor once
+   * clutter_text_get_layout() has been called.
+   */
+  pspec = g_param_spec_boolean ("async-layout",
+                                P_("Asynchronous layout"),
+                                P_("Whether the text is shaped in a worker thread"),
+                                FALSE,
+                                CLUTTER_PARAM_READWRITE);
+  obj_props[PROP_ASYNC_LAYOUT] = pspec;
+  g_object_class_install_property (gobject_class, PROP_ASYNC_LAYOUT, pspec);
+
   /**
    * ClutterText::text-changed:
    * @self: the #ClutterText that emitted the signal
@@ -4967,6 +5852,13 @@ clutter_text_set_editable (ClutterText *self,
     {
       priv->editable = editable;
 
+      /* Editable text is always laid out in the main thread */
+      if (priv->editable && priv->async_font_maps_used != 0)
+        {
+          clutter_text_drop_async_layouts (self);
+          clutter_actor_queue_relayout (CLUTTER_ACTOR (self));
+        }
+
       if (method)
         {
           if (!priv->editable && clutter_input_focus_is_focused (priv->input_focus))
@@ -5742,6 +6634,18 @@ clutter_text_set_markup (ClutterText *self,
     clutter_text_buffer_set_text (get_buffer (self), "", 0);
 }
 
+/*
+ * _clutter_text_get_n_shared_layout_hits:
+ *
+ * Retrieves how many times a layout was found in the cache shared
+ * between text actors, for testing.
+ */
+guint
+_clutter_text_get_n_shared_layout_hits (void)
+{
+  return n_shared_layout_hits;
+}
+
 /**
  * clutter_text_get_layout:
  * @self: a #ClutterText
@@ -5756,21 +6660,21 @@ clutter_text_set_markup (ClutterText *self,
 PangoLayout *
 clutter_text_get_layout (ClutterText *self)
 {
-  PangoLayout *layout;
-  gfloat width, height;
-
   g_return_val_if_fail (CLUTTER_IS_TEXT (self), NULL);
 
-  if (self->priv->editable && self->priv->single_line_mode)
-    return clutter_text_create_layout (self, -1, -1);
-
-  clutter_actor_get_size (CLUTTER_ACTOR (self), &width, &height);
-  layout = maybe_create_text_layout_with_resource_scale (self, width, height);
+  /* The caller may modify the returned layout, so stop sharing layouts
+   * with other actors from now on */
+  if (!self->priv->layout_escaped)
+    {
+      self->priv->layout_escaped = TRUE;
+      clutter_text_unshare_layouts (self);
 
-  if (!layout)
-    layout = clutter_text_create_layout (self, width, height);
+      if (self->priv->async_font_maps_used != 0 ||
+          self->priv->async_job != NULL)
+        clutter_text_drop_async_layouts (self);
+    }
 
-  return layout;
+  return clutter_text_get_layout_internal (self);
 }
 
 /**
@@ -6890,6 +7794,61 @@ clutter_text_get_input_purpose (ClutterText *self)
   return self->priv->input_purpose;
 }
 
+/**
+ * clutter_text_set_async_layout:
+ * @self: a #ClutterText
+ * @async_layout: whether to shape the text in a worker thread
+ *
+ * Sets whether the text of @self should be laid out and shaped in a
+ * worker thread. While a new layout is being shaped, the previous one
+ * is painted, and once it is done a relayout is queued.
+ *
+ * This is useful for long text, where shaping could otherwise take long
+ * enough to cause frames to be dropped. It has no effect on editable
+ * text. Since the layout returned by clutter_text_get_layout() must be
+ * usable from the main thread at any time, calling it makes @self shape
+ * its text in the main thread from then on.
+ */
+void
+clutter_text_set_async_layout (ClutterText *self,
+                               gboolean     async_layout)
+{
+  ClutterTextPrivate *priv;
+
+  g_return_if_fail (CLUTTER_IS_TEXT (self));
+
+  priv = self->priv;
+
+  if (priv->async_layout == !!async_layout)
+    return;
+
+  priv->async_layout = !!async_layout;
+
+  if (!priv->async_layout)
+    {
+      clutter_text_drop_async_layouts (self);
+      clutter_actor_queue_relayout (CLUTTER_ACTOR (self));
+    }
+
+  g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_ASYNC_LAYOUT]);
+}
+
+/**
+ * clutter_text_get_async_layout:
+ * @self: a #ClutterText
+ *
+ * Retrieves whether the text of @self is shaped in a worker thread.
+ *
+ * Return value: %TRUE if the text is shaped in a worker thread
+ */
+gboolean
+clutter_text_get_async_layout (ClutterText *self)
+{
+  g_return_val_if_fail (CLUTTER_IS_TEXT (self), FALSE);
+
+  return self->priv->async_layout;
+}
+
 gboolean
 clutter_text_has_preedit (ClutterText *self)
 {
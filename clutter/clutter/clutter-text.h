@@ -316,6 +316,12 @@ ClutterInputContentPurpose clutter_text_get_input_purpose (ClutterText *self);
 CLUTTER_EXPORT
 gboolean              clutter_text_has_preedit (ClutterText *self);
 
+CLUTTER_EXPORT
+void                  clutter_text_set_async_layout (ClutterText *self,
+                                                     gboolean     async_layout);
+CLUTTER_EXPORT
+gboolean              clutter_text_get_async_layout (ClutterText *self);
+
 G_END_DECLS
 
 #endif /* __CLUTTER_TEXT_H__ */
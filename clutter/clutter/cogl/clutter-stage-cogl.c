@@ -254,9 +254,18 @@ swap_framebuffer (ClutterStageWindow *stage_window,
   ClutterStageCoglPrivate *priv =
     _clutter_stage_cogl_get_instance_private (stage_cogl);
   CoglFramebuffer *framebuffer = clutter_stage_view_get_onscreen (view);
+  int64_t flush_start_us;
+  int64_t swap_start_us;
 
   clutter_stage_view_before_swap_buffer (view, swap_region);
 
+  /* Swapping flushes the journal first thing; do that part up front so
+   * that the two can be told apart in the frame statistics. This doesn't
+   * flush the driver, so the submission itself is unchanged. */
+  flush_start_us = g_get_monotonic_time ();
+  cogl_framebuffer_flush_journal (framebuffer);
+  swap_start_us = g_get_monotonic_time ();
+
   if (cogl_is_onscreen (framebuffer))
     {
       CoglOnscreen *onscreen = COGL_ONSCREEN (framebuffer);
@@ -326,6 +335,11 @@ swap_framebuffer (ClutterStageWindow *stage_window,
                          notify_presented_idle,
                          closure, g_free);
     }
+
+  clutter_stage_view_record_swap_timings (view,
+                                          swap_start_us - flush_start_us,
+                                          g_get_monotonic_time () -
+                                          swap_start_us);
 }
 
 static cairo_region_t *
@@ -59,13 +59,16 @@ typedef struct _CoglPangoFontMapPriv
   PangoRenderer *renderer;
 } CoglPangoFontMapPriv;
 
+static CoglPangoFontMapPriv *
+_cogl_pango_font_map_get_priv (CoglPangoFontMap *fm);
+
 static void
 free_priv (gpointer data)
 {
   CoglPangoFontMapPriv *priv = data;
 
   cogl_object_unref (priv->ctx);
-  cogl_object_unref (priv->renderer);
+  g_clear_object (&priv->renderer);
 
   g_free (priv);
 }
@@ -91,6 +94,21 @@ cogl_pango_font_map_new (void)
   return fm;
 }
 
+PangoFontMap *
+cogl_pango_font_map_new_sharing_renderer (CoglPangoFontMap *fm)
+{
+  PangoFontMap *new_fm;
+  CoglPangoFontMapPriv *new_priv;
+
+  g_return_val_if_fail (COGL_PANGO_IS_FONT_MAP (fm), NULL);
+
+  new_fm = cogl_pango_font_map_new ();
+  new_priv = _cogl_pango_font_map_get_priv (COGL_PANGO_FONT_MAP (new_fm));
+  new_priv->renderer = g_object_ref (_cogl_pango_font_map_get_renderer (fm));
+
+  return new_fm;
+}
+
 PangoContext *
 cogl_pango_font_map_create_context (CoglPangoFontMap *fm)
 {
@@ -78,6 +78,20 @@ typedef PangoCairoFontMap CoglPangoFontMap;
 COGL_EXPORT PangoFontMap *
 cogl_pango_font_map_new (void);
 
+/**
+ * cogl_pango_font_map_new_sharing_renderer:
+ * @font_map: a #CoglPangoFontMap
+ *
+ * Creates a new font map rendering through the #CoglPangoRenderer, and
+ * thus the glyph cache, of @font_map. The new font map may be used to
+ * shape layouts in another thread, as long as they are rendered in the
+ * thread rendering @font_map.
+ *
+ * Return value: (transfer full): the newly created #PangoFontMap
+ */
+COGL_EXPORT PangoFontMap *
+cogl_pango_font_map_new_sharing_renderer (CoglPangoFontMap *font_map);
+
 /**
  * cogl_pango_font_map_create_context:
  * @font_map: a #CoglPangoFontMap
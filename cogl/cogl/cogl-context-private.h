@@ -205,6 +205,9 @@ struct _CoglContext
   GLint             max_texture_image_units;
   GLint             max_activateable_texture_units;
 
+  /* Cached value for GL_MAX_WINDOW_RECTANGLES_EXT */
+  GLint             max_window_rectangles;
+
   /* Fragment processing programs */
   GLuint                  current_gl_program;
 
@@ -227,6 +230,10 @@ struct _CoglContext
      same state multiple times. When the clip state is flushed this
      will hold a reference */
   CoglClipStack    *current_clip_stack;
+  /* TRUE if the flushed clip state restricts rendering using
+     GL_EXT_window_rectangles, which then needs to be reset when
+     flushing a different clip stack */
+  gboolean          current_clip_window_rectangles;
 
   /* This is used as a temporary buffer to fill a CoglBuffer when
      cogl_buffer_map fails and we only want to map to fill it with new
@@ -218,6 +218,7 @@ cogl_context_new (CoglDisplay *display,
 
   context->current_clip_stack_valid = FALSE;
   context->current_clip_stack = NULL;
+  context->current_clip_window_rectangles = FALSE;
 
   context->legacy_backface_culling_enabled = FALSE;
 
@@ -259,6 +260,7 @@ cogl_context_new (CoglDisplay *display,
 
   context->max_texture_units = -1;
   context->max_activateable_texture_units = -1;
+  context->max_window_rectangles = -1;
 
   context->current_gl_program = 0;
 
@@ -161,6 +161,12 @@ OPT (DISABLE_FAST_READ_PIXEL,
      N_("Disable read pixel optimization"),
      N_("Disable optimization for reading 1px for simple "
         "scenes of opaque rectangles"))
+OPT (DISABLE_SIMD,
+     N_("Root Cause"),
+     "disable-simd",
+     N_("Disable SIMD matrix math"),
+     N_("Use the portable implementations of matrix multiplication, "
+        "inversion and point transformation"))
 OPT (CLIPPING,
      N_("Cogl Tracing"),
      "clipping",
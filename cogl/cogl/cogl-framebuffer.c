@@ -52,6 +52,7 @@
 #include "cogl-private.h"
 #include "cogl-primitives-private.h"
 #include "cogl-gtype-private.h"
+#include "cogl-mutter.h"
 #include "winsys/cogl-winsys-private.h"
 
 extern CoglObjectClass _cogl_onscreen_class;
@@ -1407,6 +1408,14 @@ cogl_framebuffer_flush (CoglFramebuffer *framebuffer)
   ctx->driver_vtable->framebuffer_flush (framebuffer);
 }
 
+/* Submits the batched primitives of @framebuffer to the driver, like
+ * swapping buffers does, but without flushing the driver itself. */
+void
+cogl_framebuffer_flush_journal (CoglFramebuffer *framebuffer)
+{
+  _cogl_framebuffer_flush_journal (framebuffer);
+}
+
 void
 cogl_framebuffer_push_matrix (CoglFramebuffer *framebuffer)
 {
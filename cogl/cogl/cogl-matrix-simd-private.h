@@ -0,0 +1,79 @@
+/*
+ * Cogl
+ *
+ * A Low Level GPU Graphics and Utilities API
+ *
+ * Copyright (C) 2020 Red Hat Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __COGL_MATRIX_SIMD_PRIVATE_H
+#define __COGL_MATRIX_SIMD_PRIVATE_H
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/*
+ * Vectorized implementations of the hot CoglMatrix operations. All matrices
+ * are passed as arrays of 16 floats in column-major order, i.e. the layout
+ * of the public part of CoglMatrix. Any member may be NULL, in which case
+ * the portable implementation in cogl-matrix.c is used.
+ */
+typedef struct _CoglMatrixSimdFuncs
+{
+  const char *name;
+
+  /* result = a * b; result may alias a or b */
+  void (* multiply) (float       *result,
+                     const float *a,
+                     const float *b);
+
+  /* Returns FALSE if the matrix is singular */
+  gboolean (* invert) (const float *matrix,
+                       float       *inverse);
+
+  /* Same semantics as cogl_matrix_transform_points() */
+  void (* transform_points) (const float *matrix,
+                             int          n_components,
+                             size_t       stride_in,
+                             const void  *points_in,
+                             size_t       stride_out,
+                             void        *points_out,
+                             int          n_points);
+
+  /* Same semantics as cogl_matrix_project_points() */
+  void (* project_points) (const float *matrix,
+                           int          n_components,
+                           size_t       stride_in,
+                           const void  *points_in,
+                           size_t       stride_out,
+                           void        *points_out,
+                           int          n_points);
+} CoglMatrixSimdFuncs;
+
+const CoglMatrixSimdFuncs *
+_cogl_matrix_simd_get_funcs (void);
+
+G_END_DECLS
+
+#endif /* __COGL_MATRIX_SIMD_PRIVATE_H */
@@ -0,0 +1,408 @@
+/*
+ * Cogl
+ *
+ * A Low Level GPU Graphics and Utilities API
+ *
+ * Copyright (C) 2020 Red Hat Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "cogl-config.h"
+
+#include "cogl-debug.h"
+#include "cogl-matrix-simd-private.h"
+
+#include <stdint.h>
+
+#if defined (__GNUC__) && (defined (__x86_64__) || defined (__i386__))
+#define COGL_MATRIX_HAVE_SSE 1
+#include <xmmintrin.h>
+#elif defined (__ARM_NEON) || defined (__aarch64__)
+#define COGL_MATRIX_HAVE_NEON 1
+#include <arm_neon.h>
+#endif
+
+#ifdef COGL_MATRIX_HAVE_SSE
+
+/* Compiled for SSE even when the rest of Cogl targets plain i386; there, only
+ * used after checking for SSE support at runtime. */
+#define SSE_FUNC __attribute__ ((target ("sse")))
+
+static void SSE_FUNC
+sse_multiply (float       *result,
+              const float *a,
+              const float *b)
+{
+  __m128 a0 = _mm_loadu_ps (a);
+  __m128 a1 = _mm_loadu_ps (a + 4);
+  __m128 a2 = _mm_loadu_ps (a + 8);
+  __m128 a3 = _mm_loadu_ps (a + 12);
+  __m128 r[4];
+  int i;
+
+  /* Column i of the result is the linear combination of the columns of a
+   * with the elements of column i of b. */
+  for (i = 0; i < 4; i++)
+    {
+      const float *b_col = b + i * 4;
+
+      r[i] = _mm_mul_ps (a0, _mm_set1_ps (b_col[0]));
+      r[i] = _mm_add_ps (r[i], _mm_mul_ps (a1, _mm_set1_ps (b_col[1])));
+      r[i] = _mm_add_ps (r[i], _mm_mul_ps (a2, _mm_set1_ps (b_col[2])));
+      r[i] = _mm_add_ps (r[i], _mm_mul_ps (a3, _mm_set1_ps (b_col[3])));
+    }
+
+  for (i = 0; i < 4; i++)
+    _mm_storeu_ps (result + i * 4, r[i]);
+}
+
+/* 2x2 determinants a[p] * b[q] - b[p] * a[q] for four column pairs (p, q) */
+#define SSE_DET2(a, b, p, q) \
+  _mm_sub_ps (_mm_mul_ps (_mm_shuffle_ps ((a), (a), (p)), \
+                          _mm_shuffle_ps ((b), (b), (q))), \
+              _mm_mul_ps (_mm_shuffle_ps ((b), (b), (p)), \
+                          _mm_shuffle_ps ((a), (a), (q))))
+
+/* One column of the adjugate matrix, given a row of the source matrix and
+ * the 2x2 determinants of the two other rows not used as cofactors. */
+#define SSE_ADJUGATE_COLUMN(row, dx, dy, dz) \
+  _mm_add_ps (_mm_sub_ps (_mm_mul_ps (_mm_shuffle_ps ((row), (row), \
+                                                      _MM_SHUFFLE (0, 0, 0, 1)), \
+                                      (dx)), \
+                          _mm_mul_ps (_mm_shuffle_ps ((row), (row), \
+                                                      _MM_SHUFFLE (1, 1, 2, 2)), \
+                                      (dy))), \
+              _mm_mul_ps (_mm_shuffle_ps ((row), (row), \
+                                          _MM_SHUFFLE (2, 3, 3, 3)), \
+                          (dz)))
+
+static void SSE_FUNC
+sse_expand_det2 (__m128  lo,
+                 __m128  hi,
+                 __m128 *dx,
+                 __m128 *dy,
+                 __m128 *dz)
+{
+  __m128 tmp;
+
+  /* lo = (d01, d02, d03, d12), hi = (d13, d23, -, -) */
+  tmp = _mm_shuffle_ps (hi, lo, _MM_SHUFFLE (3, 3, 0, 0));
+  *dx = _mm_shuffle_ps (hi, tmp, _MM_SHUFFLE (2, 0, 1, 1));
+  tmp = _mm_shuffle_ps (hi, lo, _MM_SHUFFLE (2, 1, 0, 0));
+  *dy = _mm_shuffle_ps (tmp, tmp, _MM_SHUFFLE (2, 3, 3, 0));
+  *dz = _mm_shuffle_ps (lo, lo, _MM_SHUFFLE (0, 0, 1, 3));
+}
+
+static gboolean SSE_FUNC
+sse_invert (const float *matrix,
+            float       *inverse)
+{
+  __m128 r0 = _mm_loadu_ps (matrix);
+  __m128 r1 = _mm_loadu_ps (matrix + 4);
+  __m128 r2 = _mm_loadu_ps (matrix + 8);
+  __m128 r3 = _mm_loadu_ps (matrix + 12);
+  __m128 even_sign = _mm_set_ps (-0.0f, 0.0f, -0.0f, 0.0f);
+  __m128 odd_sign = _mm_set_ps (0.0f, -0.0f, 0.0f, -0.0f);
+  __m128 sx, sy, sz, cx, cy, cz;
+  __m128 col0, col1, col2, col3;
+  __m128 det;
+
+  /* The matrix is stored column-major; work on its rows */
+  _MM_TRANSPOSE4_PS (r0, r1, r2, r3);
+
+  sse_expand_det2 (SSE_DET2 (r0, r1,
+                             _MM_SHUFFLE (1, 0, 0, 0),
+                             _MM_SHUFFLE (2, 3, 2, 1)),
+                   SSE_DET2 (r0, r1,
+                             _MM_SHUFFLE (2, 1, 2, 1),
+                             _MM_SHUFFLE (3, 3, 3, 3)),
+                   &sx, &sy, &sz);
+  sse_expand_det2 (SSE_DET2 (r2, r3,
+                             _MM_SHUFFLE (1, 0, 0, 0),
+                             _MM_SHUFFLE (2, 3, 2, 1)),
+                   SSE_DET2 (r2, r3,
+                             _MM_SHUFFLE (2, 1, 2, 1),
+                             _MM_SHUFFLE (3, 3, 3, 3)),
+                   &cx, &cy, &cz);
+
+  col0 = _mm_xor_ps (SSE_ADJUGATE_COLUMN (r1, cx, cy, cz), even_sign);
+  col1 = _mm_xor_ps (SSE_ADJUGATE_COLUMN (r0, cx, cy, cz), odd_sign);
+  col2 = _mm_xor_ps (SSE_ADJUGATE_COLUMN (r3, sx, sy, sz), even_sign);
+  col3 = _mm_xor_ps (SSE_ADJUGATE_COLUMN (r2, sx, sy, sz), odd_sign);
+
+  /* Laplace expansion along the first row */
+  det = _mm_mul_ps (r0, col0);
+  det = _mm_add_ps (det, _mm_movehl_ps (det, det));
+  det = _mm_add_ss (det, _mm_shuffle_ps (det, det, _MM_SHUFFLE (1, 1, 1, 1)));
+
+  if (_mm_cvtss_f32 (det) == 0.0f)
+    return FALSE;
+
+  det = _mm_div_ps (_mm_set1_ps (1.0f),
+                    _mm_shuffle_ps (det, det, _MM_SHUFFLE (0, 0, 0, 0)));
+
+  _mm_storeu_ps (inverse, _mm_mul_ps (col0, det));
+  _mm_storeu_ps (inverse + 4, _mm_mul_ps (col1, det));
+  _mm_storeu_ps (inverse + 8, _mm_mul_ps (col2, det));
+  _mm_storeu_ps (inverse + 12, _mm_mul_ps (col3, det));
+
+  return TRUE;
+}
+
+static inline __m128 SSE_FUNC
+sse_transform_point (__m128       c0,
+                     __m128       c1,
+                     __m128       c2,
+                     __m128       c3,
+                     int          n_components,
+                     const float *p)
+{
+  __m128 v;
+
+  v = _mm_mul_ps (c0, _mm_set1_ps (p[0]));
+  v = _mm_add_ps (v, _mm_mul_ps (c1, _mm_set1_ps (p[1])));
+
+  if (n_components > 2)
+    v = _mm_add_ps (v, _mm_mul_ps (c2, _mm_set1_ps (p[2])));
+
+  if (n_components > 3)
+    v = _mm_add_ps (v, _mm_mul_ps (c3, _mm_set1_ps (p[3])));
+  else
+    v = _mm_add_ps (v, c3);
+
+  return v;
+}
+
+static void SSE_FUNC
+sse_transform_points (const float *matrix,
+                      int          n_components,
+                      size_t       stride_in,
+                      const void  *points_in,
+                      size_t       stride_out,
+                      void        *points_out,
+                      int          n_points)
+{
+  __m128 c0 = _mm_loadu_ps (matrix);
+  __m128 c1 = _mm_loadu_ps (matrix + 4);
+  __m128 c2 = _mm_loadu_ps (matrix + 8);
+  __m128 c3 = _mm_loadu_ps (matrix + 12);
+  int i;
+
+  for (i = 0; i < n_points; i++)
+    {
+      const float *p =
+        (const float *) ((const uint8_t *) points_in + i * stride_in);
+      float *o = (float *) ((uint8_t *) points_out + i * stride_out);
+      __m128 v;
+
+      v = sse_transform_point (c0, c1, c2, c3, n_components, p);
+
+      /* Only three components are written */
+      _mm_storel_pi ((__m64 *) o, v);
+      _mm_store_ss (o + 2, _mm_movehl_ps (v, v));
+    }
+}
+
+static void SSE_FUNC
+sse_project_points (const float *matrix,
+                    int          n_components,
+                    size_t       stride_in,
+                    const void  *points_in,
+                    size_t       stride_out,
+                    void        *points_out,
+                    int          n_points)
+{
+  __m128 c0 = _mm_loadu_ps (matrix);
+  __m128 c1 = _mm_loadu_ps (matrix + 4);
+  __m128 c2 = _mm_loadu_ps (matrix + 8);
+  __m128 c3 = _mm_loadu_ps (matrix + 12);
+  int i;
+
+  for (i = 0; i < n_points; i++)
+    {
+      const float *p =
+        (const float *) ((const uint8_t *) points_in + i * stride_in);
+      float *o = (float *) ((uint8_t *) points_out + i * stride_out);
+
+      _mm_storeu_ps (o, sse_transform_point (c0, c1, c2, c3, n_components, p));
+    }
+}
+
+static const CoglMatrixSimdFuncs sse_funcs = {
+  .name = "sse",
+  .multiply = sse_multiply,
+  .invert = sse_invert,
+  .transform_points = sse_transform_points,
+  .project_points = sse_project_points,
+};
+
+#endif /* COGL_MATRIX_HAVE_SSE */
+
+#ifdef COGL_MATRIX_HAVE_NEON
+
+static void
+neon_multiply (float       *result,
+               const float *a,
+               const float *b)
+{
+  float32x4_t a0 = vld1q_f32 (a);
+  float32x4_t a1 = vld1q_f32 (a + 4);
+  float32x4_t a2 = vld1q_f32 (a + 8);
+  float32x4_t a3 = vld1q_f32 (a + 12);
+  float32x4_t r[4];
+  int i;
+
+  for (i = 0; i < 4; i++)
+    {
+      const float *b_col = b + i * 4;
+
+      r[i] = vmulq_n_f32 (a0, b_col[0]);
+      r[i] = vaddq_f32 (r[i], vmulq_n_f32 (a1, b_col[1]));
+      r[i] = vaddq_f32 (r[i], vmulq_n_f32 (a2, b_col[2]));
+      r[i] = vaddq_f32 (r[i], vmulq_n_f32 (a3, b_col[3]));
+    }
+
+  for (i = 0; i < 4; i++)
+    vst1q_f32 (result + i * 4, r[i]);
+}
+
+static inline float32x4_t
+neon_transform_point (float32x4_t  c0,
+                      float32x4_t  c1,
+                      float32x4_t  c2,
+                      float32x4_t  c3,
+                      int          n_components,
+                      const float *p)
+{
+  float32x4_t v;
+
+  v = vmulq_n_f32 (c0, p[0]);
+  v = vaddq_f32 (v, vmulq_n_f32 (c1, p[1]));
+
+  if (n_components > 2)
+    v = vaddq_f32 (v, vmulq_n_f32 (c2, p[2]));
+
+  if (n_components > 3)
+    v = vaddq_f32 (v, vmulq_n_f32 (c3, p[3]));
+  else
+    v = vaddq_f32 (v, c3);
+
+  return v;
+}
+
+static void
+neon_transform_points (const float *matrix,
+                       int          n_components,
+                       size_t       stride_in,
+                       const void  *points_in,
+                       size_t       stride_out,
+                       void        *points_out,
+                       int          n_points)
+{
+  float32x4_t c0 = vld1q_f32 (matrix);
+  float32x4_t c1 = vld1q_f32 (matrix + 4);
+  float32x4_t c2 = vld1q_f32 (matrix + 8);
+  float32x4_t c3 = vld1q_f32 (matrix + 12);
+  int i;
+
+  for (i = 0; i < n_points; i++)
+    {
+      const float *p =
+        (const float *) ((const uint8_t *) points_in + i * stride_in);
+      float *o = (float *) ((uint8_t *) points_out + i * stride_out);
+      float32x4_t v;
+
+      v = neon_transform_point (c0, c1, c2, c3, n_components, p);
+
+      /* Only three components are written */
+      vst1_f32 (o, vget_low_f32 (v));
+      vst1q_lane_f32 (o + 2, v, 2);
+    }
+}
+
+static void
+neon_project_points (const float *matrix,
+                     int          n_components,
+                     size_t       stride_in,
+                     const void  *points_in,
+                     size_t       stride_out,
+                     void        *points_out,
+                     int          n_points)
+{
+  float32x4_t c0 = vld1q_f32 (matrix);
+  float32x4_t c1 = vld1q_f32 (matrix + 4);
+  float32x4_t c2 = vld1q_f32 (matrix + 8);
+  float32x4_t c3 = vld1q_f32 (matrix + 12);
+  int i;
+
+  for (i = 0; i < n_points; i++)
+    {
+      const float *p =
+        (const float *) ((const uint8_t *) points_in + i * stride_in);
+      float *o = (float *) ((uint8_t *) points_out + i * stride_out);
+
+      vst1q_f32 (o, neon_transform_point (c0, c1, c2, c3, n_components, p));
+    }
+}
+
+/* Inversion isn't vectorized for NEON; the portable implementation is used */
+static const CoglMatrixSimdFuncs neon_funcs = {
+  .name = "neon",
+  .multiply = neon_multiply,
+  .transform_points = neon_transform_points,
+  .project_points = neon_project_points,
+};
+
+#endif /* COGL_MATRIX_HAVE_NEON */
+
+/*
+ * Returns the vectorized matrix functions supported by the CPU we're
+ * running on, or %NULL if there are none, or if they were disabled using
+ * COGL_DEBUG=disable-simd.
+ */
+const CoglMatrixSimdFuncs *
+_cogl_matrix_simd_get_funcs (void)
+{
+  if (G_UNLIKELY (COGL_DEBUG_ENABLED (COGL_DEBUG_DISABLE_SIMD)))
+    return NULL;
+
+#if defined (COGL_MATRIX_HAVE_SSE) && (defined (__x86_64__) || defined (__SSE__))
+  /* SSE is part of the x86_64 baseline */
+  return &sse_funcs;
+#elif defined (COGL_MATRIX_HAVE_SSE)
+  static const CoglMatrixSimdFuncs *funcs = NULL;
+  static gsize funcs_initialized = 0;
+
+  if (g_once_init_enter (&funcs_initialized))
+    {
+      if (__builtin_cpu_supports ("sse"))
+        funcs = &sse_funcs;
+      g_once_init_leave (&funcs_initialized, 1);
+    }
+
+  return funcs;
+#elif defined (COGL_MATRIX_HAVE_NEON)
+  return &neon_funcs;
+#else
+  return NULL;
+#endif
+}
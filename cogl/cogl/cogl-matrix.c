@@ -75,6 +75,7 @@
 #include <cogl-debug.h>
 #include <cogl-matrix.h>
 #include <cogl-matrix-private.h>
+#include <cogl-matrix-simd-private.h>
 
 #include <glib.h>
 #include <math.h>
@@ -285,6 +286,41 @@ matrix_multiply3x4 (float *result, const float *a, const float *b)
 #undef B
 #undef R
 
+/*
+ * Multiply two matrices, using the vectorized implementation if the CPU
+ * supports one. @result may alias @a.
+ */
+static void
+matrix_multiply (float       *result,
+                 const float *a,
+                 const float *b,
+                 gboolean     is_3d)
+{
+  const CoglMatrixSimdFuncs *simd = _cogl_matrix_simd_get_funcs ();
+
+  if (simd && simd->multiply)
+    {
+      simd->multiply (result, a, b);
+
+      /* Keep the bottom row exact, as matrix_multiply3x4() does */
+      if (is_3d)
+        {
+          result[3] = 0;
+          result[7] = 0;
+          result[11] = 0;
+          result[15] = 1;
+        }
+    }
+  else if (is_3d)
+    {
+      matrix_multiply3x4 (result, a, b);
+    }
+  else
+    {
+      matrix_multiply4x4 (result, a, b);
+    }
+}
+
 /*
  * Multiply a matrix by an array of floats with known properties.
  *
@@ -294,8 +330,7 @@ matrix_multiply3x4 (float *result, const float *a, const float *b)
  * @flags flags of the matrix \p m.
  *
  * Joins both flags and marks the type and inverse as dirty.  Calls
- * matrix_multiply3x4() if both matrices are 3D, or matrix_multiply4x4()
- * otherwise.
+ * matrix_multiply() telling it whether both matrices are 3D.
  */
 static void
 matrix_multiply_array_with_flags (CoglMatrix *result,
@@ -304,15 +339,12 @@ matrix_multiply_array_with_flags (CoglMatrix *result,
 {
   result->flags |= (flags | MAT_DIRTY_TYPE | MAT_DIRTY_INVERSE);
 
-  if (TEST_MAT_FLAGS (result, MAT_FLAGS_3D))
-    matrix_multiply3x4 ((float *)result, (float *)result, array);
-  else
-    matrix_multiply4x4 ((float *)result, (float *)result, array);
+  matrix_multiply ((float *)result, (float *)result, array,
+                   TEST_MAT_FLAGS (result, MAT_FLAGS_3D));
 }
 
 /* Joins both flags and marks the type and inverse as dirty.  Calls
- * matrix_multiply3x4() if both matrices are 3D, or matrix_multiply4x4()
- * otherwise.
+ * matrix_multiply() telling it whether both matrices are 3D.
  */
 static void
 _cogl_matrix_multiply (CoglMatrix *result,
@@ -324,10 +356,8 @@ _cogl_matrix_multiply (CoglMatrix *result,
                    MAT_DIRTY_TYPE |
                    MAT_DIRTY_INVERSE);
 
-  if (TEST_MAT_FLAGS(result, MAT_FLAGS_3D))
-    matrix_multiply3x4 ((float *)result, (float *)a, (float *)b);
-  else
-    matrix_multiply4x4 ((float *)result, (float *)a, (float *)b);
+  matrix_multiply ((float *)result, (float *)a, (float *)b,
+                   TEST_MAT_FLAGS (result, MAT_FLAGS_3D));
 }
 
 void
@@ -437,17 +467,22 @@ cogl_debug_matrix_print (const CoglMatrix *matrix)
  *
  * Calculates the inverse matrix by performing the gaussian matrix reduction
  * with partial pivoting followed by back/substitution with the loops manually
- * unrolled.
+ * unrolled. If the CPU supports it, the vectorized cofactor expansion is used
+ * instead.
  */
 static gboolean
 invert_matrix_general (CoglMatrix *matrix)
 {
+  const CoglMatrixSimdFuncs *simd = _cogl_matrix_simd_get_funcs ();
   const float *m = (float *)matrix;
   float *out = matrix->inv;
   float wtmp[4][8];
   float m0, m1, m2, m3, s;
   float *r0, *r1, *r2, *r3;
 
+  if (simd && simd->invert)
+    return simd->invert (m, out);
+
   r0 = wtmp[0], r1 = wtmp[1], r2 = wtmp[2], r3 = wtmp[3];
 
   r0[0] = MAT (m, 0, 0), r0[1] = MAT (m, 0, 1),
@@ -2098,10 +2133,21 @@ cogl_matrix_transform_points (const CoglMatrix *matrix,
                               void *points_out,
                               int n_points)
 {
+  const CoglMatrixSimdFuncs *simd = _cogl_matrix_simd_get_funcs ();
+
   /* The results of transforming always have three components... */
   g_return_if_fail (stride_out >= sizeof (Point3f));
 
-  if (n_components == 2)
+  if (simd && simd->transform_points)
+    {
+      g_return_if_fail (n_components == 2 || n_components == 3);
+
+      simd->transform_points ((const float *)matrix, n_components,
+                              stride_in, points_in,
+                              stride_out, points_out,
+                              n_points);
+    }
+  else if (n_components == 2)
     _cogl_matrix_transform_points_f2 (matrix,
                                       stride_in, points_in,
                                       stride_out, points_out,
@@ -2126,7 +2172,18 @@ cogl_matrix_project_points (const CoglMatrix *matrix,
                             void *points_out,
                             int n_points)
 {
-  if (n_components == 2)
+  const CoglMatrixSimdFuncs *simd = _cogl_matrix_simd_get_funcs ();
+
+  if (simd && simd->project_points)
+    {
+      g_return_if_fail (n_components >= 2 && n_components <= 4);
+
+      simd->project_points ((const float *)matrix, n_components,
+                            stride_in, points_in,
+                            stride_out, points_out,
+                            n_points);
+    }
+  else if (n_components == 2)
     _cogl_matrix_project_points_f2 (matrix,
                                     stride_in, points_in,
                                     stride_out, points_out,
@@ -52,4 +52,7 @@ COGL_EXPORT
 gboolean cogl_context_format_supports_upload (CoglContext     *ctx,
                                               CoglPixelFormat  format);
 
+COGL_EXPORT
+void cogl_framebuffer_flush_journal (CoglFramebuffer *framebuffer);
+
 #endif /* __COGL_MUTTER_H___ */
@@ -50,6 +50,12 @@
 #define GL_CLIP_PLANE5 0x3005
 #endif
 
+#ifndef GL_INCLUSIVE_EXT
+#define GL_INCLUSIVE_EXT 0x8F10
+#define GL_EXCLUSIVE_EXT 0x8F11
+#define GL_MAX_WINDOW_RECTANGLES_EXT 0x8F14
+#endif
+
 static void
 add_stencil_clip_rectangle (CoglFramebuffer *framebuffer,
                             CoglMatrixEntry *modelview_entry,
@@ -249,6 +255,65 @@ add_stencil_clip_region (CoglFramebuffer *framebuffer,
   GE( ctx, glStencilOp (GL_KEEP, GL_KEEP, GL_KEEP) );
 }
 
+static int
+get_max_window_rectangles (CoglContext *ctx)
+{
+  if (!_cogl_has_private_feature (ctx, COGL_PRIVATE_FEATURE_WINDOW_RECTANGLES))
+    return 0;
+
+  if (G_UNLIKELY (ctx->max_window_rectangles == -1))
+    {
+      ctx->max_window_rectangles = 0;
+      GE( ctx, glGetIntegerv (GL_MAX_WINDOW_RECTANGLES_EXT,
+                              &ctx->max_window_rectangles) );
+    }
+
+  return ctx->max_window_rectangles;
+}
+
+/* Restricts rendering to the rectangles of the region using
+ * GL_EXT_window_rectangles. Like the scissor, this is applied by the
+ * rasterizer, so unlike the stencil buffer it doesn't need any clearing or
+ * drawing. Returns FALSE if the region has more rectangles than the driver
+ * supports, in which case the stencil buffer needs to be used instead.
+ */
+static gboolean
+add_window_rectangles_clip_region (CoglFramebuffer *framebuffer,
+                                   cairo_region_t  *region)
+{
+  CoglContext *ctx = cogl_framebuffer_get_context (framebuffer);
+  int num_rectangles = cairo_region_num_rectangles (region);
+  int framebuffer_height = cogl_framebuffer_get_height (framebuffer);
+  gboolean flip = !cogl_is_offscreen (framebuffer);
+  GLint *boxes;
+  int i;
+
+  if (num_rectangles > get_max_window_rectangles (ctx))
+    return FALSE;
+
+  boxes = g_alloca (sizeof (GLint) * num_rectangles * 4);
+
+  for (i = 0; i < num_rectangles; i++)
+    {
+      cairo_rectangle_int_t rect;
+      GLint *box = boxes + i * 4;
+
+      cairo_region_get_rectangle (region, i, &rect);
+
+      /* See the scissor setup in _cogl_clip_stack_gl_flush() for why
+       * only onscreen framebuffers need flipping */
+      box[0] = rect.x;
+      box[1] = flip ? framebuffer_height - (rect.y + rect.height) : rect.y;
+      box[2] = rect.width;
+      box[3] = rect.height;
+    }
+
+  GE( ctx, glWindowRectangles (GL_INCLUSIVE_EXT, num_rectangles, boxes) );
+  ctx->current_clip_window_rectangles = TRUE;
+
+  return TRUE;
+}
+
 typedef void (*SilhouettePaintCallback) (CoglFramebuffer *framebuffer,
                                          CoglPipeline *pipeline,
                                          void *user_data);
@@ -419,6 +484,13 @@ _cogl_clip_stack_gl_flush (CoglClipStack *stack,
 
   GE( ctx, glDisable (GL_STENCIL_TEST) );
 
+  if (ctx->current_clip_window_rectangles)
+    {
+      /* An empty exclusive list is the default state, i.e. no clipping */
+      GE( ctx, glWindowRectangles (GL_EXCLUSIVE_EXT, 0, NULL) );
+      ctx->current_clip_window_rectangles = FALSE;
+    }
+
   /* If the stack is empty then there's nothing else to do
    */
   if (stack == NULL)
@@ -524,9 +596,22 @@ _cogl_clip_stack_gl_flush (CoglClipStack *stack,
               CoglClipStackRegion *region = (CoglClipStackRegion *) entry;
 
               /* If nrectangles <= 1, it can be fully represented with the
-               * scissor clip.
+               * scissor clip. Otherwise try window rectangles before
+               * falling back to the stencil buffer. Only one set of window
+               * rectangles can be active, so any further region still needs
+               * the stencil buffer.
                */
-              if (cairo_region_num_rectangles (region->region) > 1)
+              if (cairo_region_num_rectangles (region->region) <= 1)
+                break;
+
+              if (!ctx->current_clip_window_rectangles &&
+                  add_window_rectangles_clip_region (framebuffer,
+                                                     region->region))
+                {
+                  COGL_NOTE (CLIPPING, "Adding window rectangles clip for "
+                             "region");
+                }
+              else
                 {
                   COGL_NOTE (CLIPPING, "Adding stencil clip for region");
 
@@ -525,6 +525,10 @@ _cogl_driver_update_features (CoglContext *ctx,
   if (ctx->glFenceSync)
     COGL_FLAGS_SET (ctx->features, COGL_FEATURE_ID_FENCE, TRUE);
 
+  if (ctx->glWindowRectangles)
+    COGL_FLAGS_SET (private_features,
+                    COGL_PRIVATE_FEATURE_WINDOW_RECTANGLES, TRUE);
+
   if (COGL_CHECK_GL_VERSION (gl_major, gl_minor, 3, 0) ||
       _cogl_check_extension ("GL_ARB_texture_rg", gl_extensions))
     COGL_FLAGS_SET (ctx->features,
@@ -232,6 +232,16 @@ COGL_EXT_FUNCTION (void, glDrawBuffers,
                    (GLsizei n, const GLenum *bufs))
 COGL_EXT_END ()
 
+COGL_EXT_BEGIN (window_rectangles, 255, 255,
+                0,
+                "EXT\0",
+                "window_rectangles\0")
+COGL_EXT_FUNCTION (void, glWindowRectangles,
+                   (GLenum mode,
+                    GLsizei count,
+                    const GLint *box))
+COGL_EXT_END ()
+
 COGL_EXT_BEGIN (robustness, 255, 255,
                 0,
                 "ARB\0",
@@ -171,6 +171,8 @@ gboolean meta_is_stage_views_scaled (void);
 
 MetaInputSettings *meta_backend_get_input_settings (MetaBackend *backend);
 
+MetaFrameStats * meta_backend_get_frame_stats (MetaBackend *backend);
+
 void meta_backend_notify_keymap_changed (MetaBackend *backend);
 
 void meta_backend_notify_keymap_layout_group_changed (MetaBackend *backend,
@@ -54,6 +54,7 @@
 #include <stdlib.h>
 
 #include "backends/meta-cursor-tracker-private.h"
+#include "backends/meta-frame-stats.h"
 #include "backends/meta-idle-monitor-private.h"
 #include "backends/meta-input-settings-private.h"
 #include "backends/meta-logical-monitor.h"
@@ -142,6 +143,8 @@ struct _MetaBackendPrivate
   MetaProfiler *profiler;
 #endif
 
+  MetaFrameStats *frame_stats;
+
 #ifdef HAVE_LIBWACOM
   WacomDeviceDatabase *wacom_db;
 #endif
@@ -233,6 +236,8 @@ meta_backend_finalize (GObject *object)
   g_clear_object (&priv->profiler);
 #endif
 
+  g_clear_object (&priv->frame_stats);
+
   G_OBJECT_CLASS (meta_backend_parent_class)->finalize (object);
 }
 
@@ -1001,6 +1006,8 @@ meta_backend_initable_init (GInitable     *initable,
   priv->profiler = meta_profiler_new ();
 #endif
 
+  priv->frame_stats = meta_frame_stats_new (backend);
+
   if (!init_clutter (backend, error))
     return FALSE;
 
@@ -1416,6 +1423,17 @@ meta_backend_get_input_settings (MetaBackend *backend)
   return priv->input_settings;
 }
 
+/**
+ * meta_backend_get_frame_stats: (skip)
+ */
+MetaFrameStats *
+meta_backend_get_frame_stats (MetaBackend *backend)
+{
+  MetaBackendPrivate *priv = meta_backend_get_instance_private (backend);
+
+  return priv->frame_stats;
+}
+
 /**
  * meta_backend_get_dnd:
  * @backend: A #MetaDnd
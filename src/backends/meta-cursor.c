@@ -37,6 +37,8 @@ enum
 
 static guint signals[LAST_SIGNAL];
 
+static unsigned int texture_serial_counter;
+
 typedef struct _MetaCursorSpritePrivate
 {
   GObject parent;
@@ -45,6 +47,7 @@ typedef struct _MetaCursorSpritePrivate
   float texture_scale;
   MetaMonitorTransform texture_transform;
   int hot_x, hot_y;
+  unsigned int texture_serial;
 } MetaCursorSpritePrivate;
 
 G_DEFINE_ABSTRACT_TYPE_WITH_PRIVATE (MetaCursorSprite,
@@ -97,6 +100,7 @@ meta_cursor_sprite_set_texture (MetaCursorSprite *sprite,
     priv->texture = cogl_object_ref (texture);
   priv->hot_x = hot_x;
   priv->hot_y = hot_y;
+  priv->texture_serial = ++texture_serial_counter;
 
   g_signal_emit (sprite, signals[TEXTURE_CHANGED], 0);
 }
@@ -130,6 +134,20 @@ meta_cursor_sprite_get_cogl_texture (MetaCursorSprite *sprite)
   return COGL_TEXTURE (priv->texture);
 }
 
+/*
+ * The texture serial is unique across all cursor sprites, and changes every
+ * time the sprite is given new texture content. It can be used to identify
+ * cached renderings of a cursor sprite without holding on to the sprite.
+ */
+unsigned int
+meta_cursor_sprite_get_texture_serial (MetaCursorSprite *sprite)
+{
+  MetaCursorSpritePrivate *priv =
+    meta_cursor_sprite_get_instance_private (sprite);
+
+  return priv->texture_serial;
+}
+
 void
 meta_cursor_sprite_get_hotspot (MetaCursorSprite *sprite,
                                 int              *hot_x,
@@ -63,6 +63,8 @@ void meta_cursor_sprite_set_texture_transform (MetaCursorSprite     *sprite,
 
 CoglTexture *meta_cursor_sprite_get_cogl_texture (MetaCursorSprite *sprite);
 
+unsigned int meta_cursor_sprite_get_texture_serial (MetaCursorSprite *sprite);
+
 void meta_cursor_sprite_get_hotspot (MetaCursorSprite *sprite,
                                      int              *hot_x,
                                      int              *hot_y);
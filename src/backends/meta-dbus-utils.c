@@ -0,0 +1,102 @@
+/* -*- mode: C; c-file-style: "gnu"; indent-tabs-mode: nil; -*- */
+/*
+ * Utilities for exporting D-Bus objects
+ *
+ * Copyright 2020 Red Hat, Inc.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "config.h"
+
+#include "backends/meta-dbus-utils.h"
+
+typedef struct _SkeletonExport
+{
+  GDBusInterfaceSkeleton *skeleton;
+  char *object_path;
+} SkeletonExport;
+
+static void
+skeleton_export_free (gpointer user_data)
+{
+  SkeletonExport *export = user_data;
+
+  g_free (export->object_path);
+  g_free (export);
+}
+
+static void
+on_bus_acquired (GDBusConnection *connection,
+                 const char      *name,
+                 gpointer         user_data)
+{
+  SkeletonExport *export = user_data;
+  g_autoptr (GError) error = NULL;
+
+  if (!g_dbus_interface_skeleton_export (export->skeleton,
+                                         connection,
+                                         export->object_path,
+                                         &error))
+    g_warning ("Failed to export %s: %s", export->object_path, error->message);
+}
+
+static void
+on_name_acquired (GDBusConnection *connection,
+                  const char      *name,
+                  gpointer         user_data)
+{
+  g_info ("Acquired name %s", name);
+}
+
+static void
+on_name_lost (GDBusConnection *connection,
+              const char      *name,
+              gpointer         user_data)
+{
+  g_warning ("Lost or failed to acquire name %s", name);
+}
+
+/**
+ * meta_dbus_own_name_for_skeleton:
+ * @skeleton: the interface skeleton to export
+ * @bus_name: the well-known name to own on the session bus
+ * @object_path: the object path to export @skeleton on
+ *
+ * Owns @bus_name and exports @skeleton on @object_path once the session
+ * bus is acquired. The caller must keep @skeleton alive until it drops the
+ * name with g_bus_unown_name().
+ *
+ * Returns: the identifier of the name ownership request
+ */
+guint
+meta_dbus_own_name_for_skeleton (GDBusInterfaceSkeleton *skeleton,
+                                 const char             *bus_name,
+                                 const char             *object_path)
+{
+  SkeletonExport *export;
+
+  export = g_new0 (SkeletonExport, 1);
+  export->skeleton = skeleton;
+  export->object_path = g_strdup (object_path);
+
+  return g_bus_own_name (G_BUS_TYPE_SESSION,
+                         bus_name,
+                         G_BUS_NAME_OWNER_FLAGS_NONE,
+                         on_bus_acquired,
+                         on_name_acquired,
+                         on_name_lost,
+                         export,
+                         skeleton_export_free);
+}
@@ -0,0 +1,290 @@
+/* -*- mode: C; c-file-style: "gnu"; indent-tabs-mode: nil; -*- */
+
+/*
+ * Copyright (C) 2020 Red Hat Inc.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "config.h"
+
+#include "backends/meta-frame-stats.h"
+
+#include "backends/meta-dbus-utils.h"
+#include "clutter/clutter-mutter.h"
+#include "meta/meta-backend.h"
+
+#include "meta-dbus-frame-stats.h"
+
+#define META_FRAME_STATS_DBUS_SERVICE "org.gnome.Mutter.FrameStats"
+#define META_FRAME_STATS_DBUS_PATH "/org/gnome/Mutter/FrameStats"
+
+#define MAX_FRAME_STATS 128
+#define LOG_INTERVAL_S 5
+
+struct _MetaFrameStats
+{
+  MetaDBusFrameStatsSkeleton parent;
+
+  MetaBackend *backend;
+
+  int dbus_name_id;
+
+  guint log_timeout_id;
+  int64_t last_log_time_us;
+};
+
+static void
+meta_frame_stats_init_iface (MetaDBusFrameStatsIface *iface);
+
+G_DEFINE_TYPE_WITH_CODE (MetaFrameStats,
+                         meta_frame_stats,
+                         META_DBUS_TYPE_FRAME_STATS_SKELETON,
+                         G_IMPLEMENT_INTERFACE (META_DBUS_TYPE_FRAME_STATS,
+                                                meta_frame_stats_init_iface))
+
+static GList *
+get_stage_views (MetaFrameStats *frame_stats)
+{
+  ClutterActor *stage = meta_backend_get_stage (frame_stats->backend);
+
+  if (!stage)
+    return NULL;
+
+  return clutter_stage_peek_stage_views (CLUTTER_STAGE (stage));
+}
+
+static char *
+get_view_name (ClutterStageView *view,
+               int               view_idx)
+{
+  char *name = NULL;
+
+  g_object_get (view, "name", &name, NULL);
+  if (!name)
+    name = g_strdup_printf ("view-%d", view_idx);
+
+  return name;
+}
+
+static gboolean
+handle_get_frame_stats (MetaDBusFrameStats    *skeleton,
+                        GDBusMethodInvocation *invocation)
+{
+  MetaFrameStats *frame_stats = META_FRAME_STATS (skeleton);
+  ClutterFrameStats stats[MAX_FRAME_STATS];
+  GVariantBuilder views_builder;
+  GList *l;
+  int view_idx = 0;
+
+  g_variant_builder_init (&views_builder, G_VARIANT_TYPE ("a(sa(xxxxxxxxx))"));
+
+  for (l = get_stage_views (frame_stats); l; l = l->next)
+    {
+      ClutterStageView *view = l->data;
+      g_autofree char *name = NULL;
+      GVariantBuilder frames_builder;
+      int n_stats;
+      int i;
+
+      name = get_view_name (view, view_idx++);
+      n_stats = clutter_stage_view_get_frame_stats (view, stats,
+                                                    MAX_FRAME_STATS);
+
+      g_variant_builder_init (&frames_builder,
+                              G_VARIANT_TYPE ("a(xxxxxxxxx)"));
+      for (i = 0; i < n_stats; i++)
+        {
+          g_variant_builder_add (&frames_builder, "(xxxxxxxxx)",
+                                 stats[i].frame_counter,
+                                 stats[i].dispatch_time_us,
+                                 stats[i].before_paint_us,
+                                 stats[i].layout_us,
+                                 stats[i].paint_us,
+                                 stats[i].pick_us,
+                                 stats[i].flush_us,
+                                 stats[i].swap_us,
+                                 stats[i].presentation_latency_us);
+        }
+
+      g_variant_builder_add (&views_builder, "(sa(xxxxxxxxx))",
+                             name, &frames_builder);
+    }
+
+  meta_dbus_frame_stats_complete_get_frame_stats (skeleton, invocation,
+                                                  g_variant_builder_end (&views_builder));
+
+  return TRUE;
+}
+
+static void
+meta_frame_stats_init_iface (MetaDBusFrameStatsIface *iface)
+{
+  iface->handle_get_frame_stats = handle_get_frame_stats;
+}
+
+static void
+log_view_frame_stats (ClutterStageView *view,
+                      const char       *name,
+                      int64_t           since_us)
+{
+  ClutterFrameStats stats[MAX_FRAME_STATS];
+  ClutterFrameStats total = { 0 };
+  ClutterFrameStats max = { 0 };
+  int n_stats;
+  int n_frames = 0;
+  int n_presented = 0;
+  int i;
+
+  n_stats = clutter_stage_view_get_frame_stats (view, stats, MAX_FRAME_STATS);
+
+  for (i = 0; i < n_stats; i++)
+    {
+      const ClutterFrameStats *frame = &stats[i];
+
+      if (frame->dispatch_time_us <= since_us)
+        continue;
+
+      n_frames++;
+
+#define ACCUMULATE(field) \
+      G_STMT_START { \
+        total.field += frame->field; \
+        max.field = MAX (max.field, frame->field); \
+      } G_STMT_END
+
+      ACCUMULATE (before_paint_us);
+      ACCUMULATE (layout_us);
+      ACCUMULATE (paint_us);
+      ACCUMULATE (pick_us);
+      ACCUMULATE (flush_us);
+      ACCUMULATE (swap_us);
+
+      if (frame->presentation_latency_us != 0)
+        {
+          ACCUMULATE (presentation_latency_us);
+          n_presented++;
+        }
+
+#undef ACCUMULATE
+    }
+
+  if (n_frames == 0)
+    return;
+
+  g_message ("Frame stats for %s: %d frames, average (max) in µs: "
+             "before-paint %" G_GINT64_FORMAT " (%" G_GINT64_FORMAT "), "
+             "layout %" G_GINT64_FORMAT " (%" G_GINT64_FORMAT "), "
+             "paint %" G_GINT64_FORMAT " (%" G_GINT64_FORMAT "), "
+             "pick %" G_GINT64_FORMAT " (%" G_GINT64_FORMAT "), "
+             "flush %" G_GINT64_FORMAT " (%" G_GINT64_FORMAT "), "
+             "swap %" G_GINT64_FORMAT " (%" G_GINT64_FORMAT "), "
+             "presentation latency %" G_GINT64_FORMAT " (%" G_GINT64_FORMAT ")",
+             name, n_frames,
+             total.before_paint_us / n_frames, max.before_paint_us,
+             total.layout_us / n_frames, max.layout_us,
+             total.paint_us / n_frames, max.paint_us,
+             total.pick_us / n_frames, max.pick_us,
+             total.flush_us / n_frames, max.flush_us,
+             total.swap_us / n_frames, max.swap_us,
+             total.presentation_latency_us / MAX (n_presented, 1),
+             max.presentation_latency_us);
+}
+
+static gboolean
+log_frame_stats (gpointer user_data)
+{
+  MetaFrameStats *frame_stats = user_data;
+  int64_t now_us = g_get_monotonic_time ();
+  GList *l;
+  int view_idx = 0;
+
+  for (l = get_stage_views (frame_stats); l; l = l->next)
+    {
+      ClutterStageView *view = l->data;
+      g_autofree char *name = NULL;
+
+      name = get_view_name (view, view_idx++);
+      log_view_frame_stats (view, name, frame_stats->last_log_time_us);
+    }
+
+  frame_stats->last_log_time_us = now_us;
+
+  return G_SOURCE_CONTINUE;
+}
+
+void
+meta_frame_stats_start_logging (MetaFrameStats *frame_stats)
+{
+  if (frame_stats->log_timeout_id)
+    return;
+
+  frame_stats->last_log_time_us = g_get_monotonic_time ();
+  frame_stats->log_timeout_id = g_timeout_add_seconds (LOG_INTERVAL_S,
+                                                       log_frame_stats,
+                                                       frame_stats);
+  g_source_set_name_by_id (frame_stats->log_timeout_id,
+                           "[mutter] log_frame_stats");
+}
+
+static void
+meta_frame_stats_constructed (GObject *object)
+{
+  MetaFrameStats *frame_stats = META_FRAME_STATS (object);
+
+  frame_stats->dbus_name_id =
+    meta_dbus_own_name_for_skeleton (G_DBUS_INTERFACE_SKELETON (frame_stats),
+                                     META_FRAME_STATS_DBUS_SERVICE,
+                                     META_FRAME_STATS_DBUS_PATH);
+
+  G_OBJECT_CLASS (meta_frame_stats_parent_class)->constructed (object);
+}
+
+static void
+meta_frame_stats_finalize (GObject *object)
+{
+  MetaFrameStats *frame_stats = META_FRAME_STATS (object);
+
+  if (frame_stats->dbus_name_id != 0)
+    g_bus_unown_name (frame_stats->dbus_name_id);
+
+  g_clear_handle_id (&frame_stats->log_timeout_id, g_source_remove);
+
+  G_OBJECT_CLASS (meta_frame_stats_parent_class)->finalize (object);
+}
+
+MetaFrameStats *
+meta_frame_stats_new (MetaBackend *backend)
+{
+  MetaFrameStats *frame_stats;
+
+  frame_stats = g_object_new (META_TYPE_FRAME_STATS, NULL);
+  frame_stats->backend = backend;
+
+  return frame_stats;
+}
+
+static void
+meta_frame_stats_init (MetaFrameStats *frame_stats)
+{
+}
+
+static void
+meta_frame_stats_class_init (MetaFrameStatsClass *klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+
+  object_class->constructed = meta_frame_stats_constructed;
+  object_class->finalize = meta_frame_stats_finalize;
+}
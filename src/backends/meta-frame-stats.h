@@ -0,0 +1,38 @@
+/* -*- mode: C; c-file-style: "gnu"; indent-tabs-mode: nil; -*- */
+
+/*
+ * Copyright (C) 2020 Red Hat Inc.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef META_FRAME_STATS_H
+#define META_FRAME_STATS_H
+
+#include <glib-object.h>
+
+#include "backends/meta-backend-types.h"
+
+#include "meta-dbus-frame-stats.h"
+
+#define META_TYPE_FRAME_STATS (meta_frame_stats_get_type ())
+G_DECLARE_FINAL_TYPE (MetaFrameStats, meta_frame_stats,
+                      META, FRAME_STATS,
+                      MetaDBusFrameStatsSkeleton)
+
+void meta_frame_stats_start_logging (MetaFrameStats *frame_stats);
+
+MetaFrameStats * meta_frame_stats_new (MetaBackend *backend);
+
+#endif /* META_FRAME_STATS_H */
@@ -44,6 +44,36 @@ enum _MetaRemoteDesktopNotifyAxisFlags
   META_REMOTE_DESKTOP_NOTIFY_AXIS_FLAGS_FINISH = 1 << 0,
 } MetaRemoteDesktopNotifyAxisFlags;
 
+typedef enum _MetaRemoteDesktopInputEventType
+{
+  META_REMOTE_DESKTOP_INPUT_EVENT_KEYBOARD_KEYCODE = 0,
+  META_REMOTE_DESKTOP_INPUT_EVENT_KEYBOARD_KEYSYM = 1,
+  META_REMOTE_DESKTOP_INPUT_EVENT_POINTER_BUTTON = 2,
+  META_REMOTE_DESKTOP_INPUT_EVENT_POINTER_AXIS = 3,
+  META_REMOTE_DESKTOP_INPUT_EVENT_POINTER_AXIS_DISCRETE = 4,
+  META_REMOTE_DESKTOP_INPUT_EVENT_POINTER_MOTION_RELATIVE = 5,
+  META_REMOTE_DESKTOP_INPUT_EVENT_POINTER_MOTION_ABSOLUTE = 6,
+  META_REMOTE_DESKTOP_INPUT_EVENT_TOUCH_DOWN = 7,
+  META_REMOTE_DESKTOP_INPUT_EVENT_TOUCH_MOTION = 8,
+  META_REMOTE_DESKTOP_INPUT_EVENT_TOUCH_UP = 9,
+} MetaRemoteDesktopInputEventType;
+
+typedef struct _MetaRemoteDesktopInputEvent
+{
+  MetaRemoteDesktopInputEventType type;
+  uint64_t time_us;
+
+  /* Keycode, keysym, button, axis or touch slot */
+  uint32_t code;
+  gboolean pressed;
+  int steps;
+  uint32_t flags;
+
+  /* Relative motion, axis delta or (already transformed) position */
+  double x;
+  double y;
+} MetaRemoteDesktopInputEvent;
+
 struct _MetaRemoteDesktopSession
 {
   MetaDBusRemoteDesktopSessionSkeleton parent;
@@ -727,6 +757,303 @@ handle_notify_touch_up (MetaDBusRemoteDesktopSession *skeleton,
   return TRUE;
 }
 
+static gboolean
+transform_stream_position (MetaRemoteDesktopSession  *session,
+                           const char                *stream_path,
+                           double                     x,
+                           double                     y,
+                           double                    *abs_x,
+                           double                    *abs_y,
+                           GError                   **error)
+{
+  MetaScreenCastStream *stream;
+
+  if (!session->screen_cast_session)
+    {
+      g_set_error (error, G_IO_ERROR, G_IO_ERROR_FAILED,
+                   "No screen cast active");
+      return FALSE;
+    }
+
+  stream = meta_screen_cast_session_get_stream (session->screen_cast_session,
+                                                stream_path);
+  if (!stream)
+    {
+      g_set_error (error, G_IO_ERROR, G_IO_ERROR_FAILED,
+                   "Unknown stream");
+      return FALSE;
+    }
+
+  meta_screen_cast_stream_transform_position (stream, x, y, abs_x, abs_y);
+  return TRUE;
+}
+
+static gboolean
+parse_input_event (MetaRemoteDesktopSession     *session,
+                   GVariant                     *event_variant,
+                   uint64_t                      now_us,
+                   MetaRemoteDesktopInputEvent  *event,
+                   GError                      **error)
+{
+  g_autoptr (GVariant) args = NULL;
+  const char *stream_path;
+  const char *expected_type;
+  uint32_t type;
+  uint64_t time_us;
+  double x, y;
+
+  g_variant_get (event_variant, "(tuv)", &time_us, &type, &args);
+
+  *event = (MetaRemoteDesktopInputEvent) { 0 };
+  event->type = type;
+
+  /*
+   * Timestamps are in the CLOCK_MONOTONIC time base, in microseconds. Zero
+   * means the event has no timestamp, and will be given the current time.
+   * Timestamps from the future are clamped to the current time, so that
+   * they can't confuse gesture and velocity tracking.
+   */
+  event->time_us = MIN (time_us, now_us);
+
+  switch (type)
+    {
+    case META_REMOTE_DESKTOP_INPUT_EVENT_KEYBOARD_KEYCODE:
+    case META_REMOTE_DESKTOP_INPUT_EVENT_KEYBOARD_KEYSYM:
+      expected_type = "(ub)";
+      break;
+    case META_REMOTE_DESKTOP_INPUT_EVENT_POINTER_BUTTON:
+      expected_type = "(ib)";
+      break;
+    case META_REMOTE_DESKTOP_INPUT_EVENT_POINTER_AXIS:
+      expected_type = "(ddu)";
+      break;
+    case META_REMOTE_DESKTOP_INPUT_EVENT_POINTER_AXIS_DISCRETE:
+      expected_type = "(ui)";
+      break;
+    case META_REMOTE_DESKTOP_INPUT_EVENT_POINTER_MOTION_RELATIVE:
+      expected_type = "(dd)";
+      break;
+    case META_REMOTE_DESKTOP_INPUT_EVENT_POINTER_MOTION_ABSOLUTE:
+      expected_type = "(sdd)";
+      break;
+    case META_REMOTE_DESKTOP_INPUT_EVENT_TOUCH_DOWN:
+    case META_REMOTE_DESKTOP_INPUT_EVENT_TOUCH_MOTION:
+      expected_type = "(sudd)";
+      break;
+    case META_REMOTE_DESKTOP_INPUT_EVENT_TOUCH_UP:
+      expected_type = "(u)";
+      break;
+    default:
+      g_set_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_ARGUMENT,
+                   "Unknown input event type %u", type);
+      return FALSE;
+    }
+
+  if (!g_variant_is_of_type (args, G_VARIANT_TYPE (expected_type)))
+    {
+      g_set_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_ARGUMENT,
+                   "Invalid arguments '%s' for input event type %u, "
+                   "expected '%s'",
+                   g_variant_get_type_string (args), type, expected_type);
+      return FALSE;
+    }
+
+  switch (type)
+    {
+    case META_REMOTE_DESKTOP_INPUT_EVENT_KEYBOARD_KEYCODE:
+    case META_REMOTE_DESKTOP_INPUT_EVENT_KEYBOARD_KEYSYM:
+      g_variant_get (args, "(ub)", &event->code, &event->pressed);
+      return TRUE;
+    case META_REMOTE_DESKTOP_INPUT_EVENT_POINTER_BUTTON:
+      {
+        int button_code;
+
+        g_variant_get (args, "(ib)", &button_code, &event->pressed);
+        event->code = translate_to_clutter_button (button_code);
+        return TRUE;
+      }
+    case META_REMOTE_DESKTOP_INPUT_EVENT_POINTER_AXIS:
+      g_variant_get (args, "(ddu)", &event->x, &event->y, &event->flags);
+      return TRUE;
+    case META_REMOTE_DESKTOP_INPUT_EVENT_POINTER_AXIS_DISCRETE:
+      g_variant_get (args, "(ui)", &event->code, &event->steps);
+      if (event->code > 1)
+        {
+          g_set_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_ARGUMENT,
+                       "Invalid axis value");
+          return FALSE;
+        }
+      if (event->steps == 0)
+        {
+          g_set_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_ARGUMENT,
+                       "Invalid axis steps value");
+          return FALSE;
+        }
+      return TRUE;
+    case META_REMOTE_DESKTOP_INPUT_EVENT_POINTER_MOTION_RELATIVE:
+      g_variant_get (args, "(dd)", &event->x, &event->y);
+      return TRUE;
+    case META_REMOTE_DESKTOP_INPUT_EVENT_POINTER_MOTION_ABSOLUTE:
+      g_variant_get (args, "(&sdd)", &stream_path, &x, &y);
+      return transform_stream_position (session, stream_path, x, y,
+                                        &event->x, &event->y,
+                                        error);
+    case META_REMOTE_DESKTOP_INPUT_EVENT_TOUCH_DOWN:
+    case META_REMOTE_DESKTOP_INPUT_EVENT_TOUCH_MOTION:
+      g_variant_get (args, "(&sudd)", &stream_path, &event->code, &x, &y);
+      return transform_stream_position (session, stream_path, x, y,
+                                        &event->x, &event->y,
+                                        error);
+    case META_REMOTE_DESKTOP_INPUT_EVENT_TOUCH_UP:
+      g_variant_get (args, "(u)", &event->code);
+      return TRUE;
+    }
+
+  g_assert_not_reached ();
+}
+
+static void
+inject_input_event (MetaRemoteDesktopSession          *session,
+                    const MetaRemoteDesktopInputEvent *event)
+{
+  switch (event->type)
+    {
+    case META_REMOTE_DESKTOP_INPUT_EVENT_KEYBOARD_KEYCODE:
+      clutter_virtual_input_device_notify_key (session->virtual_keyboard,
+                                               event->time_us,
+                                               event->code,
+                                               (event->pressed ?
+                                                CLUTTER_KEY_STATE_PRESSED :
+                                                CLUTTER_KEY_STATE_RELEASED));
+      return;
+    case META_REMOTE_DESKTOP_INPUT_EVENT_KEYBOARD_KEYSYM:
+      clutter_virtual_input_device_notify_keyval (session->virtual_keyboard,
+                                                  event->time_us,
+                                                  event->code,
+                                                  (event->pressed ?
+                                                   CLUTTER_KEY_STATE_PRESSED :
+                                                   CLUTTER_KEY_STATE_RELEASED));
+      return;
+    case META_REMOTE_DESKTOP_INPUT_EVENT_POINTER_BUTTON:
+      clutter_virtual_input_device_notify_button (session->virtual_pointer,
+                                                  event->time_us,
+                                                  event->code,
+                                                  (event->pressed ?
+                                                   CLUTTER_BUTTON_STATE_PRESSED :
+                                                   CLUTTER_BUTTON_STATE_RELEASED));
+      return;
+    case META_REMOTE_DESKTOP_INPUT_EVENT_POINTER_AXIS:
+      {
+        ClutterScrollFinishFlags finish_flags = CLUTTER_SCROLL_FINISHED_NONE;
+
+        if (event->flags & META_REMOTE_DESKTOP_NOTIFY_AXIS_FLAGS_FINISH)
+          {
+            finish_flags |= (CLUTTER_SCROLL_FINISHED_HORIZONTAL |
+                             CLUTTER_SCROLL_FINISHED_VERTICAL);
+          }
+
+        clutter_virtual_input_device_notify_scroll_continuous (session->virtual_pointer,
+                                                               event->time_us,
+                                                               event->x, event->y,
+                                                               CLUTTER_SCROLL_SOURCE_FINGER,
+                                                               finish_flags);
+        return;
+      }
+    case META_REMOTE_DESKTOP_INPUT_EVENT_POINTER_AXIS_DISCRETE:
+      {
+        ClutterScrollDirection direction;
+        int step_count;
+
+        direction = discrete_steps_to_scroll_direction (event->code,
+                                                        event->steps);
+
+        for (step_count = 0; step_count < abs (event->steps); step_count++)
+          clutter_virtual_input_device_notify_discrete_scroll (session->virtual_pointer,
+                                                               event->time_us,
+                                                               direction,
+                                                               CLUTTER_SCROLL_SOURCE_WHEEL);
+        return;
+      }
+    case META_REMOTE_DESKTOP_INPUT_EVENT_POINTER_MOTION_RELATIVE:
+      clutter_virtual_input_device_notify_relative_motion (session->virtual_pointer,
+                                                           event->time_us,
+                                                           event->x, event->y);
+      return;
+    case META_REMOTE_DESKTOP_INPUT_EVENT_POINTER_MOTION_ABSOLUTE:
+      clutter_virtual_input_device_notify_absolute_motion (session->virtual_pointer,
+                                                           event->time_us,
+                                                           event->x, event->y);
+      return;
+    case META_REMOTE_DESKTOP_INPUT_EVENT_TOUCH_DOWN:
+      clutter_virtual_input_device_notify_touch_down (session->virtual_touchscreen,
+                                                      event->time_us,
+                                                      event->code,
+                                                      event->x, event->y);
+      return;
+    case META_REMOTE_DESKTOP_INPUT_EVENT_TOUCH_MOTION:
+      clutter_virtual_input_device_notify_touch_motion (session->virtual_touchscreen,
+                                                        event->time_us,
+                                                        event->code,
+                                                        event->x, event->y);
+      return;
+    case META_REMOTE_DESKTOP_INPUT_EVENT_TOUCH_UP:
+      clutter_virtual_input_device_notify_touch_up (session->virtual_touchscreen,
+                                                    event->time_us,
+                                                    event->code);
+      return;
+    }
+
+  g_assert_not_reached ();
+}
+
+static gboolean
+handle_notify_input_batch (MetaDBusRemoteDesktopSession *skeleton,
+                           GDBusMethodInvocation        *invocation,
+                           GVariant                     *events_variant)
+{
+  MetaRemoteDesktopSession *session = META_REMOTE_DESKTOP_SESSION (skeleton);
+  g_autofree MetaRemoteDesktopInputEvent *events = NULL;
+  uint64_t now_us;
+  size_t n_events;
+  size_t i;
+
+  if (!meta_remote_desktop_session_check_can_notify (session, invocation))
+    return TRUE;
+
+  now_us = g_get_monotonic_time ();
+  n_events = g_variant_n_children (events_variant);
+  events = g_new0 (MetaRemoteDesktopInputEvent, n_events);
+
+  /*
+   * Validate the whole batch before injecting anything, so that a malformed
+   * batch doesn't leave e.g. a button or key half way pressed.
+   */
+  for (i = 0; i < n_events; i++)
+    {
+      g_autoptr (GVariant) event_variant = NULL;
+      g_autoptr (GError) error = NULL;
+
+      event_variant = g_variant_get_child_value (events_variant, i);
+      if (!parse_input_event (session, event_variant, now_us,
+                              &events[i], &error))
+        {
+          g_dbus_method_invocation_return_error (invocation, G_DBUS_ERROR,
+                                                 G_DBUS_ERROR_INVALID_ARGS,
+                                                 "Invalid input event %zu: %s",
+                                                 i, error->message);
+          return TRUE;
+        }
+    }
+
+  for (i = 0; i < n_events; i++)
+    inject_input_event (session, &events[i]);
+
+  meta_dbus_remote_desktop_session_complete_notify_input_batch (skeleton,
+                                                                invocation);
+
+  return TRUE;
+}
+
 static void
 meta_remote_desktop_session_init_iface (MetaDBusRemoteDesktopSessionIface *iface)
 {
@@ -742,6 +1069,7 @@ meta_remote_desktop_session_init_iface (MetaDBusRemoteDesktopSessionIface *iface
   iface->handle_notify_touch_down = handle_notify_touch_down;
   iface->handle_notify_touch_motion = handle_notify_touch_motion;
   iface->handle_notify_touch_up = handle_notify_touch_up;
+  iface->handle_notify_input_batch = handle_notify_input_batch;
 }
 
 static void
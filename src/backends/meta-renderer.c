@@ -64,6 +64,7 @@ typedef struct _MetaRendererPrivate
 {
   MetaBackend *backend;
   GList *views;
+  GList *virtual_views;
   gboolean is_paused;
 } MetaRendererPrivate;
 
@@ -143,8 +144,14 @@ meta_renderer_real_rebuild_views (MetaRenderer *renderer)
     meta_backend_get_monitor_manager (backend);
   GList *logical_monitors, *l;
 
-  g_list_free_full (priv->views, (GDestroyNotify) clutter_stage_view_destroy);
-  priv->views = NULL;
+  for (l = priv->views; l; l = l->next)
+    {
+      ClutterStageView *stage_view = l->data;
+
+      if (!g_list_find (priv->virtual_views, stage_view))
+        clutter_stage_view_destroy (stage_view);
+    }
+  g_clear_pointer (&priv->views, g_list_free);
 
   logical_monitors =
     meta_monitor_manager_get_logical_monitors (monitor_manager);
@@ -170,6 +177,10 @@ meta_renderer_real_rebuild_views (MetaRenderer *renderer)
                                          create_crtc_view,
                                          renderer);
     }
+
+  /* Virtual views are not tied to any monitor, thus outlive the rebuild. */
+  for (l = priv->virtual_views; l; l = l->next)
+    priv->views = g_list_append (priv->views, l->data);
 }
 
 static MetaRendererView *
@@ -258,6 +269,146 @@ meta_renderer_add_view (MetaRenderer     *renderer,
     }
 }
 
+/**
+ * meta_renderer_place_virtual_view:
+ * @renderer: a #MetaRenderer object
+ * @layout: (inout): the layout of a virtual view to be added
+ *
+ * Moves @layout to the right of the monitors and the other virtual views,
+ * keeping its size, so that it can be added without overlapping them.
+ */
+void
+meta_renderer_place_virtual_view (MetaRenderer  *renderer,
+                                  MetaRectangle *layout)
+{
+  MetaRendererPrivate *priv = meta_renderer_get_instance_private (renderer);
+  GList *l;
+
+  layout->x = 0;
+  layout->y = 0;
+
+  for (l = priv->views; l; l = l->next)
+    {
+      MetaRectangle view_layout;
+
+      clutter_stage_view_get_layout (CLUTTER_STAGE_VIEW (l->data),
+                                     &view_layout);
+      layout->x = MAX (layout->x, view_layout.x + view_layout.width);
+    }
+}
+
+/**
+ * meta_renderer_add_virtual_view:
+ * @renderer: a #MetaRenderer object
+ * @layout: the area of the stage the view covers
+ * @refresh_rate: the refresh rate of the view frame clock
+ * @error: return location for a #GError
+ *
+ * Creates a view that is not backed by any monitor, rendering @layout into an
+ * offscreen framebuffer. Like any other view it has its own frame clock, thus
+ * is only painted when the stage content it covers is damaged.
+ *
+ * @layout must not overlap any monitor or other virtual view, so that actors
+ * keep being assigned to the views of the monitors they are on; see
+ * meta_renderer_place_virtual_view().
+ *
+ * Returns: (transfer none): the new view, or %NULL on failure.
+ */
+MetaRendererView *
+meta_renderer_add_virtual_view (MetaRenderer         *renderer,
+                                const MetaRectangle  *layout,
+                                float                 refresh_rate,
+                                GError              **error)
+{
+  MetaRendererPrivate *priv = meta_renderer_get_instance_private (renderer);
+  MetaBackend *backend = priv->backend;
+  ClutterBackend *clutter_backend = meta_backend_get_clutter_backend (backend);
+  CoglContext *cogl_context =
+    clutter_backend_get_cogl_context (clutter_backend);
+  ClutterActor *stage = meta_backend_get_stage (backend);
+  CoglTexture2D *texture;
+  CoglOffscreen *offscreen;
+  MetaRendererView *view;
+  GList *l;
+
+  for (l = priv->views; l; l = l->next)
+    {
+      MetaRectangle view_layout;
+
+      clutter_stage_view_get_layout (CLUTTER_STAGE_VIEW (l->data),
+                                     &view_layout);
+      if (meta_rectangle_overlap (layout, &view_layout))
+        {
+          g_set_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_ARGUMENT,
+                       "Virtual view %dx%d+%d+%d overlaps another view",
+                       layout->width, layout->height,
+                       layout->x, layout->y);
+          return NULL;
+        }
+    }
+
+  texture = cogl_texture_2d_new_with_size (cogl_context,
+                                           layout->width,
+                                           layout->height);
+  offscreen = cogl_offscreen_new_with_texture (COGL_TEXTURE (texture));
+  cogl_object_unref (texture);
+
+  if (!cogl_framebuffer_allocate (COGL_FRAMEBUFFER (offscreen), error))
+    {
+      cogl_object_unref (offscreen);
+      return NULL;
+    }
+
+  view = g_object_new (META_TYPE_RENDERER_VIEW,
+                       "name", "virtual",
+                       "stage", stage,
+                       "layout", layout,
+                       "refresh-rate", refresh_rate,
+                       "framebuffer", COGL_FRAMEBUFFER (offscreen),
+                       NULL);
+  cogl_object_unref (offscreen);
+
+  priv->virtual_views = g_list_append (priv->virtual_views, view);
+  meta_renderer_add_view (renderer, view);
+
+  clutter_stage_clear_stage_views (CLUTTER_STAGE (stage));
+  clutter_actor_queue_redraw_with_clip (stage, layout);
+
+  return view;
+}
+
+/**
+ * meta_renderer_remove_virtual_view:
+ * @renderer: a #MetaRenderer object
+ * @view: a view created with meta_renderer_add_virtual_view()
+ *
+ * Removes and destroys a virtual view.
+ */
+void
+meta_renderer_remove_virtual_view (MetaRenderer     *renderer,
+                                   MetaRendererView *view)
+{
+  MetaRendererPrivate *priv = meta_renderer_get_instance_private (renderer);
+  ClutterActor *stage = meta_backend_get_stage (priv->backend);
+
+  g_return_if_fail (g_list_find (priv->virtual_views, view));
+
+  priv->virtual_views = g_list_remove (priv->virtual_views, view);
+  priv->views = g_list_remove (priv->views, view);
+  clutter_stage_view_destroy (CLUTTER_STAGE_VIEW (view));
+
+  clutter_stage_clear_stage_views (CLUTTER_STAGE (stage));
+}
+
+gboolean
+meta_renderer_is_virtual_view (MetaRenderer     *renderer,
+                               MetaRendererView *view)
+{
+  MetaRendererPrivate *priv = meta_renderer_get_instance_private (renderer);
+
+  return !!g_list_find (priv->virtual_views, view);
+}
+
 /**
  * meta_renderer_get_views:
  * @renderer: a #MetaRenderer object
@@ -374,6 +525,7 @@ meta_renderer_finalize (GObject *object)
 
   g_list_free_full (priv->views, g_object_unref);
   priv->views = NULL;
+  g_clear_pointer (&priv->virtual_views, g_list_free);
 
   G_OBJECT_CLASS (meta_renderer_parent_class)->finalize (object);
 }
@@ -62,6 +62,23 @@ void meta_renderer_add_view (MetaRenderer     *renderer,
 GList * meta_renderer_get_views_for_monitor (MetaRenderer *renderer,
                                              MetaMonitor  *monitor);
 
+META_EXPORT_TEST
+void meta_renderer_place_virtual_view (MetaRenderer  *renderer,
+                                       MetaRectangle *layout);
+
+META_EXPORT_TEST
+MetaRendererView * meta_renderer_add_virtual_view (MetaRenderer         *renderer,
+                                                   const MetaRectangle  *layout,
+                                                   float                 refresh_rate,
+                                                   GError              **error);
+
+META_EXPORT_TEST
+void meta_renderer_remove_virtual_view (MetaRenderer     *renderer,
+                                        MetaRendererView *view);
+
+gboolean meta_renderer_is_virtual_view (MetaRenderer     *renderer,
+                                        MetaRendererView *view);
+
 META_EXPORT_TEST
 GList * meta_renderer_get_views (MetaRenderer *renderer);
 
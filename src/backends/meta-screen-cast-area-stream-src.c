@@ -37,7 +37,6 @@ struct _MetaScreenCastAreaStreamSrc
 {
   MetaScreenCastStreamSrc parent;
 
-  gboolean cursor_bitmap_invalid;
   gboolean hw_cursor_inhibited;
 
   GList *watches;
@@ -112,7 +111,7 @@ meta_screen_cast_area_stream_src_get_specs (MetaScreenCastStreamSrc *src,
 
   *width = (int) roundf (area->width * scale);
   *height = (int) roundf (area->height * scale);
-  *frame_rate = 60.0;
+  *frame_rate = meta_screen_cast_area_stream_get_refresh_rate (area_stream);
 }
 
 static gboolean
@@ -192,7 +191,6 @@ static void
 cursor_changed (MetaCursorTracker           *cursor_tracker,
                 MetaScreenCastAreaStreamSrc *area_src)
 {
-  area_src->cursor_bitmap_invalid = TRUE;
   sync_cursor_state (area_src);
 }
 
@@ -286,6 +284,7 @@ add_view_painted_watches (MetaScreenCastAreaStreamSrc *area_src,
   MetaScreenCastAreaStream *area_stream = META_SCREEN_CAST_AREA_STREAM (stream);
   MetaBackend *backend = get_backend (area_src);
   MetaRenderer *renderer = meta_backend_get_renderer (backend);
+  MetaRendererView *virtual_view;
   ClutterStage *stage;
   MetaStage *meta_stage;
   MetaRectangle *area;
@@ -294,12 +293,17 @@ add_view_painted_watches (MetaScreenCastAreaStreamSrc *area_src,
   stage = get_stage (area_src);
   meta_stage = META_STAGE (stage);
   area = meta_screen_cast_area_stream_get_area (area_stream);
+  virtual_view = meta_screen_cast_area_stream_get_virtual_view (area_stream);
 
   for (l = meta_renderer_get_views (renderer); l; l = l->next)
     {
       MetaRendererView *view = l->data;
       MetaRectangle view_layout;
 
+      /* Virtual streams are recorded from their own view only */
+      if (virtual_view && view != virtual_view)
+        continue;
+
       clutter_stage_view_get_layout (CLUTTER_STAGE_VIEW (view), &view_layout);
       if (meta_rectangle_overlap (area, &view_layout))
         {
@@ -422,6 +426,39 @@ meta_screen_cast_area_stream_src_disable (MetaScreenCastStreamSrc *src)
     }
 }
 
+/*
+ * The virtual view of a virtual stream covers exactly the area of the
+ * stream, so its framebuffer already holds the frame; there is no need to
+ * paint the area again.
+ */
+static void
+read_virtual_view_into (MetaScreenCastAreaStreamSrc *area_src,
+                        MetaRendererView            *virtual_view,
+                        uint8_t                     *data,
+                        int                          stride)
+{
+  MetaBackend *backend = get_backend (area_src);
+  ClutterBackend *clutter_backend = meta_backend_get_clutter_backend (backend);
+  CoglContext *cogl_context =
+    clutter_backend_get_cogl_context (clutter_backend);
+  CoglFramebuffer *view_framebuffer;
+  CoglBitmap *bitmap;
+
+  view_framebuffer =
+    clutter_stage_view_get_framebuffer (CLUTTER_STAGE_VIEW (virtual_view));
+  bitmap = cogl_bitmap_new_for_data (cogl_context,
+                                     cogl_framebuffer_get_width (view_framebuffer),
+                                     cogl_framebuffer_get_height (view_framebuffer),
+                                     CLUTTER_CAIRO_FORMAT_ARGB32,
+                                     stride,
+                                     data);
+  cogl_framebuffer_read_pixels_into_bitmap (view_framebuffer,
+                                            0, 0,
+                                            COGL_READ_PIXELS_COLOR_BUFFER,
+                                            bitmap);
+  cogl_object_unref (bitmap);
+}
+
 static gboolean
 meta_screen_cast_area_stream_src_record_to_buffer (MetaScreenCastStreamSrc  *src,
                                                    uint8_t                  *data,
@@ -431,6 +468,7 @@ meta_screen_cast_area_stream_src_record_to_buffer (MetaScreenCastStreamSrc  *src
     META_SCREEN_CAST_AREA_STREAM_SRC (src);
   MetaScreenCastStream *stream = meta_screen_cast_stream_src_get_stream (src);
   MetaScreenCastAreaStream *area_stream = META_SCREEN_CAST_AREA_STREAM (stream);
+  MetaRendererView *virtual_view;
   ClutterStage *stage;
   MetaRectangle *area;
   float scale;
@@ -442,6 +480,13 @@ meta_screen_cast_area_stream_src_record_to_buffer (MetaScreenCastStreamSrc  *src
   scale = meta_screen_cast_area_stream_get_scale (area_stream);
   stride = meta_screen_cast_stream_src_get_stride (src);
 
+  virtual_view = meta_screen_cast_area_stream_get_virtual_view (area_stream);
+  if (virtual_view)
+    {
+      read_virtual_view_into (area_src, virtual_view, data, stride);
+      return TRUE;
+    }
+
   switch (meta_screen_cast_stream_get_cursor_mode (stream))
     {
     case META_SCREEN_CAST_CURSOR_MODE_METADATA:
@@ -474,11 +519,32 @@ meta_screen_cast_area_stream_src_record_to_framebuffer (MetaScreenCastStreamSrc
   MetaScreenCastStream *stream = meta_screen_cast_stream_src_get_stream (src);
   MetaScreenCastAreaStream *area_stream = META_SCREEN_CAST_AREA_STREAM (stream);
   MetaBackend *backend = get_backend (area_src);
+  MetaRendererView *virtual_view;
   ClutterStage *stage;
   MetaRectangle *area;
   float scale;
   ClutterPaintFlag paint_flags = CLUTTER_PAINT_FLAG_CLEAR;
 
+  virtual_view = meta_screen_cast_area_stream_get_virtual_view (area_stream);
+  if (virtual_view)
+    {
+      CoglFramebuffer *view_framebuffer =
+        clutter_stage_view_get_framebuffer (CLUTTER_STAGE_VIEW (virtual_view));
+
+      if (!cogl_blit_framebuffer (view_framebuffer,
+                                  framebuffer,
+                                  0, 0,
+                                  0, 0,
+                                  cogl_framebuffer_get_width (view_framebuffer),
+                                  cogl_framebuffer_get_height (view_framebuffer),
+                                  error))
+        return FALSE;
+
+      cogl_framebuffer_finish (framebuffer);
+
+      return TRUE;
+    }
+
   stage = CLUTTER_STAGE (meta_backend_get_stage (backend));
   area = meta_screen_cast_area_stream_get_area (area_stream);
   scale = meta_screen_cast_area_stream_get_scale (area_stream);
@@ -556,35 +622,24 @@ meta_screen_cast_area_stream_src_set_cursor_metadata (MetaScreenCastStreamSrc *s
   x = (int) roundf (cursor_position.x);
   y = (int) roundf (cursor_position.y);
 
-  if (area_src->cursor_bitmap_invalid)
+  if (cursor_sprite)
     {
-      if (cursor_sprite)
-        {
-          float cursor_scale;
-          float metadata_scale;
-
-          cursor_scale = meta_cursor_sprite_get_texture_scale (cursor_sprite);
-          metadata_scale = scale * cursor_scale;
-          meta_screen_cast_stream_src_set_cursor_sprite_metadata (src,
-                                                                  spa_meta_cursor,
-                                                                  cursor_sprite,
-                                                                  x, y,
-                                                                  metadata_scale);
-        }
-      else
-        {
-          meta_screen_cast_stream_src_set_empty_cursor_sprite_metadata (src,
-                                                                        spa_meta_cursor,
-                                                                        x, y);
-        }
-
-      area_src->cursor_bitmap_invalid = FALSE;
+      float cursor_scale;
+      float metadata_scale;
+
+      cursor_scale = meta_cursor_sprite_get_texture_scale (cursor_sprite);
+      metadata_scale = scale * cursor_scale;
+      meta_screen_cast_stream_src_set_cursor_sprite_metadata (src,
+                                                              spa_meta_cursor,
+                                                              cursor_sprite,
+                                                              x, y,
+                                                              metadata_scale);
     }
   else
     {
-      meta_screen_cast_stream_src_set_cursor_position_metadata (src,
-                                                                spa_meta_cursor,
-                                                                x, y);
+      meta_screen_cast_stream_src_set_empty_cursor_sprite_metadata (src,
+                                                                    spa_meta_cursor,
+                                                                    x, y);
     }
 }
 
@@ -617,7 +672,6 @@ meta_screen_cast_area_stream_src_new (MetaScreenCastAreaStream  *area_stream,
 static void
 meta_screen_cast_area_stream_src_init (MetaScreenCastAreaStreamSrc *area_src)
 {
-  area_src->cursor_bitmap_invalid = TRUE;
 }
 
 static void
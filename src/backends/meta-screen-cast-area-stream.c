@@ -22,7 +22,13 @@
 
 #include "backends/meta-screen-cast-area-stream.h"
 
+#include "backends/meta-backend-private.h"
 #include "backends/meta-screen-cast-area-stream-src.h"
+#include "backends/meta-screen-cast-session.h"
+
+#define DEFAULT_REFRESH_RATE 60.0
+#define MAX_VIRTUAL_STREAM_SIZE 16384
+#define MAX_VIRTUAL_STREAM_REFRESH_RATE 240.0
 
 struct _MetaScreenCastAreaStream
 {
@@ -32,6 +38,10 @@ struct _MetaScreenCastAreaStream
 
   MetaRectangle area;
   float scale;
+  float refresh_rate;
+
+  MetaRenderer *renderer;
+  MetaRendererView *virtual_view;
 };
 
 G_DEFINE_TYPE (MetaScreenCastAreaStream,
@@ -56,6 +66,18 @@ meta_screen_cast_area_stream_get_scale (MetaScreenCastAreaStream *area_stream)
   return area_stream->scale;
 }
 
+float
+meta_screen_cast_area_stream_get_refresh_rate (MetaScreenCastAreaStream *area_stream)
+{
+  return area_stream->refresh_rate;
+}
+
+MetaRendererView *
+meta_screen_cast_area_stream_get_virtual_view (MetaScreenCastAreaStream *area_stream)
+{
+  return area_stream->virtual_view;
+}
+
 static gboolean
 calculate_scale (ClutterStage  *stage,
                  MetaRectangle *area,
@@ -118,6 +140,77 @@ meta_screen_cast_area_stream_new (MetaScreenCastSession     *session,
   return area_stream;
 }
 
+/*
+ * A virtual area stream records a stage area not covered by any monitor. It
+ * adds a view of its own for the area, so that it is painted whenever the
+ * area is damaged, paced by the frame clock of that view. Frames are then
+ * recorded from the framebuffer of that view.
+ */
+MetaScreenCastAreaStream *
+meta_screen_cast_area_stream_new_virtual (MetaScreenCastSession     *session,
+                                          GDBusConnection           *connection,
+                                          MetaRectangle             *area,
+                                          float                      refresh_rate,
+                                          ClutterStage              *stage,
+                                          MetaScreenCastCursorMode   cursor_mode,
+                                          MetaScreenCastFlag         flags,
+                                          GError                   **error)
+{
+  MetaScreenCast *screen_cast =
+    meta_screen_cast_session_get_screen_cast (session);
+  MetaBackend *backend = meta_screen_cast_get_backend (screen_cast);
+  MetaRenderer *renderer = meta_backend_get_renderer (backend);
+  MetaScreenCastAreaStream *area_stream;
+  MetaRendererView *virtual_view;
+
+  if (area->width <= 0 || area->height <= 0 ||
+      area->width > MAX_VIRTUAL_STREAM_SIZE ||
+      area->height > MAX_VIRTUAL_STREAM_SIZE)
+    {
+      g_set_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_ARGUMENT,
+                   "Invalid virtual stream size %dx%d",
+                   area->width, area->height);
+      return NULL;
+    }
+
+  if (refresh_rate <= 0.0 || refresh_rate > MAX_VIRTUAL_STREAM_REFRESH_RATE)
+    {
+      g_set_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_ARGUMENT,
+                   "Invalid virtual stream refresh rate %f",
+                   refresh_rate);
+      return NULL;
+    }
+
+  area_stream = g_initable_new (META_TYPE_SCREEN_CAST_AREA_STREAM,
+                                NULL,
+                                error,
+                                "session", session,
+                                "connection", connection,
+                                "cursor-mode", cursor_mode,
+                                "flags", flags,
+                                NULL);
+  if (!area_stream)
+    return NULL;
+
+  virtual_view = meta_renderer_add_virtual_view (renderer, area,
+                                                 refresh_rate,
+                                                 error);
+  if (!virtual_view)
+    {
+      g_object_unref (area_stream);
+      return NULL;
+    }
+
+  area_stream->area = *area;
+  area_stream->scale = 1.0;
+  area_stream->refresh_rate = refresh_rate;
+  area_stream->stage = stage;
+  area_stream->renderer = renderer;
+  area_stream->virtual_view = virtual_view;
+
+  return area_stream;
+}
+
 static MetaScreenCastStreamSrc *
 meta_screen_cast_area_stream_create_src (MetaScreenCastStream  *stream,
                                          GError               **error)
@@ -141,6 +234,15 @@ meta_screen_cast_area_stream_set_parameters (MetaScreenCastStream *stream,
   MetaScreenCastAreaStream *area_stream =
     META_SCREEN_CAST_AREA_STREAM (stream);
 
+  if (area_stream->virtual_view)
+    {
+      g_variant_builder_add (parameters_builder, "{sv}",
+                             "position",
+                             g_variant_new ("(ii)",
+                                            area_stream->area.x,
+                                            area_stream->area.y));
+    }
+
   g_variant_builder_add (parameters_builder, "{sv}",
                          "size",
                          g_variant_new ("(ii)",
@@ -162,17 +264,36 @@ meta_screen_cast_area_stream_transform_position (MetaScreenCastStream *stream,
   *y = area_stream->area.y + (int) roundf (stream_y / area_stream->scale);
 }
 
+static void
+meta_screen_cast_area_stream_dispose (GObject *object)
+{
+  MetaScreenCastAreaStream *area_stream = META_SCREEN_CAST_AREA_STREAM (object);
+
+  if (area_stream->virtual_view)
+    {
+      meta_renderer_remove_virtual_view (area_stream->renderer,
+                                         area_stream->virtual_view);
+      area_stream->virtual_view = NULL;
+    }
+
+  G_OBJECT_CLASS (meta_screen_cast_area_stream_parent_class)->dispose (object);
+}
+
 static void
 meta_screen_cast_area_stream_init (MetaScreenCastAreaStream *area_stream)
 {
+  area_stream->refresh_rate = DEFAULT_REFRESH_RATE;
 }
 
 static void
 meta_screen_cast_area_stream_class_init (MetaScreenCastAreaStreamClass *klass)
 {
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
   MetaScreenCastStreamClass *stream_class =
     META_SCREEN_CAST_STREAM_CLASS (klass);
 
+  object_class->dispose = meta_screen_cast_area_stream_dispose;
+
   stream_class->create_src = meta_screen_cast_area_stream_create_src;
   stream_class->set_parameters = meta_screen_cast_area_stream_set_parameters;
   stream_class->transform_position = meta_screen_cast_area_stream_transform_position;
@@ -40,10 +40,23 @@ MetaScreenCastAreaStream * meta_screen_cast_area_stream_new (MetaScreenCastSessi
                                                              MetaScreenCastFlag         flags,
                                                              GError                   **error);
 
+MetaScreenCastAreaStream * meta_screen_cast_area_stream_new_virtual (MetaScreenCastSession     *session,
+                                                                     GDBusConnection           *connection,
+                                                                     MetaRectangle             *area,
+                                                                     float                      refresh_rate,
+                                                                     ClutterStage              *stage,
+                                                                     MetaScreenCastCursorMode   cursor_mode,
+                                                                     MetaScreenCastFlag         flags,
+                                                                     GError                   **error);
+
 ClutterStage * meta_screen_cast_area_stream_get_stage (MetaScreenCastAreaStream *area_stream);
 
 MetaRectangle * meta_screen_cast_area_stream_get_area (MetaScreenCastAreaStream *area_stream);
 
 float meta_screen_cast_area_stream_get_scale (MetaScreenCastAreaStream *area_stream);
 
+float meta_screen_cast_area_stream_get_refresh_rate (MetaScreenCastAreaStream *area_stream);
+
+MetaRendererView * meta_screen_cast_area_stream_get_virtual_view (MetaScreenCastAreaStream *area_stream);
+
 #endif /* META_SCREEN_CAST_AREA_STREAM_H */
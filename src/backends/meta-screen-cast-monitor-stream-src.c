@@ -41,7 +41,6 @@ struct _MetaScreenCastMonitorStreamSrc
 {
   MetaScreenCastStreamSrc parent;
 
-  gboolean cursor_bitmap_invalid;
   gboolean hw_cursor_inhibited;
 
   GList *watches;
@@ -248,7 +247,6 @@ static void
 cursor_changed (MetaCursorTracker              *cursor_tracker,
                 MetaScreenCastMonitorStreamSrc *monitor_src)
 {
-  monitor_src->cursor_bitmap_invalid = TRUE;
   sync_cursor_state (monitor_src);
 }
 
@@ -320,6 +318,9 @@ add_view_watches (MetaScreenCastMonitorStreamSrc *monitor_src,
       MetaRendererView *view = l->data;
       MetaRectangle view_layout;
 
+      if (meta_renderer_is_virtual_view (renderer, view))
+        continue;
+
       clutter_stage_view_get_layout (CLUTTER_STAGE_VIEW (view), &view_layout);
       if (meta_rectangle_overlap (&logical_monitor_layout, &view_layout))
         {
@@ -589,6 +590,9 @@ meta_screen_cast_monitor_stream_src_record_to_framebuffer (MetaScreenCastStreamS
       MetaRectangle view_layout;
       int x, y;
 
+      if (meta_renderer_is_virtual_view (renderer, META_RENDERER_VIEW (view)))
+        continue;
+
       clutter_stage_view_get_layout (view, &view_layout);
 
       if (!meta_rectangle_overlap (&logical_monitor_layout, &view_layout))
@@ -648,6 +652,9 @@ meta_screen_cast_monitor_stream_record_follow_up (MetaScreenCastStreamSrc *src)
       MetaRectangle view_layout;
       MetaRectangle damage;
 
+      if (meta_renderer_is_virtual_view (renderer, view))
+        continue;
+
       clutter_stage_view_get_layout (CLUTTER_STAGE_VIEW (view), &view_layout);
 
       if (!meta_rectangle_overlap (&logical_monitor_layout, &view_layout))
@@ -713,35 +720,24 @@ meta_screen_cast_monitor_stream_src_set_cursor_metadata (MetaScreenCastStreamSrc
   x = (int) roundf (cursor_position.x);
   y = (int) roundf (cursor_position.y);
 
-  if (monitor_src->cursor_bitmap_invalid)
+  if (cursor_sprite)
     {
-      if (cursor_sprite)
-        {
-          float cursor_scale;
-          float scale;
-
-          cursor_scale = meta_cursor_sprite_get_texture_scale (cursor_sprite);
-          scale = view_scale * cursor_scale;
-          meta_screen_cast_stream_src_set_cursor_sprite_metadata (src,
-                                                                  spa_meta_cursor,
-                                                                  cursor_sprite,
-                                                                  x, y,
-                                                                  scale);
-        }
-      else
-        {
-          meta_screen_cast_stream_src_set_empty_cursor_sprite_metadata (src,
-                                                                        spa_meta_cursor,
-                                                                        x, y);
-        }
-
-      monitor_src->cursor_bitmap_invalid = FALSE;
+      float cursor_scale;
+      float scale;
+
+      cursor_scale = meta_cursor_sprite_get_texture_scale (cursor_sprite);
+      scale = view_scale * cursor_scale;
+      meta_screen_cast_stream_src_set_cursor_sprite_metadata (src,
+                                                              spa_meta_cursor,
+                                                              cursor_sprite,
+                                                              x, y,
+                                                              scale);
     }
   else
     {
-      meta_screen_cast_stream_src_set_cursor_position_metadata (src,
-                                                                spa_meta_cursor,
-                                                                x, y);
+      meta_screen_cast_stream_src_set_empty_cursor_sprite_metadata (src,
+                                                                    spa_meta_cursor,
+                                                                    x, y);
     }
 }
 
@@ -774,7 +770,6 @@ meta_screen_cast_monitor_stream_src_new (MetaScreenCastMonitorStream  *monitor_s
 static void
 meta_screen_cast_monitor_stream_src_init (MetaScreenCastMonitorStreamSrc *monitor_src)
 {
-  monitor_src->cursor_bitmap_invalid = TRUE;
 }
 
 static void
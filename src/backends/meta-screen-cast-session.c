@@ -296,6 +296,56 @@ is_valid_cursor_mode (MetaScreenCastCursorMode cursor_mode)
   return FALSE;
 }
 
+static gboolean
+is_valid_pacing_mode (MetaScreenCastPacingMode pacing_mode)
+{
+  switch (pacing_mode)
+    {
+    case META_SCREEN_CAST_PACING_MODE_DAMAGE:
+    case META_SCREEN_CAST_PACING_MODE_CONSTANT:
+      return TRUE;
+    }
+
+  return FALSE;
+}
+
+static gboolean
+get_pacing_properties (GVariant              *properties_variant,
+                       GDBusMethodInvocation *invocation,
+                       MetaScreenCastPacing  *pacing)
+{
+  *pacing = (MetaScreenCastPacing) {
+    .mode = META_SCREEN_CAST_PACING_MODE_DAMAGE,
+  };
+
+  if (g_variant_lookup (properties_variant, "pacing-mode", "u", &pacing->mode) &&
+      !is_valid_pacing_mode (pacing->mode))
+    {
+      g_dbus_method_invocation_return_error (invocation, G_DBUS_ERROR,
+                                             G_DBUS_ERROR_FAILED,
+                                             "Unknown pacing mode");
+      return FALSE;
+    }
+
+  g_variant_lookup (properties_variant, "min-framerate", "d",
+                    &pacing->min_framerate);
+  g_variant_lookup (properties_variant, "max-framerate", "d",
+                    &pacing->max_framerate);
+
+  if (pacing->min_framerate < 0.0 ||
+      pacing->max_framerate < 0.0 ||
+      (pacing->max_framerate > 0.0 &&
+       pacing->min_framerate > pacing->max_framerate))
+    {
+      g_dbus_method_invocation_return_error (invocation, G_DBUS_ERROR,
+                                             G_DBUS_ERROR_INVALID_ARGS,
+                                             "Invalid frame rate limits");
+      return FALSE;
+    }
+
+  return TRUE;
+}
+
 static gboolean
 handle_record_monitor (MetaDBusScreenCastSession *skeleton,
                        GDBusMethodInvocation     *invocation,
@@ -312,6 +362,7 @@ handle_record_monitor (MetaDBusScreenCastSession *skeleton,
   MetaScreenCastCursorMode cursor_mode;
   gboolean is_recording;
   MetaScreenCastFlag flags;
+  MetaScreenCastPacing pacing;
   ClutterStage *stage;
   GError *error = NULL;
   MetaScreenCastMonitorStream *monitor_stream;
@@ -361,6 +412,9 @@ handle_record_monitor (MetaDBusScreenCastSession *skeleton,
   if (!g_variant_lookup (properties_variant, "is-recording", "b", &is_recording))
     is_recording = FALSE;
 
+  if (!get_pacing_properties (properties_variant, invocation, &pacing))
+    return TRUE;
+
   stage = CLUTTER_STAGE (meta_backend_get_stage (backend));
 
   flags = META_SCREEN_CAST_FLAG_NONE;
@@ -385,6 +439,7 @@ handle_record_monitor (MetaDBusScreenCastSession *skeleton,
     }
 
   stream = META_SCREEN_CAST_STREAM (monitor_stream);
+  meta_screen_cast_stream_set_pacing (stream, &pacing);
   stream_path = meta_screen_cast_stream_get_object_path (stream);
 
   session->streams = g_list_append (session->streams, stream);
@@ -410,6 +465,7 @@ handle_record_window (MetaDBusScreenCastSession *skeleton,
   MetaScreenCastCursorMode cursor_mode;
   gboolean is_recording;
   MetaScreenCastFlag flags;
+  MetaScreenCastPacing pacing;
   GError *error = NULL;
   MetaDisplay *display;
   GVariant *window_id_variant = NULL;
@@ -469,6 +525,9 @@ handle_record_window (MetaDBusScreenCastSession *skeleton,
   if (!g_variant_lookup (properties_variant, "is-recording", "b", &is_recording))
     is_recording = FALSE;
 
+  if (!get_pacing_properties (properties_variant, invocation, &pacing))
+    return TRUE;
+
   interface_skeleton = G_DBUS_INTERFACE_SKELETON (skeleton);
   connection = g_dbus_interface_skeleton_get_connection (interface_skeleton);
 
@@ -493,6 +552,7 @@ handle_record_window (MetaDBusScreenCastSession *skeleton,
     }
 
   stream = META_SCREEN_CAST_STREAM (window_stream);
+  meta_screen_cast_stream_set_pacing (stream, &pacing);
   stream_path = meta_screen_cast_stream_get_object_path (stream);
 
   session->streams = g_list_append (session->streams, stream);
@@ -523,6 +583,7 @@ handle_record_area (MetaDBusScreenCastSession *skeleton,
   MetaScreenCastCursorMode cursor_mode;
   gboolean is_recording;
   MetaScreenCastFlag flags;
+  MetaScreenCastPacing pacing;
   g_autoptr (GError) error = NULL;
   MetaRectangle rect;
   MetaScreenCastAreaStream *area_stream;
@@ -555,6 +616,9 @@ handle_record_area (MetaDBusScreenCastSession *skeleton,
   if (!g_variant_lookup (properties_variant, "is-recording", "b", &is_recording))
     is_recording = FALSE;
 
+  if (!get_pacing_properties (properties_variant, invocation, &pacing))
+    return TRUE;
+
   interface_skeleton = G_DBUS_INTERFACE_SKELETON (skeleton);
   connection = g_dbus_interface_skeleton_get_connection (interface_skeleton);
   backend = meta_screen_cast_get_backend (session->screen_cast);
@@ -587,6 +651,7 @@ handle_record_area (MetaDBusScreenCastSession *skeleton,
     }
 
   stream = META_SCREEN_CAST_STREAM (area_stream);
+  meta_screen_cast_stream_set_pacing (stream, &pacing);
   stream_path = meta_screen_cast_stream_get_object_path (stream);
 
   session->streams = g_list_append (session->streams, stream);
@@ -600,6 +665,118 @@ handle_record_area (MetaDBusScreenCastSession *skeleton,
   return TRUE;
 }
 
+static gboolean
+handle_record_virtual (MetaDBusScreenCastSession *skeleton,
+                       GDBusMethodInvocation     *invocation,
+                       GVariant                  *properties_variant)
+{
+  MetaScreenCastSession *session = META_SCREEN_CAST_SESSION (skeleton);
+  GDBusInterfaceSkeleton *interface_skeleton;
+  GDBusConnection *connection;
+  MetaBackend *backend;
+  ClutterStage *stage;
+  MetaScreenCastCursorMode cursor_mode;
+  gboolean is_recording;
+  MetaScreenCastFlag flags;
+  MetaScreenCastPacing pacing;
+  g_autoptr (GError) error = NULL;
+  MetaRectangle rect = { 0 };
+  double refresh_rate;
+  MetaScreenCastAreaStream *area_stream;
+  MetaScreenCastStream *stream;
+  char *stream_path;
+
+  if (!check_permission (session, invocation))
+    {
+      g_dbus_method_invocation_return_error (invocation, G_DBUS_ERROR,
+                                             G_DBUS_ERROR_ACCESS_DENIED,
+                                             "Permission denied");
+      return TRUE;
+    }
+
+  if (!g_variant_lookup (properties_variant, "size", "(ii)",
+                         &rect.width, &rect.height))
+    {
+      g_dbus_method_invocation_return_error (invocation, G_DBUS_ERROR,
+                                             G_DBUS_ERROR_INVALID_ARGS,
+                                             "Missing virtual stream size");
+      return TRUE;
+    }
+
+  backend = meta_screen_cast_get_backend (session->screen_cast);
+
+  if (!g_variant_lookup (properties_variant, "position", "(ii)",
+                         &rect.x, &rect.y))
+    {
+      MetaRenderer *renderer = meta_backend_get_renderer (backend);
+
+      meta_renderer_place_virtual_view (renderer, &rect);
+    }
+
+  if (!g_variant_lookup (properties_variant, "refresh-rate", "d", &refresh_rate))
+    refresh_rate = 60.0;
+
+  if (!g_variant_lookup (properties_variant, "cursor-mode", "u", &cursor_mode))
+    {
+      cursor_mode = META_SCREEN_CAST_CURSOR_MODE_HIDDEN;
+    }
+  else
+    {
+      if (!is_valid_cursor_mode (cursor_mode))
+        {
+          g_dbus_method_invocation_return_error (invocation, G_DBUS_ERROR,
+                                                 G_DBUS_ERROR_FAILED,
+                                                 "Unknown cursor mode");
+          return TRUE;
+        }
+    }
+
+  if (!g_variant_lookup (properties_variant, "is-recording", "b", &is_recording))
+    is_recording = FALSE;
+
+  if (!get_pacing_properties (properties_variant, invocation, &pacing))
+    return TRUE;
+
+  interface_skeleton = G_DBUS_INTERFACE_SKELETON (skeleton);
+  connection = g_dbus_interface_skeleton_get_connection (interface_skeleton);
+  stage = CLUTTER_STAGE (meta_backend_get_stage (backend));
+
+  flags = META_SCREEN_CAST_FLAG_NONE;
+  if (is_recording)
+    flags |= META_SCREEN_CAST_FLAG_IS_RECORDING;
+
+  area_stream = meta_screen_cast_area_stream_new_virtual (session,
+                                                          connection,
+                                                          &rect,
+                                                          (float) refresh_rate,
+                                                          stage,
+                                                          cursor_mode,
+                                                          flags,
+                                                          &error);
+  if (!area_stream)
+    {
+      g_dbus_method_invocation_return_error (invocation, G_DBUS_ERROR,
+                                             G_DBUS_ERROR_FAILED,
+                                             "Failed to record virtual: %s",
+                                             error->message);
+      return TRUE;
+    }
+
+  stream = META_SCREEN_CAST_STREAM (area_stream);
+  meta_screen_cast_stream_set_pacing (stream, &pacing);
+  stream_path = meta_screen_cast_stream_get_object_path (stream);
+
+  session->streams = g_list_append (session->streams, stream);
+
+  g_signal_connect (stream, "closed", G_CALLBACK (on_stream_closed), session);
+
+  meta_dbus_screen_cast_session_complete_record_virtual (skeleton,
+                                                         invocation,
+                                                         stream_path);
+
+  return TRUE;
+}
+
 static void
 meta_screen_cast_session_init_iface (MetaDBusScreenCastSessionIface *iface)
 {
@@ -608,6 +785,7 @@ meta_screen_cast_session_init_iface (MetaDBusScreenCastSessionIface *iface)
   iface->handle_record_monitor = handle_record_monitor;
   iface->handle_record_window = handle_record_window;
   iface->handle_record_area = handle_record_area;
+  iface->handle_record_virtual = handle_record_virtual;
 }
 
 static void
@@ -47,6 +47,8 @@
   (sizeof (struct spa_meta_cursor) + \
    sizeof (struct spa_meta_bitmap) + width * height * 4)
 
+#define N_CACHED_CURSOR_BITMAPS 8
+
 enum
 {
   PROP_0,
@@ -72,6 +74,19 @@ typedef struct _MetaPipeWireSource
   struct pw_loop *pipewire_loop;
 } MetaPipeWireSource;
 
+typedef struct _MetaScreenCastCursorBitmap
+{
+  unsigned int serial;
+  float scale;
+  MetaMonitorTransform transform;
+
+  int width;
+  int height;
+  uint8_t *data;
+
+  uint64_t age;
+} MetaScreenCastCursorBitmap;
+
 typedef struct _MetaScreenCastStreamSrcPrivate
 {
   MetaScreenCastStream *stream;
@@ -93,11 +108,22 @@ typedef struct _MetaScreenCastStreamSrcPrivate
 
   int64_t last_frame_timestamp_us;
   guint follow_up_frame_source_id;
+  guint keepalive_frame_source_id;
+
+  uint64_t emitted_frames;
+  uint64_t dropped_frames;
 
   GHashTable *dmabuf_handles;
 
   int stream_width;
   int stream_height;
+
+  MetaScreenCastCursorBitmap cursor_bitmaps[N_CACHED_CURSOR_BITMAPS];
+  uint64_t cursor_bitmap_age;
+
+  gboolean cursor_bitmap_sent;
+  unsigned int sent_cursor_serial;
+  float sent_cursor_scale;
 } MetaScreenCastStreamSrcPrivate;
 
 static void
@@ -276,6 +302,109 @@ meta_screen_cast_stream_src_draw_cursor_into (MetaScreenCastStreamSrc  *src,
   return TRUE;
 }
 
+static void
+clear_cursor_bitmaps (MetaScreenCastStreamSrc *src)
+{
+  MetaScreenCastStreamSrcPrivate *priv =
+    meta_screen_cast_stream_src_get_instance_private (src);
+  int i;
+
+  for (i = 0; i < N_CACHED_CURSOR_BITMAPS; i++)
+    g_clear_pointer (&priv->cursor_bitmaps[i].data, g_free);
+}
+
+static MetaScreenCastCursorBitmap *
+ensure_cursor_bitmap (MetaScreenCastStreamSrc  *src,
+                      MetaCursorSprite         *cursor_sprite,
+                      float                     scale,
+                      GError                  **error)
+{
+  MetaScreenCastStreamSrcPrivate *priv =
+    meta_screen_cast_stream_src_get_instance_private (src);
+  CoglTexture *cursor_texture;
+  unsigned int serial;
+  MetaMonitorTransform transform;
+  MetaScreenCastCursorBitmap *bitmap = NULL;
+  int width, height;
+  uint8_t *data;
+  int i;
+
+  cursor_texture = meta_cursor_sprite_get_cogl_texture (cursor_sprite);
+  serial = meta_cursor_sprite_get_texture_serial (cursor_sprite);
+  transform = meta_cursor_sprite_get_texture_transform (cursor_sprite);
+
+  for (i = 0; i < N_CACHED_CURSOR_BITMAPS; i++)
+    {
+      MetaScreenCastCursorBitmap *cached = &priv->cursor_bitmaps[i];
+
+      if (cached->data &&
+          cached->serial == serial &&
+          cached->scale == scale &&
+          cached->transform == transform)
+        {
+          cached->age = ++priv->cursor_bitmap_age;
+          return cached;
+        }
+
+      if (!bitmap ||
+          !cached->data ||
+          (bitmap->data && cached->age < bitmap->age))
+        bitmap = cached;
+    }
+
+  width = cogl_texture_get_width (cursor_texture) * scale;
+  height = cogl_texture_get_height (cursor_texture) * scale;
+  data = g_malloc (width * height * 4);
+
+  if (!meta_screen_cast_stream_src_draw_cursor_into (src,
+                                                     cursor_texture,
+                                                     scale,
+                                                     data,
+                                                     error))
+    {
+      g_free (data);
+      return NULL;
+    }
+
+  g_free (bitmap->data);
+  *bitmap = (MetaScreenCastCursorBitmap) {
+    .serial = serial,
+    .scale = scale,
+    .transform = transform,
+    .width = width,
+    .height = height,
+    .data = data,
+    .age = ++priv->cursor_bitmap_age,
+  };
+
+  return bitmap;
+}
+
+/*
+ * Returns the cursor sprite rendered at the given scale, in premultiplied
+ * RGBA. The bitmap is cached on the stream source, and only rendered again
+ * when the sprite gets new texture content.
+ */
+const uint8_t *
+meta_screen_cast_stream_src_get_cursor_bitmap (MetaScreenCastStreamSrc  *src,
+                                               MetaCursorSprite         *cursor_sprite,
+                                               float                     scale,
+                                               int                      *width,
+                                               int                      *height,
+                                               GError                  **error)
+{
+  MetaScreenCastCursorBitmap *bitmap;
+
+  bitmap = ensure_cursor_bitmap (src, cursor_sprite, scale, error);
+  if (!bitmap)
+    return NULL;
+
+  *width = bitmap->width;
+  *height = bitmap->height;
+
+  return bitmap->data;
+}
+
 void
 meta_screen_cast_stream_src_unset_cursor_metadata (MetaScreenCastStreamSrc *src,
                                                    struct spa_meta_cursor  *spa_meta_cursor)
@@ -303,8 +432,18 @@ meta_screen_cast_stream_src_set_empty_cursor_sprite_metadata (MetaScreenCastStre
                                                               int                      x,
                                                               int                      y)
 {
+  MetaScreenCastStreamSrcPrivate *priv =
+    meta_screen_cast_stream_src_get_instance_private (src);
   struct spa_meta_bitmap *spa_meta_bitmap;
 
+  if (priv->cursor_bitmap_sent && priv->sent_cursor_serial == 0)
+    {
+      meta_screen_cast_stream_src_set_cursor_position_metadata (src,
+                                                                spa_meta_cursor,
+                                                                x, y);
+      return;
+    }
+
   spa_meta_cursor->id = 1;
   spa_meta_cursor->position.x = x;
   spa_meta_cursor->position.y = y;
@@ -321,6 +460,10 @@ meta_screen_cast_stream_src_set_empty_cursor_sprite_metadata (MetaScreenCastStre
   spa_meta_cursor->hotspot.y = 0;
 
   *spa_meta_bitmap = (struct spa_meta_bitmap) { 0 };
+
+  priv->cursor_bitmap_sent = TRUE;
+  priv->sent_cursor_serial = 0;
+  priv->sent_cursor_scale = 0.0;
 }
 
 void
@@ -331,16 +474,17 @@ meta_screen_cast_stream_src_set_cursor_sprite_metadata (MetaScreenCastStreamSrc
                                                         int                      y,
                                                         float                    scale)
 {
-  CoglTexture *cursor_texture;
+  MetaScreenCastStreamSrcPrivate *priv =
+    meta_screen_cast_stream_src_get_instance_private (src);
   struct spa_meta_bitmap *spa_meta_bitmap;
+  unsigned int serial;
   int hotspot_x, hotspot_y;
-  int texture_width, texture_height;
   int bitmap_width, bitmap_height;
+  const uint8_t *cursor_bitmap;
   uint8_t *bitmap_data;
   GError *error = NULL;
 
-  cursor_texture = meta_cursor_sprite_get_cogl_texture (cursor_sprite);
-  if (!cursor_texture)
+  if (!meta_cursor_sprite_get_cogl_texture (cursor_sprite))
     {
       meta_screen_cast_stream_src_set_empty_cursor_sprite_metadata (src,
                                                                     spa_meta_cursor,
@@ -348,6 +492,31 @@ meta_screen_cast_stream_src_set_cursor_sprite_metadata (MetaScreenCastStreamSrc
       return;
     }
 
+  serial = meta_cursor_sprite_get_texture_serial (cursor_sprite);
+  if (priv->cursor_bitmap_sent &&
+      priv->sent_cursor_serial == serial &&
+      priv->sent_cursor_scale == scale)
+    {
+      meta_screen_cast_stream_src_set_cursor_position_metadata (src,
+                                                                spa_meta_cursor,
+                                                                x, y);
+      return;
+    }
+
+  cursor_bitmap = meta_screen_cast_stream_src_get_cursor_bitmap (src,
+                                                                 cursor_sprite,
+                                                                 scale,
+                                                                 &bitmap_width,
+                                                                 &bitmap_height,
+                                                                 &error);
+  if (!cursor_bitmap)
+    {
+      g_warning ("Failed to draw cursor: %s", error->message);
+      g_error_free (error);
+      spa_meta_cursor->id = 0;
+      return;
+    }
+
   spa_meta_cursor->id = 1;
   spa_meta_cursor->position.x = x;
   spa_meta_cursor->position.y = y;
@@ -364,11 +533,6 @@ meta_screen_cast_stream_src_set_cursor_sprite_metadata (MetaScreenCastStreamSrc
   spa_meta_cursor->hotspot.x = (int32_t) roundf (hotspot_x * scale);
   spa_meta_cursor->hotspot.y = (int32_t) roundf (hotspot_y * scale);
 
-  texture_width = cogl_texture_get_width (cursor_texture);
-  texture_height = cogl_texture_get_height (cursor_texture);
-  bitmap_width = texture_width * scale;
-  bitmap_height = texture_height * scale;
-
   spa_meta_bitmap->size.width = bitmap_width;
   spa_meta_bitmap->size.height = bitmap_height;
   spa_meta_bitmap->stride = bitmap_width * 4;
@@ -376,17 +540,11 @@ meta_screen_cast_stream_src_set_cursor_sprite_metadata (MetaScreenCastStreamSrc
   bitmap_data = SPA_MEMBER (spa_meta_bitmap,
                             spa_meta_bitmap->offset,
                             uint8_t);
+  memcpy (bitmap_data, cursor_bitmap, bitmap_height * bitmap_width * 4);
 
-  if (!meta_screen_cast_stream_src_draw_cursor_into (src,
-                                                     cursor_texture,
-                                                     scale,
-                                                     bitmap_data,
-                                                     &error))
-    {
-      g_warning ("Failed to draw cursor: %s", error->message);
-      g_error_free (error);
-      spa_meta_cursor->id = 0;
-    }
+  priv->cursor_bitmap_sent = TRUE;
+  priv->sent_cursor_serial = serial;
+  priv->sent_cursor_scale = scale;
 }
 
 static void
@@ -489,6 +647,74 @@ maybe_schedule_follow_up_frame (MetaScreenCastStreamSrc *src,
                                                    src);
 }
 
+static int64_t
+get_min_frame_interval_us (MetaScreenCastStreamSrc *src)
+{
+  MetaScreenCastStreamSrcPrivate *priv =
+    meta_screen_cast_stream_src_get_instance_private (src);
+  const MetaScreenCastPacing *pacing =
+    meta_screen_cast_stream_get_pacing (priv->stream);
+  int64_t min_interval_us = 0;
+
+  if (priv->video_format.max_framerate.num > 0)
+    {
+      min_interval_us =
+        ((G_USEC_PER_SEC * priv->video_format.max_framerate.denom) /
+         priv->video_format.max_framerate.num);
+    }
+
+  if (pacing->max_framerate > 0.0)
+    {
+      min_interval_us = MAX (min_interval_us,
+                             (int64_t) (G_USEC_PER_SEC / pacing->max_framerate));
+    }
+
+  return min_interval_us;
+}
+
+static gboolean
+keepalive_frame_cb (gpointer user_data)
+{
+  MetaScreenCastStreamSrc *src = user_data;
+  MetaScreenCastStreamSrcPrivate *priv =
+    meta_screen_cast_stream_src_get_instance_private (src);
+
+  priv->keepalive_frame_source_id = 0;
+  meta_screen_cast_stream_src_record_follow_up (src);
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+restart_keepalive_frame (MetaScreenCastStreamSrc *src)
+{
+  MetaScreenCastStreamSrcPrivate *priv =
+    meta_screen_cast_stream_src_get_instance_private (src);
+  const MetaScreenCastPacing *pacing =
+    meta_screen_cast_stream_get_pacing (priv->stream);
+
+  g_clear_handle_id (&priv->keepalive_frame_source_id, g_source_remove);
+
+  switch (pacing->mode)
+    {
+    case META_SCREEN_CAST_PACING_MODE_DAMAGE:
+      return;
+    case META_SCREEN_CAST_PACING_MODE_CONSTANT:
+      if (pacing->min_framerate <= 0.0)
+        return;
+
+      /* Counted from the last frame sent, so it only fires while idle */
+      priv->keepalive_frame_source_id =
+        g_timeout_add (us2ms ((int64_t) (G_USEC_PER_SEC /
+                                         pacing->min_framerate)),
+                       keepalive_frame_cb,
+                       src);
+      return;
+    }
+
+  g_assert_not_reached ();
+}
+
 void
 meta_screen_cast_stream_src_maybe_record_frame (MetaScreenCastStreamSrc  *src,
                                                 MetaScreenCastRecordFlag  flags)
@@ -500,24 +726,27 @@ meta_screen_cast_stream_src_maybe_record_frame (MetaScreenCastStreamSrc  *src,
   struct spa_buffer *spa_buffer;
   uint8_t *data = NULL;
   uint64_t now_us;
+  int64_t min_interval_us;
   g_autoptr (GError) error = NULL;
 
   now_us = g_get_monotonic_time ();
-  if (priv->video_format.max_framerate.num > 0 &&
-      priv->last_frame_timestamp_us != 0)
+  min_interval_us = get_min_frame_interval_us (src);
+  if (min_interval_us > 0 && priv->last_frame_timestamp_us != 0)
     {
-      int64_t min_interval_us;
       int64_t time_since_last_frame_us;
 
-      min_interval_us =
-        ((G_USEC_PER_SEC * priv->video_format.max_framerate.denom) /
-         priv->video_format.max_framerate.num);
-
       time_since_last_frame_us = now_us - priv->last_frame_timestamp_us;
       if (time_since_last_frame_us < min_interval_us)
         {
           int64_t timeout_us;
 
+          /*
+           * Coalesce the damage into a single follow up frame at the end of
+           * the current interval, instead of emitting a burst of frames.
+           */
+          if (!(flags & META_SCREEN_CAST_RECORD_FLAG_CURSOR_ONLY))
+            priv->dropped_frames++;
+
           timeout_us = min_interval_us - time_since_last_frame_us;
           maybe_schedule_follow_up_frame (src, timeout_us);
           return;
@@ -529,7 +758,11 @@ meta_screen_cast_stream_src_maybe_record_frame (MetaScreenCastStreamSrc  *src,
 
   buffer = pw_stream_dequeue_buffer (priv->pipewire_stream);
   if (!buffer)
-    return;
+    {
+      if (!(flags & META_SCREEN_CAST_RECORD_FLAG_CURSOR_ONLY))
+        priv->dropped_frames++;
+      return;
+    }
 
   spa_buffer = buffer->buffer;
   data = spa_buffer->datas[0].data;
@@ -550,6 +783,8 @@ meta_screen_cast_stream_src_maybe_record_frame (MetaScreenCastStreamSrc  *src,
           spa_buffer->datas[0].chunk->size = spa_buffer->datas[0].maxsize;
           spa_buffer->datas[0].chunk->stride = priv->video_stride;
 
+          priv->emitted_frames++;
+
           /* Update VideoCrop if needed */
           spa_meta_video_crop =
             spa_buffer_find_meta_data (spa_buffer, SPA_META_VideoCrop,
@@ -576,6 +811,7 @@ meta_screen_cast_stream_src_maybe_record_frame (MetaScreenCastStreamSrc  *src,
         {
           g_warning ("Failed to record screen cast frame: %s", error->message);
           spa_buffer->datas[0].chunk->size = 0;
+          priv->dropped_frames++;
         }
     }
   else
@@ -588,6 +824,21 @@ meta_screen_cast_stream_src_maybe_record_frame (MetaScreenCastStreamSrc  *src,
   priv->last_frame_timestamp_us = now_us;
 
   pw_stream_queue_buffer (priv->pipewire_stream, buffer);
+
+  if (!(flags & META_SCREEN_CAST_RECORD_FLAG_CURSOR_ONLY))
+    restart_keepalive_frame (src);
+}
+
+void
+meta_screen_cast_stream_src_get_frame_counters (MetaScreenCastStreamSrc *src,
+                                                uint64_t                *emitted_frames,
+                                                uint64_t                *dropped_frames)
+{
+  MetaScreenCastStreamSrcPrivate *priv =
+    meta_screen_cast_stream_src_get_instance_private (src);
+
+  *emitted_frames = priv->emitted_frames;
+  *dropped_frames = priv->dropped_frames;
 }
 
 static gboolean
@@ -605,6 +856,8 @@ meta_screen_cast_stream_src_enable (MetaScreenCastStreamSrc *src)
   MetaScreenCastStreamSrcPrivate *priv =
     meta_screen_cast_stream_src_get_instance_private (src);
 
+  priv->cursor_bitmap_sent = FALSE;
+
   META_SCREEN_CAST_STREAM_SRC_GET_CLASS (src)->enable (src);
 
   priv->is_enabled = TRUE;
@@ -619,6 +872,7 @@ meta_screen_cast_stream_src_disable (MetaScreenCastStreamSrc *src)
   META_SCREEN_CAST_STREAM_SRC_GET_CLASS (src)->disable (src);
 
   g_clear_handle_id (&priv->follow_up_frame_source_id, g_source_remove);
+  g_clear_handle_id (&priv->keepalive_frame_source_id, g_source_remove);
 
   priv->is_enabled = FALSE;
 }
@@ -1093,6 +1347,7 @@ meta_screen_cast_stream_src_finalize (GObject *object)
 
   g_clear_pointer (&priv->pipewire_stream, pw_stream_destroy);
   g_clear_pointer (&priv->dmabuf_handles, g_hash_table_destroy);
+  clear_cursor_bitmaps (src);
   g_clear_pointer (&priv->pipewire_core, pw_core_disconnect);
   g_clear_pointer (&priv->pipewire_context, pw_context_destroy);
   g_source_destroy (&priv->pipewire_source->base);
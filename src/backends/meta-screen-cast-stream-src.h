@@ -78,6 +78,10 @@ void meta_screen_cast_stream_src_maybe_record_frame (MetaScreenCastStreamSrc  *s
 
 gboolean meta_screen_cast_stream_src_pending_follow_up_frame (MetaScreenCastStreamSrc *src);
 
+void meta_screen_cast_stream_src_get_frame_counters (MetaScreenCastStreamSrc *src,
+                                                     uint64_t                *emitted_frames,
+                                                     uint64_t                *dropped_frames);
+
 int meta_screen_cast_stream_src_get_stride (MetaScreenCastStreamSrc *src);
 
 int meta_screen_cast_stream_src_get_width (MetaScreenCastStreamSrc *src);
@@ -92,6 +96,13 @@ gboolean meta_screen_cast_stream_src_draw_cursor_into (MetaScreenCastStreamSrc
                                                        uint8_t                  *data,
                                                        GError                  **error);
 
+const uint8_t * meta_screen_cast_stream_src_get_cursor_bitmap (MetaScreenCastStreamSrc  *src,
+                                                               MetaCursorSprite         *cursor_sprite,
+                                                               float                     scale,
+                                                               int                      *width,
+                                                               int                      *height,
+                                                               GError                  **error);
+
 void meta_screen_cast_stream_src_unset_cursor_metadata (MetaScreenCastStreamSrc *src,
                                                         struct spa_meta_cursor  *spa_meta_cursor);
 
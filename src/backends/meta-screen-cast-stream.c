@@ -31,6 +31,8 @@
 #define META_SCREEN_CAST_STREAM_DBUS_IFACE "org.gnome.Mutter.ScreenCast.Stream"
 #define META_SCREEN_CAST_STREAM_DBUS_PATH "/org/gnome/Mutter/ScreenCast/Stream"
 
+#define FRAME_STATISTICS_UPDATE_INTERVAL_S 1
+
 enum
 {
   PROP_0,
@@ -59,8 +61,13 @@ typedef struct _MetaScreenCastStreamPrivate
 
   MetaScreenCastCursorMode cursor_mode;
   MetaScreenCastFlag flags;
+  MetaScreenCastPacing pacing;
 
   MetaScreenCastStreamSrc *src;
+
+  guint frame_statistics_source_id;
+  uint64_t emitted_frames;
+  uint64_t dropped_frames;
 } MetaScreenCastStreamPrivate;
 
 static void
@@ -120,6 +127,59 @@ on_stream_src_ready (MetaScreenCastStreamSrc *src,
                                  NULL);
 }
 
+static void
+set_frame_statistics (MetaScreenCastStream *stream,
+                      uint64_t              emitted_frames,
+                      uint64_t              dropped_frames)
+{
+  MetaDBusScreenCastStream *skeleton = META_DBUS_SCREEN_CAST_STREAM (stream);
+  GVariantBuilder statistics_builder;
+  GVariant *statistics_variant;
+
+  g_variant_builder_init (&statistics_builder, G_VARIANT_TYPE_VARDICT);
+  g_variant_builder_add (&statistics_builder, "{sv}",
+                         "emitted-frames",
+                         g_variant_new_uint64 (emitted_frames));
+  g_variant_builder_add (&statistics_builder, "{sv}",
+                         "dropped-frames",
+                         g_variant_new_uint64 (dropped_frames));
+
+  statistics_variant = g_variant_builder_end (&statistics_builder);
+  meta_dbus_screen_cast_stream_set_frame_statistics (skeleton,
+                                                     statistics_variant);
+}
+
+static void
+update_frame_statistics (MetaScreenCastStream *stream)
+{
+  MetaScreenCastStreamPrivate *priv =
+    meta_screen_cast_stream_get_instance_private (stream);
+  uint64_t emitted_frames;
+  uint64_t dropped_frames;
+
+  meta_screen_cast_stream_src_get_frame_counters (priv->src,
+                                                  &emitted_frames,
+                                                  &dropped_frames);
+  if (emitted_frames == priv->emitted_frames &&
+      dropped_frames == priv->dropped_frames)
+    return;
+
+  priv->emitted_frames = emitted_frames;
+  priv->dropped_frames = dropped_frames;
+
+  set_frame_statistics (stream, emitted_frames, dropped_frames);
+}
+
+static gboolean
+update_frame_statistics_cb (gpointer user_data)
+{
+  MetaScreenCastStream *stream = META_SCREEN_CAST_STREAM (user_data);
+
+  update_frame_statistics (stream);
+
+  return G_SOURCE_CONTINUE;
+}
+
 MetaScreenCastSession *
 meta_screen_cast_stream_get_session (MetaScreenCastStream *stream)
 {
@@ -145,6 +205,15 @@ meta_screen_cast_stream_start (MetaScreenCastStream  *stream,
   g_signal_connect (src, "ready", G_CALLBACK (on_stream_src_ready), stream);
   g_signal_connect (src, "closed", G_CALLBACK (on_stream_src_closed), stream);
 
+  /*
+   * Frame counters change with every frame, so only publish them
+   * periodically to avoid flooding the bus with property changes.
+   */
+  priv->frame_statistics_source_id =
+    g_timeout_add_seconds (FRAME_STATISTICS_UPDATE_INTERVAL_S,
+                           update_frame_statistics_cb,
+                           stream);
+
   return TRUE;
 }
 
@@ -154,6 +223,7 @@ meta_screen_cast_stream_close (MetaScreenCastStream *stream)
   MetaScreenCastStreamPrivate *priv =
     meta_screen_cast_stream_get_instance_private (stream);
 
+  g_clear_handle_id (&priv->frame_statistics_source_id, g_source_remove);
   g_clear_object (&priv->src);
 
   g_signal_emit (stream, signals[CLOSED], 0);
@@ -209,6 +279,27 @@ meta_screen_cast_stream_get_flags (MetaScreenCastStream *stream)
   return priv->flags;
 }
 
+void
+meta_screen_cast_stream_set_pacing (MetaScreenCastStream       *stream,
+                                    const MetaScreenCastPacing *pacing)
+{
+  MetaScreenCastStreamPrivate *priv =
+    meta_screen_cast_stream_get_instance_private (stream);
+
+  g_return_if_fail (!priv->src);
+
+  priv->pacing = *pacing;
+}
+
+const MetaScreenCastPacing *
+meta_screen_cast_stream_get_pacing (MetaScreenCastStream *stream)
+{
+  MetaScreenCastStreamPrivate *priv =
+    meta_screen_cast_stream_get_instance_private (stream);
+
+  return &priv->pacing;
+}
+
 static void
 meta_screen_cast_stream_set_property (GObject      *object,
                                       guint         prop_id,
@@ -301,6 +392,8 @@ meta_screen_cast_stream_initable_init (GInitable     *initable,
   parameters_variant = g_variant_builder_end (&parameters_builder);
   meta_dbus_screen_cast_stream_set_parameters (skeleton, parameters_variant);
 
+  set_frame_statistics (stream, 0, 0);
+
   priv->object_path =
     g_strdup_printf (META_SCREEN_CAST_STREAM_DBUS_PATH "/u%u",
                      ++global_stream_number);
@@ -322,6 +415,12 @@ meta_screen_cast_stream_init_initable_iface (GInitableIface *iface)
 static void
 meta_screen_cast_stream_init (MetaScreenCastStream *stream)
 {
+  MetaScreenCastStreamPrivate *priv =
+    meta_screen_cast_stream_get_instance_private (stream);
+
+  priv->pacing = (MetaScreenCastPacing) {
+    .mode = META_SCREEN_CAST_PACING_MODE_DAMAGE,
+  };
 }
 
 static void
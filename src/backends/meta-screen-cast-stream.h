@@ -71,4 +71,9 @@ MetaScreenCastCursorMode meta_screen_cast_stream_get_cursor_mode (MetaScreenCast
 
 MetaScreenCastFlag meta_screen_cast_stream_get_flags (MetaScreenCastStream *stream);
 
+void meta_screen_cast_stream_set_pacing (MetaScreenCastStream       *stream,
+                                         const MetaScreenCastPacing *pacing);
+
+const MetaScreenCastPacing * meta_screen_cast_stream_get_pacing (MetaScreenCastStream *stream);
+
 #endif /* META_SCREEN_CAST_STREAM_H */
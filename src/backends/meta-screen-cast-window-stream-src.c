@@ -39,8 +39,6 @@ struct _MetaScreenCastWindowStreamSrc
   unsigned long screen_cast_window_destroyed_handler_id;
   unsigned long cursor_moved_handler_id;
   unsigned long cursor_changed_handler_id;
-
-  gboolean cursor_bitmap_invalid;
 };
 
 G_DEFINE_TYPE (MetaScreenCastWindowStreamSrc,
@@ -111,12 +109,11 @@ maybe_draw_cursor_sprite (MetaScreenCastWindowStreamSrc *window_src,
   MetaCursorRenderer *cursor_renderer =
     meta_backend_get_cursor_renderer (backend);
   MetaCursorSprite *cursor_sprite;
-  CoglTexture *cursor_texture;
   MetaScreenCastWindow *screen_cast_window;
   graphene_point_t cursor_position;
   graphene_point_t relative_cursor_position;
   cairo_surface_t *cursor_surface;
-  uint8_t *cursor_surface_data;
+  const uint8_t *cursor_bitmap;
   GError *error = NULL;
   cairo_surface_t *stream_surface;
   int width, height;
@@ -128,8 +125,7 @@ maybe_draw_cursor_sprite (MetaScreenCastWindowStreamSrc *window_src,
   if (!cursor_sprite)
     return;
 
-  cursor_texture = meta_cursor_sprite_get_cogl_texture (cursor_sprite);
-  if (!cursor_texture)
+  if (!meta_cursor_sprite_get_cogl_texture (cursor_sprite))
     return;
 
   screen_cast_window = window_src->screen_cast_window;
@@ -143,24 +139,25 @@ maybe_draw_cursor_sprite (MetaScreenCastWindowStreamSrc *window_src,
 
   meta_cursor_sprite_get_hotspot (cursor_sprite, &hotspot_x, &hotspot_y);
 
-  width = cogl_texture_get_width (cursor_texture) * scale;
-  height = cogl_texture_get_height (cursor_texture) * scale;
-  cursor_surface = cairo_image_surface_create (CAIRO_FORMAT_ARGB32,
-                                               width, height);
-
-  cursor_surface_data = cairo_image_surface_get_data (cursor_surface);
-  if (!meta_screen_cast_stream_src_draw_cursor_into (src,
-                                                     cursor_texture,
-                                                     scale,
-                                                     cursor_surface_data,
-                                                     &error))
+  cursor_bitmap = meta_screen_cast_stream_src_get_cursor_bitmap (src,
+                                                                 cursor_sprite,
+                                                                 scale,
+                                                                 &width,
+                                                                 &height,
+                                                                 &error);
+  if (!cursor_bitmap)
     {
       g_warning ("Failed to draw cursor: %s", error->message);
       g_error_free (error);
-      cairo_surface_destroy (cursor_surface);
       return;
     }
 
+  cursor_surface =
+    cairo_image_surface_create_for_data ((uint8_t *) cursor_bitmap,
+                                         CAIRO_FORMAT_ARGB32,
+                                         width, height,
+                                         width * 4);
+
   stream_surface =
     cairo_image_surface_create_for_data (data, CAIRO_FORMAT_ARGB32,
                                          stream_rect->width,
@@ -168,8 +165,6 @@ maybe_draw_cursor_sprite (MetaScreenCastWindowStreamSrc *window_src,
                                          stream_rect->width * 4);
 
   cr = cairo_create (stream_surface);
-  cairo_surface_mark_dirty (cursor_surface);
-  cairo_surface_flush (cursor_surface);
   cairo_set_source_surface (cr, cursor_surface,
                             relative_cursor_position.x - hotspot_x * scale,
                             relative_cursor_position.y - hotspot_y * scale);
@@ -380,7 +375,6 @@ static void
 cursor_changed (MetaCursorTracker             *cursor_tracker,
                 MetaScreenCastWindowStreamSrc *window_src)
 {
-  window_src->cursor_bitmap_invalid = TRUE;
   sync_cursor_state (window_src);
 }
 
@@ -543,29 +537,19 @@ meta_screen_cast_window_stream_src_set_cursor_metadata (MetaScreenCastStreamSrc
   x = (int) roundf (relative_cursor_position.x);
   y = (int) roundf (relative_cursor_position.y);
 
-  if (window_src->cursor_bitmap_invalid)
+  if (cursor_sprite)
     {
-      if (cursor_sprite)
-        {
-          meta_screen_cast_stream_src_set_cursor_sprite_metadata (src,
-                                                                  spa_meta_cursor,
-                                                                  cursor_sprite,
-                                                                  x, y,
-                                                                  scale);
-        }
-      else
-        {
-          meta_screen_cast_stream_src_set_empty_cursor_sprite_metadata (src,
-                                                                        spa_meta_cursor,
-                                                                        x, y);
-        }
-      window_src->cursor_bitmap_invalid = FALSE;
+      meta_screen_cast_stream_src_set_cursor_sprite_metadata (src,
+                                                              spa_meta_cursor,
+                                                              cursor_sprite,
+                                                              x, y,
+                                                              scale);
     }
   else
     {
-      meta_screen_cast_stream_src_set_cursor_position_metadata (src,
-                                                                spa_meta_cursor,
-                                                                x, y);
+      meta_screen_cast_stream_src_set_empty_cursor_sprite_metadata (src,
+                                                                    spa_meta_cursor,
+                                                                    x, y);
     }
 }
 
@@ -581,7 +565,6 @@ meta_screen_cast_window_stream_src_new (MetaScreenCastWindowStream  *window_stre
 static void
 meta_screen_cast_window_stream_src_init (MetaScreenCastWindowStreamSrc *window_src)
 {
-  window_src->cursor_bitmap_invalid = TRUE;
 }
 
 static void
@@ -43,6 +43,19 @@ typedef enum _MetaScreenCastFlag
   META_SCREEN_CAST_FLAG_IS_RECORDING = 1 << 0,
 } MetaScreenCastFlag;
 
+typedef enum _MetaScreenCastPacingMode
+{
+  META_SCREEN_CAST_PACING_MODE_DAMAGE = 0,
+  META_SCREEN_CAST_PACING_MODE_CONSTANT = 1,
+} MetaScreenCastPacingMode;
+
+typedef struct _MetaScreenCastPacing
+{
+  MetaScreenCastPacingMode mode;
+  double min_framerate;
+  double max_framerate;
+} MetaScreenCastPacing;
+
 #define META_TYPE_SCREEN_CAST (meta_screen_cast_get_type ())
 G_DECLARE_FINAL_TYPE (MetaScreenCast, meta_screen_cast,
                       META, SCREEN_CAST,
@@ -2771,10 +2771,16 @@ meta_renderer_native_queue_modes_reset (MetaRendererNative *renderer_native)
       ClutterStageView *stage_view = l->data;
       CoglFramebuffer *framebuffer =
         clutter_stage_view_get_onscreen (stage_view);
-      CoglOnscreen *onscreen = COGL_ONSCREEN (framebuffer);
-      CoglOnscreenEGL *onscreen_egl = onscreen->winsys;
-      MetaOnscreenNative *onscreen_native = onscreen_egl->platform;
+      CoglOnscreen *onscreen;
+      CoglOnscreenEGL *onscreen_egl;
+      MetaOnscreenNative *onscreen_native;
+
+      if (!cogl_is_onscreen (framebuffer))
+        continue;
 
+      onscreen = COGL_ONSCREEN (framebuffer);
+      onscreen_egl = onscreen->winsys;
+      onscreen_native = onscreen_egl->platform;
       onscreen_native->pending_set_crtc = TRUE;
     }
 
@@ -184,6 +184,9 @@ meta_stage_x11_nested_finish_frame (ClutterStageWindow *stage_window)
       CoglFramebuffer *framebuffer;
       CoglTexture *texture;
 
+      if (meta_renderer_is_virtual_view (renderer, renderer_view))
+        continue;
+
       framebuffer = clutter_stage_view_get_onscreen (view);
       texture = cogl_offscreen_get_texture (COGL_OFFSCREEN (framebuffer));
 
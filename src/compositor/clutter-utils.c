@@ -43,6 +43,11 @@
  * transformation into screen space of the allocation box of an actor
  * and and checking if the corners are "close enough" to integral
  * pixel values.
+ *
+ * Actors that are only scaled along the axes (such as everything on a
+ * fractionally scaled monitor) can still be culled, as long as regions
+ * are rounded conservatively when converting between the coordinate
+ * spaces: growing what an actor may paint, and shrinking what it covers.
  */
 
 /* The definition of "close enough" to integral pixel values is
@@ -111,37 +116,65 @@ meta_actor_vertices_are_untransformed (graphene_point3d_t *verts,
   return TRUE;
 }
 
-/**
- * meta_actor_painting_untransformed:
- * @paint_width: the width of the painted area
- * @paint_height: the height of the painted area
- * @sample_width: the width of the sampled area of the texture
- * @sample_height: the height of the sampled area of the texture
- * @x_origin: if the transform is only an integer translation
- *  then the X coordinate of the location of the origin under the transformation
- *  from drawing space to screen pixel space is returned here.
- * @y_origin: if the transform is only an integer translation
- *  then the X coordinate of the location of the origin under the transformation
- *  from drawing space to screen pixel space is returned here.
- *
- * Determines if the current painting transform is an integer translation.
- * This can differ from the result of meta_actor_is_untransformed() when
- * painting an actor if we're inside a inside a clone paint. @paint_width
- * and @paint_height are used to determine the vertices of the rectangle
- * we check to see if the painted area is "close enough" to the integer
- * transform.
+/* Checks if (according to our fixed point precision) the vertices @verts
+ * form an axis-aligned, unflipped box in the Z=0 plane. The position of its
+ * origin and the scale relative to a box of width @widthf and height
+ * @heightf are returned in @x_origin, @y_origin, @x_scale and @y_scale.
  */
 gboolean
-meta_actor_painting_untransformed (CoglFramebuffer *fb,
-                                   int              paint_width,
-                                   int              paint_height,
-                                   int              sample_width,
-                                   int              sample_height,
-                                   int             *x_origin,
-                                   int             *y_origin)
+meta_actor_vertices_are_axis_aligned (graphene_point3d_t *verts,
+                                      float               widthf,
+                                      float               heightf,
+                                      float              *x_origin,
+                                      float              *y_origin,
+                                      float              *x_scale,
+                                      float              *y_scale)
+{
+  int v0x, v0y, v1x, v1y, v2x, v2y, v3x, v3y;
+  int i;
+
+  if (widthf <= 0 || heightf <= 0)
+    return FALSE;
+
+  for (i = 0; i < 4; i++)
+    {
+      if (round_to_fixed (verts[i].z) != 0)
+        return FALSE;
+    }
+
+  v0x = round_to_fixed (verts[0].x); v0y = round_to_fixed (verts[0].y);
+  v1x = round_to_fixed (verts[1].x); v1y = round_to_fixed (verts[1].y);
+  v2x = round_to_fixed (verts[2].x); v2y = round_to_fixed (verts[2].y);
+  v3x = round_to_fixed (verts[3].x); v3y = round_to_fixed (verts[3].y);
+
+  /* Not rotated/skewed? */
+  if (v0x != v2x || v0y != v1y ||
+      v3x != v1x || v3y != v2y)
+    return FALSE;
+
+  /* Not collapsed or flipped? */
+  if (v1x <= v0x || v2y <= v0y)
+    return FALSE;
+
+  if (x_origin)
+    *x_origin = verts[0].x;
+  if (y_origin)
+    *y_origin = verts[0].y;
+  if (x_scale)
+    *x_scale = (verts[1].x - verts[0].x) / widthf;
+  if (y_scale)
+    *y_scale = (verts[2].y - verts[0].y) / heightf;
+
+  return TRUE;
+}
+
+static void
+get_painting_vertices (CoglFramebuffer    *fb,
+                       int                 paint_width,
+                       int                 paint_height,
+                       graphene_point3d_t *vertices)
 {
   CoglMatrix modelview, projection, modelview_projection;
-  graphene_point3d_t vertices[4];
   float viewport[4];
   int i;
 
@@ -180,9 +213,79 @@ meta_actor_painting_untransformed (CoglFramebuffer *fb,
       vertices[i].y = MTX_GL_SCALE_Y (vertices[i].y, w,
                                       viewport[3], viewport[1]);
     }
+}
+
+/**
+ * meta_actor_painting_untransformed:
+ * @paint_width: the width of the painted area
+ * @paint_height: the height of the painted area
+ * @sample_width: the width of the sampled area of the texture
+ * @sample_height: the height of the sampled area of the texture
+ * @x_origin: if the transform is only an integer translation
+ *  then the X coordinate of the location of the origin under the transformation
+ *  from drawing space to screen pixel space is returned here.
+ * @y_origin: if the transform is only an integer translation
+ *  then the X coordinate of the location of the origin under the transformation
+ *  from drawing space to screen pixel space is returned here.
+ *
+ * Determines if the current painting transform is an integer translation.
+ * This can differ from the result of meta_actor_is_untransformed() when
+ * painting an actor if we're inside a inside a clone paint. @paint_width
+ * and @paint_height are used to determine the vertices of the rectangle
+ * we check to see if the painted area is "close enough" to the integer
+ * transform.
+ */
+gboolean
+meta_actor_painting_untransformed (CoglFramebuffer *fb,
+                                   int              paint_width,
+                                   int              paint_height,
+                                   int              sample_width,
+                                   int              sample_height,
+                                   int             *x_origin,
+                                   int             *y_origin)
+{
+  graphene_point3d_t vertices[4];
+
+  get_painting_vertices (fb, paint_width, paint_height, vertices);
 
   return meta_actor_vertices_are_untransformed (vertices,
                                                 sample_width, sample_height,
                                                 x_origin, y_origin);
 }
 
+/**
+ * meta_actor_painting_axis_aligned:
+ * @paint_width: the width of the painted area
+ * @paint_height: the height of the painted area
+ * @x_origin: the X coordinate of the painted origin in framebuffer pixels
+ * @y_origin: the Y coordinate of the painted origin in framebuffer pixels
+ * @x_scale: the horizontal scale from drawing space to framebuffer pixels
+ * @y_scale: the vertical scale from drawing space to framebuffer pixels
+ *
+ * Determines if the current painting transform is only a scale along the
+ * axes followed by a translation. This is a relaxed version of
+ * meta_actor_painting_untransformed(), for callers that can round their
+ * regions conservatively.
+ */
+gboolean
+meta_actor_painting_axis_aligned (CoglFramebuffer *fb,
+                                  int              paint_width,
+                                  int              paint_height,
+                                  float           *x_origin,
+                                  float           *y_origin,
+                                  float           *x_scale,
+                                  float           *y_scale)
+{
+  graphene_point3d_t vertices[4];
+
+  get_painting_vertices (fb, paint_width, paint_height, vertices);
+
+  /* The projected depth is not meaningful here */
+  vertices[0].z = vertices[1].z = vertices[2].z = vertices[3].z = 0;
+
+  return meta_actor_vertices_are_axis_aligned (vertices,
+                                               paint_width, paint_height,
+                                               x_origin, y_origin,
+                                               x_scale, y_scale);
+}
+
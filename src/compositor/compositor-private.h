@@ -8,6 +8,7 @@
 #include "clutter/clutter-mutter.h"
 #include "clutter/clutter.h"
 #include "compositor/meta-plugin-manager.h"
+#include "compositor/meta-texture-budget.h"
 #include "compositor/meta-window-actor-private.h"
 #include "meta/compositor.h"
 #include "meta/display.h"
@@ -80,6 +81,8 @@ gboolean meta_compositor_is_switching_workspace (MetaCompositor *compositor);
 
 MetaLaters * meta_compositor_get_laters (MetaCompositor *compositor);
 
+MetaTextureBudget * meta_compositor_get_texture_budget (MetaCompositor *compositor);
+
 /*
  * This function takes a 64 bit time stamp from the monotonic clock, and clamps
  * it to the scope of the X server clock, without losing the granularity.
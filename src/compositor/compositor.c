@@ -132,6 +132,8 @@ typedef struct _MetaCompositorPrivate
   MetaPluginManager *plugin_mgr;
 
   MetaLaters *laters;
+
+  MetaTextureBudget *texture_budget;
 } MetaCompositorPrivate;
 
 G_DEFINE_ABSTRACT_TYPE_WITH_PRIVATE (MetaCompositor, meta_compositor,
@@ -1080,6 +1082,7 @@ on_presented (ClutterStage     *stage,
       if (g_list_find (actor_stage_views, stage_view))
         {
           meta_window_actor_frame_complete (META_WINDOW_ACTOR (actor),
+                                            stage_view,
                                             frame_info,
                                             presentation_time);
         }
@@ -1150,6 +1153,8 @@ meta_compositor_real_after_paint (MetaCompositor   *compositor,
       if (g_list_find (actor_stage_views, stage_view))
         meta_window_actor_after_paint (META_WINDOW_ACTOR (actor), stage_view);
     }
+
+  meta_texture_budget_queue_check (priv->texture_budget);
 }
 
 static void
@@ -1253,6 +1258,8 @@ meta_compositor_constructed (GObject *object)
 
   priv->laters = meta_laters_new (compositor);
 
+  priv->texture_budget = meta_texture_budget_new ();
+
   G_OBJECT_CLASS (meta_compositor_parent_class)->constructed (object);
 }
 
@@ -1278,6 +1285,9 @@ meta_compositor_dispose (GObject *object)
   g_clear_pointer (&priv->feedback_group, clutter_actor_destroy);
   g_clear_pointer (&priv->windows, g_list_free);
 
+  /* Window actors unregister from the budget when destroyed above */
+  g_clear_object (&priv->texture_budget);
+
   G_OBJECT_CLASS (meta_compositor_parent_class)->dispose (object);
 }
 
@@ -1611,3 +1621,12 @@ meta_compositor_get_laters (MetaCompositor *compositor)
 
   return priv->laters;
 }
+
+MetaTextureBudget *
+meta_compositor_get_texture_budget (MetaCompositor *compositor)
+{
+  MetaCompositorPrivate *priv =
+    meta_compositor_get_instance_private (compositor);
+
+  return priv->texture_budget;
+}
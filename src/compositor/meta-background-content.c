@@ -71,12 +71,20 @@
  * gradient, or a repeated texture for wallpaper, or a pre-rendered
  * texture the size of the screen), and we draw with that, possibly
  * adding the vignette and opacity.
+ *
+ * The vignette and gradient don't change from frame to frame, so once
+ * their parameters have settled they are rendered together with the
+ * background into a texture the size of the actor, and from then on
+ * painting is a plain copy of that texture.
  */
 
 #include "config.h"
 
 #include "compositor/meta-background-content-private.h"
 
+#include <math.h>
+
+#include "backends/meta-backend-private.h"
 #include "clutter/clutter.h"
 #include "compositor/clutter-utils.h"
 #include "compositor/cogl-utils.h"
@@ -165,6 +173,13 @@ struct _MetaBackgroundContent
   cairo_rectangle_int_t texture_area;
   int texture_width, texture_height;
 
+  CoglTexture *effects_texture;
+  CoglFramebuffer *effects_fbo;
+  CoglPipeline *effects_pipeline;
+  PipelineFlags effects_pipeline_flags;
+  gboolean effects_valid;
+  gboolean effects_settled;
+
   cairo_region_t *clip_region;
   cairo_region_t *unobscured_region;
 };
@@ -222,11 +237,22 @@ set_unobscured_region (MetaBackgroundContent *self,
     }
 }
 
+static void
+free_effects_texture (MetaBackgroundContent *self)
+{
+  g_clear_pointer (&self->effects_fbo, cogl_object_unref);
+  g_clear_pointer (&self->effects_texture, cogl_object_unref);
+  self->effects_valid = FALSE;
+}
+
 static void
 invalidate_pipeline (MetaBackgroundContent *self,
                      ChangedFlags           changed)
 {
   self->changed |= changed;
+
+  self->effects_valid = FALSE;
+  self->effects_settled = FALSE;
 }
 
 static void
@@ -301,17 +327,14 @@ make_pipeline (PipelineFlags pipeline_flags)
 
 static void
 setup_pipeline (MetaBackgroundContent *self,
-                ClutterActor          *actor,
-                ClutterPaintContext   *paint_context,
+                guint8                 opacity,
+                CoglFramebuffer       *fb,
                 cairo_rectangle_int_t *actor_pixel_rect)
 {
   PipelineFlags pipeline_flags = 0;
-  guint8 opacity;
   float color_component;
-  CoglFramebuffer *fb;
   CoglPipelineFilter min_filter, mag_filter;
 
-  opacity = clutter_actor_get_paint_opacity (actor);
   if (opacity < 255)
     pipeline_flags |= PIPELINE_BLEND;
   if (self->vignette && clutter_feature_available (CLUTTER_FEATURE_SHADERS_GLSL))
@@ -408,7 +431,6 @@ setup_pipeline (MetaBackgroundContent *self,
                              color_component,
                              opacity / 255.);
 
-  fb = clutter_paint_context_get_framebuffer (paint_context);
   if (meta_actor_painting_untransformed (fb,
                                          actor_pixel_rect->width,
                                          actor_pixel_rect->height,
@@ -454,31 +476,183 @@ set_glsl_parameters (MetaBackgroundContent *self,
                                    2, 1, offset);
 }
 
+static void
+get_texture_coords (ClutterActorBox       *actor_box,
+                    cairo_rectangle_int_t *texture_area,
+                    cairo_rectangle_int_t *rect,
+                    float                 *tx1,
+                    float                 *ty1,
+                    float                 *tx2,
+                    float                 *ty2)
+{
+  float h_scale, v_scale;
+
+  h_scale = texture_area->width / clutter_actor_box_get_width (actor_box);
+  v_scale = texture_area->height / clutter_actor_box_get_height (actor_box);
+
+  *tx1 = (rect->x * h_scale - texture_area->x) / (float)texture_area->width;
+  *ty1 = (rect->y * v_scale - texture_area->y) / (float)texture_area->height;
+  *tx2 = ((rect->x + rect->width) * h_scale - texture_area->x) / (float)texture_area->width;
+  *ty2 = ((rect->y + rect->height) * v_scale - texture_area->y) / (float)texture_area->height;
+}
+
+static gboolean
+should_prerender_effects (MetaBackgroundContent *self)
+{
+  return ((self->vignette || self->gradient) &&
+          clutter_feature_available (CLUTTER_FEATURE_SHADERS_GLSL));
+}
+
+static CoglTexture *
+ensure_effects_texture (MetaBackgroundContent *self,
+                        ClutterActorBox       *actor_box,
+                        cairo_rectangle_int_t *actor_pixel_rect)
+{
+  cairo_rectangle_int_t effects_area;
+  float tx1, ty1, tx2, ty2;
+  float scale = 1.0;
+  int width, height;
+
+  if (meta_is_stage_views_scaled ())
+    scale = meta_display_get_monitor_scale (self->display, self->monitor);
+
+  width = ceilf (actor_pixel_rect->width * scale);
+  height = ceilf (actor_pixel_rect->height * scale);
+  if (width <= 0 || height <= 0)
+    return NULL;
+
+  if (self->effects_texture &&
+      (cogl_texture_get_width (self->effects_texture) != width ||
+       cogl_texture_get_height (self->effects_texture) != height))
+    {
+      /* Wait for the size to settle as well before rendering again */
+      free_effects_texture (self);
+      self->effects_settled = FALSE;
+      return NULL;
+    }
+
+  if (self->effects_valid)
+    return self->effects_texture;
+
+  if (self->effects_texture == NULL)
+    {
+      GError *catch_error = NULL;
+
+      self->effects_texture = meta_create_texture (width, height,
+                                                   COGL_TEXTURE_COMPONENTS_RGBA,
+                                                   META_TEXTURE_FLAGS_NONE);
+      self->effects_fbo =
+        COGL_FRAMEBUFFER (cogl_offscreen_new_with_texture (self->effects_texture));
+
+      if (!cogl_framebuffer_allocate (self->effects_fbo, &catch_error))
+        {
+          /* Keep painting the effects every frame rather than retrying
+           * the allocation until something changes.
+           */
+          free_effects_texture (self);
+          self->effects_settled = FALSE;
+
+          g_error_free (catch_error);
+          return NULL;
+        }
+    }
+
+  cogl_framebuffer_orthographic (self->effects_fbo, 0, 0,
+                                 actor_pixel_rect->width,
+                                 actor_pixel_rect->height,
+                                 -1., 1.);
+  cogl_framebuffer_clear4f (self->effects_fbo,
+                            COGL_BUFFER_BIT_COLOR,
+                            0.0, 0.0, 0.0, 0.0);
+
+  setup_pipeline (self, 255, self->effects_fbo, actor_pixel_rect);
+  set_glsl_parameters (self, actor_pixel_rect);
+
+  effects_area = *actor_pixel_rect;
+  get_texture_coords (actor_box, &self->texture_area, &effects_area,
+                      &tx1, &ty1, &tx2, &ty2);
+  cogl_framebuffer_draw_textured_rectangle (self->effects_fbo,
+                                            self->pipeline,
+                                            0, 0,
+                                            actor_pixel_rect->width,
+                                            actor_pixel_rect->height,
+                                            tx1, ty1, tx2, ty2);
+
+  self->effects_valid = TRUE;
+
+  return self->effects_texture;
+}
+
+static void
+setup_effects_pipeline (MetaBackgroundContent *self,
+                        guint8                 opacity,
+                        CoglFramebuffer       *fb,
+                        cairo_rectangle_int_t *actor_pixel_rect)
+{
+  PipelineFlags pipeline_flags = 0;
+  CoglPipelineFilter min_filter, mag_filter;
+  int width, height;
+
+  if (opacity < 255)
+    pipeline_flags |= PIPELINE_BLEND;
+
+  if (self->effects_pipeline == NULL ||
+      pipeline_flags != self->effects_pipeline_flags)
+    {
+      g_clear_pointer (&self->effects_pipeline, cogl_object_unref);
+      self->effects_pipeline_flags = pipeline_flags;
+      self->effects_pipeline = make_pipeline (pipeline_flags);
+    }
+
+  cogl_pipeline_set_layer_texture (self->effects_pipeline, 0,
+                                   self->effects_texture);
+  cogl_pipeline_set_layer_wrap_mode (self->effects_pipeline, 0,
+                                     COGL_PIPELINE_WRAP_MODE_CLAMP_TO_EDGE);
+  cogl_pipeline_set_color4ub (self->effects_pipeline,
+                              opacity, opacity, opacity, opacity);
+
+  width = cogl_texture_get_width (self->effects_texture);
+  height = cogl_texture_get_height (self->effects_texture);
+  if (meta_actor_painting_untransformed (fb,
+                                         actor_pixel_rect->width,
+                                         actor_pixel_rect->height,
+                                         width, height,
+                                         NULL, NULL))
+    {
+      min_filter = COGL_PIPELINE_FILTER_NEAREST;
+      mag_filter = COGL_PIPELINE_FILTER_NEAREST;
+    }
+  else
+    {
+      min_filter = COGL_PIPELINE_FILTER_LINEAR;
+      mag_filter = COGL_PIPELINE_FILTER_LINEAR;
+    }
+
+  cogl_pipeline_set_layer_filters (self->effects_pipeline, 0,
+                                   min_filter, mag_filter);
+}
+
 static void
 paint_clipped_rectangle (MetaBackgroundContent *self,
                          ClutterPaintNode      *node,
+                         CoglPipeline          *pipeline,
+                         cairo_rectangle_int_t *texture_area,
                          ClutterActorBox       *actor_box,
                          cairo_rectangle_int_t *rect)
 {
   g_autoptr (ClutterPaintNode) pipeline_node = NULL;
-  float h_scale, v_scale;
   float x1, y1, x2, y2;
   float tx1, ty1, tx2, ty2;
 
-  h_scale = self->texture_area.width / clutter_actor_box_get_width (actor_box);
-  v_scale = self->texture_area.height / clutter_actor_box_get_height (actor_box);
-
   x1 = rect->x;
   y1 = rect->y;
   x2 = rect->x + rect->width;
   y2 = rect->y + rect->height;
 
-  tx1 = (x1 * h_scale - self->texture_area.x) / (float)self->texture_area.width;
-  ty1 = (y1 * v_scale - self->texture_area.y) / (float)self->texture_area.height;
-  tx2 = (x2 * h_scale - self->texture_area.x) / (float)self->texture_area.width;
-  ty2 = (y2 * v_scale - self->texture_area.y) / (float)self->texture_area.height;
+  get_texture_coords (actor_box, texture_area, rect,
+                      &tx1, &ty1, &tx2, &ty2);
 
-  pipeline_node = clutter_pipeline_node_new (self->pipeline);
+  pipeline_node = clutter_pipeline_node_new (pipeline);
   clutter_paint_node_set_name (pipeline_node, "MetaBackgroundContent (Slice)");
   clutter_paint_node_add_texture_rectangle (pipeline_node,
                                             &(ClutterActorBox) {
@@ -507,6 +681,11 @@ meta_background_content_paint_content (ClutterContent      *content,
   int i, n_rects;
   float transformed_x, transformed_y, transformed_width, transformed_height;
   gboolean untransformed;
+  CoglFramebuffer *fb;
+  CoglPipeline *pipeline;
+  cairo_rectangle_int_t texture_area;
+  CoglTexture *effects_texture = NULL;
+  guint8 opacity;
 
   if ((self->clip_region && cairo_region_is_empty (self->clip_region)))
     return;
@@ -588,8 +767,34 @@ meta_background_content_paint_content (ClutterContent      *content,
       return;
     }
 
-  setup_pipeline (self, actor, paint_context, &rect_within_actor);
-  set_glsl_parameters (self, &rect_within_actor);
+  fb = clutter_paint_context_get_framebuffer (paint_context);
+  opacity = clutter_actor_get_paint_opacity (actor);
+
+  if (!should_prerender_effects (self))
+    free_effects_texture (self);
+  else if (self->effects_settled)
+    effects_texture = ensure_effects_texture (self, &actor_box,
+                                              &rect_within_actor);
+
+  if (effects_texture)
+    {
+      setup_effects_pipeline (self, opacity, fb, &rect_within_actor);
+      pipeline = self->effects_pipeline;
+      texture_area = rect_within_actor;
+    }
+  else
+    {
+      setup_pipeline (self, opacity, fb, &rect_within_actor);
+      set_glsl_parameters (self, &rect_within_actor);
+      pipeline = self->pipeline;
+      texture_area = self->texture_area;
+
+      /* Effects are only rendered into a texture if nothing changed
+       * since the previous paint, so animating them doesn't cost an
+       * extra pass per frame.
+       */
+      self->effects_settled = TRUE;
+    }
 
   /* Limit to how many separate rectangles we'll draw; beyond this just
    * fall back and draw the whole thing */
@@ -602,14 +807,16 @@ meta_background_content_paint_content (ClutterContent      *content,
         {
           cairo_rectangle_int_t rect;
           cairo_region_get_rectangle (region, i, &rect);
-          paint_clipped_rectangle (self, node, &actor_box, &rect);
+          paint_clipped_rectangle (self, node, pipeline, &texture_area,
+                                   &actor_box, &rect);
         }
     }
   else
     {
       cairo_rectangle_int_t rect;
       cairo_region_get_extents (region, &rect);
-      paint_clipped_rectangle (self, node, &actor_box, &rect);
+      paint_clipped_rectangle (self, node, pipeline, &texture_area,
+                               &actor_box, &rect);
     }
 
   cairo_region_destroy (region);
@@ -660,6 +867,10 @@ set_monitor (MetaBackgroundContent *self,
   if(old_monitor_geometry.height != new_monitor_geometry.height)
       invalidate_pipeline (self, CHANGED_GRADIENT_PARAMETERS);
 
+  /* The monitor scale decides the size of the prerendered effects */
+  free_effects_texture (self);
+  self->effects_settled = FALSE;
+
   self->monitor = monitor;
 }
 
@@ -673,6 +884,8 @@ meta_background_content_dispose (GObject *object)
   meta_background_content_set_background (self, NULL);
 
   g_clear_pointer (&self->pipeline, cogl_object_unref);
+  g_clear_pointer (&self->effects_pipeline, cogl_object_unref);
+  free_effects_texture (self);
 
   G_OBJECT_CLASS (meta_background_content_parent_class)->dispose (object);
 }
@@ -0,0 +1,13 @@
+/* -*- mode: C; c-file-style: "gnu"; indent-tabs-mode: nil; -*- */
+
+#ifndef META_BACKGROUND_IMAGE_PRIVATE_H
+#define META_BACKGROUND_IMAGE_PRIVATE_H
+
+#include "meta/meta-background-image.h"
+
+MetaBackgroundImage *meta_background_image_cache_load_at_size (MetaBackgroundImageCache *cache,
+                                                               GFile                    *file,
+                                                               int                       width,
+                                                               int                       height);
+
+#endif /* META_BACKGROUND_IMAGE_PRIVATE_H */
@@ -24,10 +24,11 @@
 
 #include "config.h"
 
-#include "meta/meta-background-image.h"
+#include "compositor/meta-background-image-private.h"
 
 #include <gdk-pixbuf/gdk-pixbuf.h>
 #include <gio/gio.h>
+#include <math.h>
 
 #include "clutter/clutter.h"
 #include "compositor/cogl-utils.h"
@@ -63,6 +64,8 @@ struct _MetaBackgroundImage
 {
   GObject parent_instance;
   GFile *file;
+  char *key;
+  int width, height;
   MetaBackgroundImageCache *cache;
   gboolean in_cache;
   gboolean loaded;
@@ -74,7 +77,7 @@ G_DEFINE_TYPE (MetaBackgroundImageCache, meta_background_image_cache, G_TYPE_OBJ
 static void
 meta_background_image_cache_init (MetaBackgroundImageCache *cache)
 {
-  cache->images = g_hash_table_new (g_file_hash, (GEqualFunc) g_file_equal);
+  cache->images = g_hash_table_new (g_str_hash, g_str_equal);
 }
 
 static void
@@ -120,6 +123,89 @@ meta_background_image_cache_get_default (void)
   return cache;
 }
 
+static char *
+make_cache_key (GFile *file,
+                int    width,
+                int    height)
+{
+  g_autofree char *uri = g_file_get_uri (file);
+
+  if (width <= 0 || height <= 0)
+    return g_steal_pointer (&uri);
+
+  return g_strdup_printf ("%s@%dx%d", uri, width, height);
+}
+
+static void
+on_size_prepared (GdkPixbufLoader     *loader,
+                  int                  width,
+                  int                  height,
+                  MetaBackgroundImage *image)
+{
+  int target_size, shortest_side;
+  double scale;
+
+  /* The embedded orientation is only applied once the image has been
+   * decoded, so we don't know yet which side ends up horizontal; make
+   * the shortest side cover the largest requested dimension so that
+   * either orientation still covers the requested area.
+   */
+  target_size = MAX (image->width, image->height);
+  shortest_side = MIN (width, height);
+  if (shortest_side <= target_size)
+    return;
+
+  scale = target_size / (double) shortest_side;
+  gdk_pixbuf_loader_set_size (loader,
+                              (int) ceil (width * scale),
+                              (int) ceil (height * scale));
+}
+
+static GdkPixbuf *
+load_pixbuf_at_size (MetaBackgroundImage  *image,
+                     GInputStream         *stream,
+                     GCancellable         *cancellable,
+                     GError              **error)
+{
+  g_autoptr (GdkPixbufLoader) loader = NULL;
+  guchar buffer[64 * 1024];
+  gssize n_read;
+  GdkPixbuf *pixbuf;
+
+  loader = gdk_pixbuf_loader_new ();
+  g_signal_connect (loader, "size-prepared",
+                    G_CALLBACK (on_size_prepared), image);
+
+  while ((n_read = g_input_stream_read (stream, buffer, sizeof (buffer),
+                                        cancellable, error)) > 0)
+    {
+      if (!gdk_pixbuf_loader_write (loader, buffer, n_read, error))
+        {
+          gdk_pixbuf_loader_close (loader, NULL);
+          return NULL;
+        }
+    }
+
+  if (n_read < 0)
+    {
+      gdk_pixbuf_loader_close (loader, NULL);
+      return NULL;
+    }
+
+  if (!gdk_pixbuf_loader_close (loader, error))
+    return NULL;
+
+  pixbuf = gdk_pixbuf_loader_get_pixbuf (loader);
+  if (pixbuf == NULL)
+    {
+      g_set_error (error, GDK_PIXBUF_ERROR, GDK_PIXBUF_ERROR_FAILED,
+                   "Image loader did not produce an image");
+      return NULL;
+    }
+
+  return g_object_ref (pixbuf);
+}
+
 static void
 load_file (GTask               *task,
            MetaBackgroundImage *image,
@@ -137,7 +223,16 @@ load_file (GTask               *task,
       return;
     }
 
-  pixbuf = gdk_pixbuf_new_from_stream (G_INPUT_STREAM (stream), NULL, &error);
+  /* Decoding straight to the size the image will be displayed at avoids
+   * holding on to, and uploading, a full resolution copy of very large
+   * wallpapers; JPEG in particular can skip most of the work when
+   * decoding at a fraction of the original size.
+   */
+  if (image->width > 0 && image->height > 0)
+    pixbuf = load_pixbuf_at_size (image, G_INPUT_STREAM (stream),
+                                  cancellable, &error);
+  else
+    pixbuf = gdk_pixbuf_new_from_stream (G_INPUT_STREAM (stream), NULL, &error);
   g_object_unref (stream);
 
   if (pixbuf == NULL)
@@ -233,22 +328,68 @@ out:
 MetaBackgroundImage *
 meta_background_image_cache_load (MetaBackgroundImageCache *cache,
                                   GFile                    *file)
+{
+  g_return_val_if_fail (META_IS_BACKGROUND_IMAGE_CACHE (cache), NULL);
+  g_return_val_if_fail (file != NULL, NULL);
+
+  return meta_background_image_cache_load_at_size (cache, file, 0, 0);
+}
+
+/*
+ * meta_background_image_cache_load_at_size:
+ * @cache: a #MetaBackgroundImageCache
+ * @file: #GFile to load
+ * @width: width the image will at most be displayed at, or 0
+ * @height: height the image will at most be displayed at, or 0
+ *
+ * Like meta_background_image_cache_load(), but images larger than
+ * @width x @height are decoded at a reduced size that still covers that
+ * area. Passing 0 loads the image at its natural size. An image already
+ * loaded at its natural size is shared rather than decoded again.
+ *
+ * Return value: (transfer full): a #MetaBackgroundImage
+ */
+MetaBackgroundImage *
+meta_background_image_cache_load_at_size (MetaBackgroundImageCache *cache,
+                                          GFile                    *file,
+                                          int                       width,
+                                          int                       height)
 {
   MetaBackgroundImage *image;
   GTask *task;
+  char *key;
 
   g_return_val_if_fail (META_IS_BACKGROUND_IMAGE_CACHE (cache), NULL);
   g_return_val_if_fail (file != NULL, NULL);
 
-  image = g_hash_table_lookup (cache->images, file);
+  if (width <= 0 || height <= 0)
+    width = height = 0;
+
+  if (width > 0)
+    {
+      g_autofree char *natural_key = make_cache_key (file, 0, 0);
+
+      image = g_hash_table_lookup (cache->images, natural_key);
+      if (image != NULL)
+        return g_object_ref (image);
+    }
+
+  key = make_cache_key (file, width, height);
+  image = g_hash_table_lookup (cache->images, key);
   if (image != NULL)
-    return g_object_ref (image);
+    {
+      g_free (key);
+      return g_object_ref (image);
+    }
 
   image = g_object_new (META_TYPE_BACKGROUND_IMAGE, NULL);
   image->cache = cache;
   image->in_cache = TRUE;
   image->file = g_object_ref (file);
-  g_hash_table_insert (cache->images, image->file, image);
+  image->key = key;
+  image->width = width;
+  image->height = height;
+  g_hash_table_insert (cache->images, image->key, image);
 
   task = g_task_new (image, NULL, file_loaded, NULL);
 
@@ -270,17 +411,24 @@ void
 meta_background_image_cache_purge (MetaBackgroundImageCache *cache,
                                    GFile                    *file)
 {
-  MetaBackgroundImage *image;
+  GHashTableIter iter;
+  gpointer value;
 
   g_return_if_fail (META_IS_BACKGROUND_IMAGE_CACHE (cache));
   g_return_if_fail (file != NULL);
 
-  image = g_hash_table_lookup (cache->images, file);
-  if (image == NULL)
-    return;
+  /* The same file may be cached at several sizes */
+  g_hash_table_iter_init (&iter, cache->images);
+  while (g_hash_table_iter_next (&iter, NULL, &value))
+    {
+      MetaBackgroundImage *image = value;
 
-  g_hash_table_remove (cache->images, image->file);
-  image->in_cache = FALSE;
+      if (!g_file_equal (image->file, file))
+        continue;
+
+      g_hash_table_iter_remove (&iter);
+      image->in_cache = FALSE;
+    }
 }
 
 G_DEFINE_TYPE (MetaBackgroundImage, meta_background_image, G_TYPE_OBJECT);
@@ -296,12 +444,13 @@ meta_background_image_finalize (GObject *object)
   MetaBackgroundImage *image = META_BACKGROUND_IMAGE (object);
 
   if (image->in_cache)
-    g_hash_table_remove (image->cache->images, image->file);
+    g_hash_table_remove (image->cache->images, image->key);
 
   if (image->texture)
     cogl_object_unref (image->texture);
   if (image->file)
     g_object_unref (image->file);
+  g_free (image->key);
 
   G_OBJECT_CLASS (meta_background_image_parent_class)->finalize (object);
 }
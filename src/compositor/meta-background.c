@@ -21,12 +21,13 @@
 
 #include "compositor/meta-background-private.h"
 
+#include <math.h>
 #include <string.h>
 
 #include "backends/meta-backend-private.h"
 #include "compositor/cogl-utils.h"
+#include "compositor/meta-background-image-private.h"
 #include "meta/display.h"
-#include "meta/meta-background-image.h"
 #include "meta/meta-background.h"
 #include "meta/meta-monitor-manager.h"
 #include "meta/util.h"
@@ -71,6 +72,10 @@ struct _MetaBackground
 
   float blend_factor;
 
+  /* Size the images were requested at, 0 for their natural size */
+  int image_width;
+  int image_height;
+
   guint wallpaper_allocation_failed : 1;
 };
 
@@ -83,6 +88,11 @@ enum
 G_DEFINE_TYPE (MetaBackground, meta_background, G_TYPE_OBJECT)
 
 static gboolean texture_has_alpha (CoglTexture *texture);
+static void set_file (MetaBackground       *self,
+                      GFile               **filep,
+                      MetaBackgroundImage **imagep,
+                      GFile                *file,
+                      gboolean              force_reload);
 
 static GSList *all_backgrounds = NULL;
 
@@ -149,10 +159,92 @@ invalidate_monitor_backgrounds (MetaBackground *self)
     }
 }
 
+static void
+get_image_target_size (MetaBackground *self,
+                       int            *width,
+                       int            *height)
+{
+  float max_scale = 1.0;
+  int i, n_monitors;
+
+  *width = 0;
+  *height = 0;
+
+  if (!self->display)
+    return;
+
+  n_monitors = meta_display_get_n_monitors (self->display);
+
+  switch (self->style)
+    {
+    case G_DESKTOP_BACKGROUND_STYLE_STRETCHED:
+    case G_DESKTOP_BACKGROUND_STYLE_SCALED:
+    case G_DESKTOP_BACKGROUND_STYLE_ZOOM:
+      /* The image is scaled to each monitor, so it never needs more pixels
+       * than the largest monitor has.
+       */
+      for (i = 0; i < n_monitors; i++)
+        {
+          MetaRectangle geometry;
+          float scale;
+
+          meta_display_get_monitor_geometry (self->display, i, &geometry);
+          scale = meta_display_get_monitor_scale (self->display, i);
+
+          *width = MAX (*width, (int) ceilf (geometry.width * scale));
+          *height = MAX (*height, (int) ceilf (geometry.height * scale));
+        }
+      break;
+    case G_DESKTOP_BACKGROUND_STYLE_SPANNED:
+      for (i = 0; i < n_monitors; i++)
+        max_scale = MAX (max_scale,
+                         meta_display_get_monitor_scale (self->display, i));
+
+      meta_display_get_size (self->display, width, height);
+      *width = ceilf (*width * max_scale);
+      *height = ceilf (*height * max_scale);
+      break;
+    default:
+      /* Wallpaper and centered images are drawn at their natural size */
+      break;
+    }
+}
+
+static gboolean
+image_size_covers (int image_width,
+                   int image_height,
+                   int width,
+                   int height)
+{
+  if (image_width == 0 || image_height == 0)
+    return TRUE;
+
+  if (width == 0 || height == 0)
+    return FALSE;
+
+  return width <= image_width && height <= image_height;
+}
+
 static void
 on_monitors_changed (MetaBackground *self)
 {
+  int width, height;
+
   invalidate_monitor_backgrounds (self);
+
+  /* Only reload when the images are now too small; keeping a larger
+   * image around is cheaper than decoding it again.
+   */
+  get_image_target_size (self, &width, &height);
+  if (!image_size_covers (self->image_width, self->image_height,
+                          width, height))
+    {
+      self->image_width = width;
+      self->image_height = height;
+
+      set_file (self, &self->file1, &self->background_image1, self->file1, TRUE);
+      set_file (self, &self->file2, &self->background_image2, self->file2, TRUE);
+    }
 }
 
 static void
@@ -273,7 +365,9 @@ set_file (MetaBackground       *self,
         {
           MetaBackgroundImageCache *cache = meta_background_image_cache_get_default ();
 
-          *imagep = meta_background_image_cache_load (cache, file);
+          *imagep = meta_background_image_cache_load_at_size (cache, file,
+                                                              self->image_width,
+                                                              self->image_height);
           g_signal_connect (*imagep, "loaded",
                             G_CALLBACK (on_background_loaded), self);
         }
@@ -1015,15 +1109,24 @@ meta_background_set_blend (MetaBackground          *self,
                            double                   blend_factor,
                            GDesktopBackgroundStyle  style)
 {
+  int image_width, image_height;
+  gboolean size_changed;
+
   g_return_if_fail (META_IS_BACKGROUND (self));
   g_return_if_fail (blend_factor >= 0.0 && blend_factor <= 1.0);
 
-  set_file (self, &self->file1, &self->background_image1, file1, FALSE);
-  set_file (self, &self->file2, &self->background_image2, file2, FALSE);
-
   self->blend_factor = blend_factor;
   self->style = style;
 
+  get_image_target_size (self, &image_width, &image_height);
+  size_changed = (image_width != self->image_width ||
+                  image_height != self->image_height);
+  self->image_width = image_width;
+  self->image_height = image_height;
+
+  set_file (self, &self->file1, &self->background_image1, file1, size_changed);
+  set_file (self, &self->file2, &self->background_image2, file2, size_changed);
+
   free_wallpaper_texture (self);
   mark_changed (self);
 }
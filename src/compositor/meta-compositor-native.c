@@ -24,6 +24,7 @@
 
 #include "backends/meta-logical-monitor.h"
 #include "compositor/meta-surface-actor-wayland.h"
+#include "compositor/meta-window-actor-x11.h"
 
 struct _MetaCompositorNative
 {
@@ -45,6 +46,10 @@ get_window_view (MetaRenderer *renderer,
       ClutterStageView *stage_view = l->data;
       MetaRectangle view_layout;
 
+      if (meta_renderer_is_virtual_view (renderer,
+                                         META_RENDERER_VIEW (stage_view)))
+        continue;
+
       clutter_stage_view_get_layout (stage_view, &view_layout);
 
       if (meta_rectangle_equal (&window->buffer_rect,
@@ -105,6 +110,10 @@ maybe_assign_primary_plane (MetaCompositor *compositor)
   if (!META_IS_SURFACE_ACTOR_WAYLAND (surface_actor))
     return;
 
+  if (META_IS_WINDOW_ACTOR_X11 (window_actor) &&
+      !meta_window_actor_x11_can_scanout (META_WINDOW_ACTOR_X11 (window_actor)))
+    return;
+
   surface_actor_wayland = META_SURFACE_ACTOR_WAYLAND (surface_actor);
   onscreen = COGL_ONSCREEN (framebuffer);
   scanout = meta_surface_actor_wayland_try_acquire_scanout (surface_actor_wayland,
@@ -25,6 +25,7 @@
 
 #include "compositor/clutter-utils.h"
 #include "compositor/meta-cullable.h"
+#include "compositor/region-utils.h"
 
 G_DEFINE_INTERFACE (MetaCullable, meta_cullable, CLUTTER_TYPE_ACTOR);
 
@@ -44,6 +45,122 @@ has_active_effects (ClutterActor *actor)
   return FALSE;
 }
 
+/* Checks whether @child is only scaled along the axes and translated
+ * relative to @parent, in which case the regions can be converted into its
+ * coordinate space.
+ */
+static gboolean
+get_axis_aligned_child_transform (ClutterActor *parent,
+                                  ClutterActor *child,
+                                  float        *x_origin,
+                                  float        *y_origin,
+                                  float        *x_scale,
+                                  float        *y_scale)
+{
+  ClutterActorBox box;
+  graphene_point3d_t verts[4];
+  ClutterMatrix child_transform;
+  float width, height;
+  int i;
+
+  /* Cullables like MetaSurfaceActor account for the child transform of
+   * their parent themselves, so the regions passed to them are in the
+   * coordinate space of the parent before the child transform. */
+  clutter_actor_get_child_transform (parent, &child_transform);
+  if (!cogl_matrix_is_identity (&child_transform))
+    return FALSE;
+
+  clutter_actor_get_allocation_box (child, &box);
+  clutter_actor_box_get_size (&box, &width, &height);
+
+  verts[0] = GRAPHENE_POINT3D_INIT (0, 0, 0);
+  verts[1] = GRAPHENE_POINT3D_INIT (width, 0, 0);
+  verts[2] = GRAPHENE_POINT3D_INIT (0, height, 0);
+  verts[3] = GRAPHENE_POINT3D_INIT (width, height, 0);
+
+  for (i = 0; i < 4; i++)
+    clutter_actor_apply_relative_transform_to_point (child, parent,
+                                                     &verts[i], &verts[i]);
+
+  return meta_actor_vertices_are_axis_aligned (verts, width, height,
+                                               x_origin, y_origin,
+                                               x_scale, y_scale);
+}
+
+/* Subtracts the part of @region_in_child that @culled_region_in_child no
+ * longer contains, converted back into the coordinate space of the parent,
+ * from @region. Only pixels that are fully covered are subtracted. */
+static void
+subtract_culled_region (cairo_region_t *region,
+                        cairo_region_t *region_in_child,
+                        cairo_region_t *culled_region_in_child,
+                        float           x_origin,
+                        float           y_origin,
+                        float           x_scale,
+                        float           y_scale)
+{
+  cairo_region_t *obscured_region;
+
+  cairo_region_subtract (region_in_child, culled_region_in_child);
+  if (cairo_region_is_empty (region_in_child))
+    return;
+
+  obscured_region =
+    meta_region_scale_and_translate_double (region_in_child,
+                                            x_scale, y_scale,
+                                            x_origin, y_origin,
+                                            META_ROUNDING_STRATEGY_SHRINK);
+  cairo_region_subtract (region, obscured_region);
+  meta_region_pool_release (obscured_region);
+}
+
+static void
+cull_out_scaled_child (MetaCullable   *child,
+                       cairo_region_t *unobscured_region,
+                       cairo_region_t *clip_region,
+                       float           x_origin,
+                       float           y_origin,
+                       float           x_scale,
+                       float           y_scale)
+{
+  cairo_region_t *child_unobscured_region;
+  cairo_region_t *child_clip_region;
+  cairo_region_t *culled_unobscured_region;
+  cairo_region_t *culled_clip_region;
+
+  /* Grow the regions when moving into the coordinate space of the child,
+   * so that it still paints every pixel it partially covers. */
+  child_unobscured_region =
+    meta_region_scale_and_translate_double (unobscured_region,
+                                            1.0 / x_scale, 1.0 / y_scale,
+                                            -x_origin / x_scale,
+                                            -y_origin / y_scale,
+                                            META_ROUNDING_STRATEGY_GROW);
+  child_clip_region =
+    meta_region_scale_and_translate_double (clip_region,
+                                            1.0 / x_scale, 1.0 / y_scale,
+                                            -x_origin / x_scale,
+                                            -y_origin / y_scale,
+                                            META_ROUNDING_STRATEGY_GROW);
+  culled_unobscured_region = cairo_region_copy (child_unobscured_region);
+  culled_clip_region = cairo_region_copy (child_clip_region);
+
+  meta_cullable_cull_out (child, culled_unobscured_region, culled_clip_region);
+
+  subtract_culled_region (unobscured_region,
+                          child_unobscured_region, culled_unobscured_region,
+                          x_origin, y_origin, x_scale, y_scale);
+  subtract_culled_region (clip_region,
+                          child_clip_region, culled_clip_region,
+                          x_origin, y_origin, x_scale, y_scale);
+
+  meta_region_pool_release (child_unobscured_region);
+  meta_region_pool_release (child_clip_region);
+  /* Cullables may keep a reference to the regions they were culled with */
+  cairo_region_destroy (culled_unobscured_region);
+  cairo_region_destroy (culled_clip_region);
+}
+
 /**
  * SECTION:meta-cullable
  * @title: MetaCullable
@@ -61,6 +178,10 @@ has_active_effects (ClutterActor *actor)
  * and ask each actor to "cull itself out". We pass in a region it can copy
  * to clip its drawing to, and the actor can subtract its fully opaque pixels
  * so that actors underneath know not to draw there as well.
+ *
+ * Children that are scaled along the axes relative to their parent are
+ * culled too; the regions are then rounded conservatively, growing what a
+ * child may paint and shrinking what it obscures.
  */
 
 /**
@@ -87,6 +208,7 @@ meta_cullable_cull_out_children (MetaCullable   *cullable,
   while (clutter_actor_iter_prev (&iter, &child))
     {
       float x, y;
+      float x_scale, y_scale;
       gboolean needs_culling;
 
       if (!META_IS_CULLABLE (child))
@@ -116,10 +238,8 @@ meta_cullable_cull_out_children (MetaCullable   *cullable,
       if (needs_culling && has_active_effects (child))
         needs_culling = FALSE;
 
-      if (needs_culling && !meta_cullable_is_untransformed (META_CULLABLE (child)))
-        needs_culling = FALSE;
-
-      if (needs_culling)
+      if (needs_culling &&
+          meta_cullable_is_untransformed (META_CULLABLE (child)))
         {
           clutter_actor_get_position (child, &x, &y);
 
@@ -132,6 +252,15 @@ meta_cullable_cull_out_children (MetaCullable   *cullable,
           cairo_region_translate (unobscured_region, x, y);
           cairo_region_translate (clip_region, x, y);
         }
+      else if (needs_culling &&
+               get_axis_aligned_child_transform (actor, child,
+                                                 &x, &y,
+                                                 &x_scale, &y_scale))
+        {
+          cull_out_scaled_child (META_CULLABLE (child),
+                                 unobscured_region, clip_region,
+                                 x, y, x_scale, y_scale);
+        }
       else
         {
           meta_cullable_cull_out (META_CULLABLE (child), NULL, NULL);
@@ -55,6 +55,7 @@ void meta_shaped_texture_reset_viewport_dst_size (MetaShapedTexture *stex);
 void meta_shaped_texture_set_buffer_scale (MetaShapedTexture *stex,
                                            int                buffer_scale);
 int meta_shaped_texture_get_buffer_scale (MetaShapedTexture *stex);
+CoglTexture * meta_shaped_texture_get_untransformed_texture (MetaShapedTexture *stex);
 
 gboolean meta_shaped_texture_update_area (MetaShapedTexture     *stex,
                                           int                    x,
@@ -71,4 +72,9 @@ void meta_shaped_texture_set_clip_region (MetaShapedTexture *stex,
 void meta_shaped_texture_set_opaque_region (MetaShapedTexture *stex,
                                             cairo_region_t    *opaque_region);
 
+void meta_shaped_texture_get_memory_usage (MetaShapedTexture *stex,
+                                           size_t            *cache_size,
+                                           size_t            *texture_size);
+void meta_shaped_texture_release_caches (MetaShapedTexture *stex);
+
 #endif
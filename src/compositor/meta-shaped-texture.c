@@ -1144,6 +1144,42 @@ meta_shaped_texture_get_texture (MetaShapedTexture *stex)
   return COGL_TEXTURE (stex->texture);
 }
 
+/*
+ * meta_shaped_texture_get_memory_usage:
+ * @stex: a #MetaShapedTexture
+ * @cache_size: (out): return location for the size of the scaled down
+ *   copies kept for painting
+ * @texture_size: (out): return location for the size of the texture
+ *
+ * Estimates the texture memory, in bytes, used by @stex.
+ */
+void
+meta_shaped_texture_get_memory_usage (MetaShapedTexture *stex,
+                                      size_t            *cache_size,
+                                      size_t            *texture_size)
+{
+  *cache_size = meta_texture_tower_get_levels_size (stex->paint_tower);
+
+  if (stex->texture)
+    *texture_size = ((size_t) cogl_texture_get_width (stex->texture) *
+                     cogl_texture_get_height (stex->texture) * 4);
+  else
+    *texture_size = 0;
+}
+
+/*
+ * meta_shaped_texture_release_caches:
+ * @stex: a #MetaShapedTexture
+ *
+ * Frees the scaled down copies of the texture; they are recreated when
+ * painting needs them again.
+ */
+void
+meta_shaped_texture_release_caches (MetaShapedTexture *stex)
+{
+  meta_texture_tower_release_levels (stex->paint_tower);
+}
+
 /**
  * meta_shaped_texture_set_opaque_region:
  * @stex: a #MetaShapedTexture
@@ -1624,6 +1660,36 @@ meta_shaped_texture_get_buffer_scale (MetaShapedTexture *stex)
   return stex->buffer_scale;
 }
 
+/**
+ * meta_shaped_texture_get_untransformed_texture: (skip)
+ * @stex: A #MetaShapedTexture
+ *
+ * Returns the texture of @stex if painting it is equivalent to a plain copy,
+ * i.e. there is no buffer transform, viewport, mask or shader snippet applied
+ * to it.
+ *
+ * Returns: (nullable) (transfer none): the texture, or %NULL
+ */
+CoglTexture *
+meta_shaped_texture_get_untransformed_texture (MetaShapedTexture *stex)
+{
+  g_return_val_if_fail (META_IS_SHAPED_TEXTURE (stex), NULL);
+
+  if (!stex->texture)
+    return NULL;
+
+  if (stex->mask_texture || stex->snippet || !stex->is_y_inverted)
+    return NULL;
+
+  if (stex->has_viewport_src_rect || stex->has_viewport_dst_size)
+    return NULL;
+
+  if (stex->transform != META_MONITOR_TRANSFORM_NORMAL)
+    return NULL;
+
+  return COGL_TEXTURE (stex->texture);
+}
+
 /**
  * meta_shaped_texture_get_width:
  * @stex: A #MetaShapedTexture
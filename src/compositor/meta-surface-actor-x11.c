@@ -50,6 +50,9 @@ struct _MetaSurfaceActorX11
   Pixmap pixmap;
   Damage damage;
 
+  /* Scaled down copy shown instead of the pixmap while hidden */
+  CoglTexture *snapshot;
+
   int last_width;
   int last_height;
 
@@ -68,6 +71,8 @@ G_DEFINE_TYPE (MetaSurfaceActorX11,
                meta_surface_actor_x11,
                META_TYPE_SURFACE_ACTOR)
 
+#define SNAPSHOT_SCALE_DOWN 4
+
 static void
 free_damage (MetaSurfaceActorX11 *self)
 {
@@ -112,6 +117,19 @@ detach_pixmap (MetaSurfaceActorX11 *self)
   g_clear_pointer (&self->texture, cogl_object_unref);
 }
 
+static void
+clear_snapshot (MetaSurfaceActorX11 *self)
+{
+  MetaShapedTexture *stex = meta_surface_actor_get_texture (META_SURFACE_ACTOR (self));
+
+  if (!self->snapshot)
+    return;
+
+  meta_shaped_texture_set_texture (stex, NULL);
+  meta_shaped_texture_reset_viewport_dst_size (stex);
+  g_clear_pointer (&self->snapshot, cogl_object_unref);
+}
+
 static void
 set_pixmap (MetaSurfaceActorX11 *self,
             Pixmap               pixmap)
@@ -124,6 +142,8 @@ set_pixmap (MetaSurfaceActorX11 *self,
   g_assert (self->pixmap == None);
   self->pixmap = pixmap;
 
+  clear_snapshot (self);
+
   texture = COGL_TEXTURE (cogl_texture_pixmap_x11_new (ctx, self->pixmap, FALSE, &error));
 
   if (error != NULL)
@@ -235,6 +255,109 @@ meta_surface_actor_x11_handle_updates (MetaSurfaceActorX11 *self)
       self->received_damage = FALSE;
     }
 
+  /* Naming the pixmap of an unmapped window fails after a round trip;
+   * keep showing the snapshot until the window is shown again.
+   */
+  if (self->snapshot && !clutter_actor_is_mapped (CLUTTER_ACTOR (self)))
+    return;
+
+  update_pixmap (self);
+}
+
+/*
+ * meta_surface_actor_x11_replace_with_snapshot:
+ * @self: a #MetaSurfaceActorX11
+ *
+ * Replaces the window pixmap with a scaled down copy of its contents,
+ * releasing the pixmap and its texture. The pixmap is named again once
+ * the surface is mapped.
+ *
+ * Returns: %TRUE if the pixmap was replaced
+ */
+gboolean
+meta_surface_actor_x11_replace_with_snapshot (MetaSurfaceActorX11 *self)
+{
+  CoglContext *ctx = clutter_backend_get_cogl_context (clutter_get_default_backend ());
+  MetaShapedTexture *stex = meta_surface_actor_get_texture (META_SURFACE_ACTOR (self));
+  g_autoptr (GError) error = NULL;
+  CoglOffscreen *offscreen;
+  CoglFramebuffer *fb;
+  CoglPipeline *pipeline;
+  CoglTexture *snapshot;
+  int width, height;
+  int snapshot_width, snapshot_height;
+
+  if (self->pixmap == None || self->unredirected || !self->texture)
+    return FALSE;
+
+  width = cogl_texture_get_width (self->texture);
+  height = cogl_texture_get_height (self->texture);
+  snapshot_width = MAX (1, width / SNAPSHOT_SCALE_DOWN);
+  snapshot_height = MAX (1, height / SNAPSHOT_SCALE_DOWN);
+
+  snapshot = COGL_TEXTURE (cogl_texture_2d_new_with_size (ctx,
+                                                          snapshot_width,
+                                                          snapshot_height));
+  cogl_texture_set_components (snapshot,
+                               cogl_texture_get_components (self->texture));
+
+  offscreen = cogl_offscreen_new_with_texture (snapshot);
+  fb = COGL_FRAMEBUFFER (offscreen);
+  if (!cogl_framebuffer_allocate (fb, &error))
+    {
+      g_warning ("Failed to allocate window snapshot: %s", error->message);
+      cogl_object_unref (offscreen);
+      cogl_object_unref (snapshot);
+      return FALSE;
+    }
+
+  cogl_framebuffer_orthographic (fb, 0, 0,
+                                 snapshot_width, snapshot_height,
+                                 -1., 1.);
+
+  pipeline = cogl_pipeline_new (ctx);
+  cogl_pipeline_set_blend (pipeline, "RGBA = ADD (SRC_COLOR, 0)", NULL);
+  cogl_pipeline_set_layer_texture (pipeline, 0, self->texture);
+  cogl_pipeline_set_layer_filters (pipeline, 0,
+                                   COGL_PIPELINE_FILTER_LINEAR,
+                                   COGL_PIPELINE_FILTER_LINEAR);
+  cogl_framebuffer_draw_rectangle (fb, pipeline,
+                                   0, 0,
+                                   snapshot_width, snapshot_height);
+  cogl_object_unref (pipeline);
+  cogl_object_unref (offscreen);
+
+  /* Flushes the snapshot rendering before the pixmap is freed */
+  detach_pixmap (self);
+
+  self->snapshot = snapshot;
+  meta_shaped_texture_set_viewport_dst_size (stex,
+                                             width / meta_shaped_texture_get_buffer_scale (stex),
+                                             height / meta_shaped_texture_get_buffer_scale (stex));
+  meta_shaped_texture_set_texture (stex, snapshot);
+
+  return TRUE;
+}
+
+gboolean
+meta_surface_actor_x11_has_snapshot (MetaSurfaceActorX11 *self)
+{
+  return self->snapshot != NULL;
+}
+
+/*
+ * meta_surface_actor_x11_restore_from_snapshot:
+ * @self: a #MetaSurfaceActorX11
+ *
+ * Names the window pixmap again if it was replaced with a snapshot and the
+ * surface is mapped, without processing any pending damage.
+ */
+void
+meta_surface_actor_x11_restore_from_snapshot (MetaSurfaceActorX11 *self)
+{
+  if (!self->snapshot || !clutter_actor_is_mapped (CLUTTER_ACTOR (self)))
+    return;
+
   update_pixmap (self);
 }
 
@@ -309,6 +432,7 @@ static void
 release_x11_resources (MetaSurfaceActorX11 *self)
 {
   detach_pixmap (self);
+  clear_snapshot (self);
   free_damage (self);
 }
 
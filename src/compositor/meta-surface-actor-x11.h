@@ -57,6 +57,12 @@ gboolean meta_surface_actor_x11_is_visible (MetaSurfaceActorX11 *self);
 
 void meta_surface_actor_x11_handle_updates (MetaSurfaceActorX11 *self);
 
+gboolean meta_surface_actor_x11_replace_with_snapshot (MetaSurfaceActorX11 *self);
+
+gboolean meta_surface_actor_x11_has_snapshot (MetaSurfaceActorX11 *self);
+
+void meta_surface_actor_x11_restore_from_snapshot (MetaSurfaceActorX11 *self);
+
 G_END_DECLS
 
 #endif /* __META_SURFACE_ACTOR_X11_H__ */
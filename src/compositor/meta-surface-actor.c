@@ -90,6 +90,9 @@ get_scaled_region (MetaSurfaceActor     *surface_actor,
   window_actor = meta_window_actor_from_actor (CLUTTER_ACTOR (surface_actor));
   geometry_scale = meta_window_actor_get_geometry_scale (window_actor);
 
+  if (geometry_scale == 1)
+    return cairo_region_copy (region);
+
   clutter_actor_get_position (CLUTTER_ACTOR (surface_actor), &x, &y);
   cairo_region_translate (region, x, y);
 
@@ -289,6 +292,11 @@ meta_surface_actor_cull_out (MetaCullable   *cullable,
   set_unobscured_region (surface_actor, unobscured_region);
   set_clip_region (surface_actor, clip_region);
 
+  /* Nothing left to obscure for the actors below */
+  if ((!unobscured_region || cairo_region_is_empty (unobscured_region)) &&
+      (!clip_region || cairo_region_is_empty (clip_region)))
+    return;
+
   if (opacity == 0xff)
     {
       cairo_region_t *opaque_region;
@@ -308,7 +316,7 @@ meta_surface_actor_cull_out (MetaCullable   *cullable,
       if (clip_region)
         cairo_region_subtract (clip_region, scaled_opaque_region);
 
-      cairo_region_destroy (scaled_opaque_region);
+      meta_region_pool_release (scaled_opaque_region);
     }
 }
 
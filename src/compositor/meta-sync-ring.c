@@ -37,6 +37,14 @@
 #include <GL/glx.h>
 #include <X11/extensions/sync.h>
 
+#ifdef HAVE_XSHMFENCE
+#include <stdlib.h>
+#include <unistd.h>
+#include <X11/Xlib-xcb.h>
+#include <X11/xshmfence.h>
+#include <xcb/dri3.h>
+#endif
+
 #include "clutter/clutter.h"
 #include "cogl/cogl.h"
 #include "meta/util.h"
@@ -54,6 +62,13 @@
  *
  * glClientWaitSync() and XAlarms are used in steps 2 and 4,
  * respectively, to double-check the expectections.
+ *
+ * When the X server supports DRI3, the fences are backed by an xshmfence
+ * instead. Those live in memory shared with the X server, so step 3 is
+ * done locally and the fence is ready right away, without any requests
+ * or alarm events besides the XSyncTriggerFence() of step 1. Whether the
+ * GL driver honours such fences is probed once when the ring is first
+ * set up; MUTTER_DEBUG_DISABLE_SHM_FENCES skips them altogether.
  */
 
 #define NUM_SYNCS 10
@@ -76,6 +91,10 @@ typedef struct
   GLsync gl_x11_sync;
   GLsync gpu_fence;
 
+#ifdef HAVE_XSHMFENCE
+  struct xshmfence *shm_fence;
+#endif
+
   XSyncCounter xcounter;
   XSyncAlarm xalarm;
   XSyncValue next_counter_value;
@@ -90,6 +109,9 @@ typedef struct
   int xsync_error_base;
 
   GHashTable *alarm_to_sync;
+  gboolean use_shm_fences;
+  gboolean shm_fences_probed;
+  gboolean shm_fences_broken;
 
   MetaSync *syncs_array[NUM_SYNCS];
   guint current_sync_idx;
@@ -286,6 +308,15 @@ meta_sync_reset (MetaSync *self)
 
   g_return_if_fail (self->state == META_SYNC_STATE_DONE);
 
+#ifdef HAVE_XSHMFENCE
+  if (self->shm_fence)
+    {
+      xshmfence_reset (self->shm_fence);
+      self->state = META_SYNC_STATE_READY;
+      return;
+    }
+#endif
+
   XSyncResetFence (self->xdisplay, self->xfence);
 
   attrs.trigger.wait_value = self->next_counter_value;
@@ -311,8 +342,52 @@ meta_sync_handle_event (MetaSync              *self,
   self->state = META_SYNC_STATE_READY;
 }
 
+#ifdef HAVE_XSHMFENCE
+static gboolean
+meta_sync_create_shm_fence (MetaSync *self)
+{
+  xcb_connection_t *xcb = XGetXCBConnection (self->xdisplay);
+  xcb_void_cookie_t cookie;
+  xcb_generic_error_t *error;
+  int fd;
+
+  fd = xshmfence_alloc_shm ();
+  if (fd < 0)
+    return FALSE;
+
+  self->shm_fence = xshmfence_map_shm (fd);
+  if (!self->shm_fence)
+    {
+      close (fd);
+      return FALSE;
+    }
+
+  /* xcb takes ownership of the file descriptor */
+  self->xfence = xcb_generate_id (xcb);
+  cookie = xcb_dri3_fence_from_fd_checked (xcb,
+                                           DefaultRootWindow (self->xdisplay),
+                                           self->xfence,
+                                           FALSE,
+                                           fd);
+  error = xcb_request_check (xcb, cookie);
+  if (error)
+    {
+      meta_verbose ("MetaSyncRing: DRI3FenceFromFD failed with error %d\n",
+                    error->error_code);
+      free (error);
+      xshmfence_unmap_shm (self->shm_fence);
+      self->shm_fence = NULL;
+      self->xfence = None;
+      return FALSE;
+    }
+
+  return TRUE;
+}
+#endif
+
 static MetaSync *
-meta_sync_new (Display *xdisplay)
+meta_sync_new (Display  *xdisplay,
+               gboolean  use_shm_fence)
 {
   MetaSync *self;
   XSyncAlarmAttributes attrs;
@@ -321,10 +396,19 @@ meta_sync_new (Display *xdisplay)
 
   self->xdisplay = xdisplay;
 
-  self->xfence = XSyncCreateFence (xdisplay, DefaultRootWindow (xdisplay), FALSE);
   self->gl_x11_sync = 0;
   self->gpu_fence = 0;
 
+#ifdef HAVE_XSHMFENCE
+  if (use_shm_fence && meta_sync_create_shm_fence (self))
+    {
+      self->state = META_SYNC_STATE_READY;
+      return self;
+    }
+#endif
+
+  self->xfence = XSyncCreateFence (xdisplay, DefaultRootWindow (xdisplay), FALSE);
+
   self->xcounter = XSyncCreateCounter (xdisplay, SYNC_VALUE_ZERO);
 
   attrs.trigger.counter = self->xcounter;
@@ -405,17 +489,104 @@ meta_sync_free (MetaSync *self)
 
   meta_gl_delete_sync (self->gl_x11_sync);
   XSyncDestroyFence (self->xdisplay, self->xfence);
-  XSyncDestroyCounter (self->xdisplay, self->xcounter);
-  XSyncDestroyAlarm (self->xdisplay, self->xalarm);
+
+#ifdef HAVE_XSHMFENCE
+  if (self->shm_fence)
+    xshmfence_unmap_shm (self->shm_fence);
+#endif
+
+  if (self->xcounter != None)
+    XSyncDestroyCounter (self->xdisplay, self->xcounter);
+  if (self->xalarm != None)
+    XSyncDestroyAlarm (self->xdisplay, self->xalarm);
 
   g_free (self);
 }
 
+#ifdef HAVE_XSHMFENCE
+static gboolean
+has_dri3 (Display *xdisplay)
+{
+  xcb_connection_t *xcb = XGetXCBConnection (xdisplay);
+  const xcb_query_extension_reply_t *extension;
+
+  extension = xcb_get_extension_data (xcb, &xcb_dri3_id);
+
+  return extension && extension->present;
+}
+
+/* Some drivers import DRI3 fences without looking at the shared memory
+ * behind them, so make sure once that a fence triggered by the X server
+ * signals the imported GL sync object, and that resetting it locally
+ * unsignals it again.
+ */
+static gboolean
+meta_sync_ring_probe_shm_fences (MetaSyncRing *ring)
+{
+  MetaSync *sync = ring->syncs_array[0];
+  GLenum status;
+
+  if (!sync->shm_fence || !sync->gl_x11_sync)
+    return FALSE;
+
+  XSyncTriggerFence (ring->xdisplay, sync->xfence);
+  XSync (ring->xdisplay, False);
+
+  if (!xshmfence_query (sync->shm_fence))
+    return FALSE;
+
+  status = meta_gl_client_wait_sync (sync->gl_x11_sync,
+                                     GL_SYNC_FLUSH_COMMANDS_BIT,
+                                     MAX_SYNC_WAIT_TIME);
+  if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+    return FALSE;
+
+  xshmfence_reset (sync->shm_fence);
+
+  status = meta_gl_client_wait_sync (sync->gl_x11_sync, 0, 0);
+
+  return status == GL_TIMEOUT_EXPIRED;
+}
+#endif
+
+static void
+meta_sync_ring_create_syncs (MetaSyncRing *ring)
+{
+  guint i;
+
+  for (i = 0; i < NUM_SYNCS; ++i)
+    {
+      MetaSync *sync = meta_sync_new (ring->xdisplay, ring->use_shm_fences);
+      ring->syncs_array[i] = sync;
+      if (sync->xalarm != None)
+        g_hash_table_replace (ring->alarm_to_sync, (gpointer) sync->xalarm, sync);
+    }
+  /* Since the connection we create the X fences on isn't the same as
+   * the one used for the GLX context, we need to XSync() here to
+   * ensure glImportSync() succeeds. */
+  XSync (ring->xdisplay, False);
+  for (i = 0; i < NUM_SYNCS; ++i)
+    meta_sync_import (ring->syncs_array[i]);
+}
+
+static void
+meta_sync_ring_free_syncs (MetaSyncRing *ring)
+{
+  guint i;
+
+  for (i = 0; i < NUM_SYNCS; ++i)
+    {
+      meta_sync_free (ring->syncs_array[i]);
+      ring->syncs_array[i] = NULL;
+    }
+
+  g_hash_table_remove_all (ring->alarm_to_sync);
+}
+
 gboolean
 meta_sync_ring_init (Display *xdisplay)
 {
   gint major, minor;
-  guint i;
   MetaSyncRing *ring = meta_sync_ring_get ();
 
   if (!ring)
@@ -438,18 +609,33 @@ meta_sync_ring_init (Display *xdisplay)
 
   ring->alarm_to_sync = g_hash_table_new (NULL, NULL);
 
-  for (i = 0; i < NUM_SYNCS; ++i)
+#ifdef HAVE_XSHMFENCE
+  ring->use_shm_fences = (!ring->shm_fences_broken &&
+                          !g_getenv ("MUTTER_DEBUG_DISABLE_SHM_FENCES") &&
+                          has_dri3 (xdisplay));
+#endif
+
+  meta_sync_ring_create_syncs (ring);
+
+#ifdef HAVE_XSHMFENCE
+  if (ring->use_shm_fences && !ring->shm_fences_probed)
     {
-      MetaSync *sync = meta_sync_new (ring->xdisplay);
-      ring->syncs_array[i] = sync;
-      g_hash_table_replace (ring->alarm_to_sync, (gpointer) sync->xalarm, sync);
+      ring->shm_fences_probed = TRUE;
+      ring->shm_fences_broken = !meta_sync_ring_probe_shm_fences (ring);
+
+      if (ring->shm_fences_broken)
+        {
+          meta_verbose ("MetaSyncRing: xshmfence doesn't signal imported "
+                        "GL syncs, falling back to XSync fences\n");
+          meta_sync_ring_free_syncs (ring);
+          ring->use_shm_fences = FALSE;
+          meta_sync_ring_create_syncs (ring);
+        }
     }
-  /* Since the connection we create the X fences on isn't the same as
-   * the one used for the GLX context, we need to XSync() here to
-   * ensure glImportSync() succeeds. */
-  XSync (xdisplay, False);
-  for (i = 0; i < NUM_SYNCS; ++i)
-    meta_sync_import (ring->syncs_array[i]);
+#endif
+
+  meta_verbose ("MetaSyncRing: using %s fences\n",
+                ring->use_shm_fences ? "xshmfence" : "XSync");
 
   ring->current_sync_idx = 0;
   ring->current_sync = ring->syncs_array[0];
@@ -461,7 +647,6 @@ meta_sync_ring_init (Display *xdisplay)
 void
 meta_sync_ring_destroy (void)
 {
-  guint i;
   MetaSyncRing *ring = meta_sync_ring_get ();
 
   if (!ring)
@@ -473,13 +658,13 @@ meta_sync_ring_destroy (void)
   ring->current_sync = NULL;
   ring->warmup_syncs = 0;
 
-  for (i = 0; i < NUM_SYNCS; ++i)
-    meta_sync_free (ring->syncs_array[i]);
+  meta_sync_ring_free_syncs (ring);
 
   g_hash_table_destroy (ring->alarm_to_sync);
 
   ring->xsync_event_base = 0;
   ring->xsync_error_base = 0;
+  ring->use_shm_fences = FALSE;
   ring->xdisplay = NULL;
 }
 
@@ -0,0 +1,395 @@
+/* -*- mode: C; c-file-style: "gnu"; indent-tabs-mode: nil; -*- */
+
+/*
+ * Copyright (C) 2020 Red Hat Inc.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * MetaTextureBudget keeps the texture memory held for windows within a
+ * limit. Every window actor registers an entry reporting how much it
+ * uses and whether it is currently visible. When the total goes over
+ * the limit, windows that have been hidden the longest are asked to
+ * release memory, in two steps:
+ *
+ *  1) caches that are recreated on demand, such as the scaled down
+ *     levels of the texture tower and shadows;
+ *  2) the full texture, which is replaced with a scaled down snapshot
+ *     until the window is shown again.
+ *
+ * Visible windows are never asked to release anything, so the usage can
+ * stay above the limit when visible windows alone exceed it.
+ */
+
+#include "config.h"
+
+#include "compositor/meta-texture-budget.h"
+
+#include "backends/meta-dbus-utils.h"
+
+#include "meta-dbus-texture-budget.h"
+
+#define META_TEXTURE_BUDGET_DBUS_SERVICE "org.gnome.Mutter.TextureBudget"
+#define META_TEXTURE_BUDGET_DBUS_PATH "/org/gnome/Mutter/TextureBudget"
+
+#define DEFAULT_LIMIT_MB 512
+#define CHECK_INTERVAL_S 1
+
+struct _MetaTextureBudgetEntry
+{
+  MetaTextureUsageFunc usage_func;
+  MetaTextureReleaseFunc release_func;
+  gpointer user_data;
+
+  MetaTextureUsage usage;
+  uint64_t last_visible;
+};
+
+struct _MetaTextureBudget
+{
+  MetaDBusTextureBudgetSkeleton parent;
+
+  int dbus_name_id;
+
+  GList *entries;
+
+  size_t limit;
+  uint64_t check_serial;
+  guint check_id;
+};
+
+static void
+meta_texture_budget_init_iface (MetaDBusTextureBudgetIface *iface);
+
+G_DEFINE_TYPE_WITH_CODE (MetaTextureBudget,
+                         meta_texture_budget,
+                         META_DBUS_TYPE_TEXTURE_BUDGET_SKELETON,
+                         G_IMPLEMENT_INTERFACE (META_DBUS_TYPE_TEXTURE_BUDGET,
+                                                meta_texture_budget_init_iface))
+
+static size_t
+get_entry_size (MetaTextureBudgetEntry *entry)
+{
+  return entry->usage.cache_size + entry->usage.content_size;
+}
+
+static size_t
+update_usage (MetaTextureBudget *budget,
+              size_t            *out_cache_usage)
+{
+  size_t usage = 0;
+  size_t cache_usage = 0;
+  GList *l;
+
+  budget->check_serial++;
+
+  for (l = budget->entries; l; l = l->next)
+    {
+      MetaTextureBudgetEntry *entry = l->data;
+
+      entry->usage = (MetaTextureUsage) { 0 };
+      entry->usage_func (entry->user_data, &entry->usage);
+
+      if (entry->usage.visible)
+        entry->last_visible = budget->check_serial;
+
+      usage += get_entry_size (entry);
+      cache_usage += entry->usage.cache_size;
+    }
+
+  if (out_cache_usage)
+    *out_cache_usage = cache_usage;
+
+  return usage;
+}
+
+static int
+compare_last_visible (gconstpointer a,
+                      gconstpointer b)
+{
+  const MetaTextureBudgetEntry *entry_a = a;
+  const MetaTextureBudgetEntry *entry_b = b;
+
+  if (entry_a->last_visible < entry_b->last_visible)
+    return -1;
+  else if (entry_a->last_visible > entry_b->last_visible)
+    return 1;
+  else
+    return 0;
+}
+
+static gboolean
+can_release (MetaTextureBudgetEntry *entry,
+             MetaTextureRelease      release)
+{
+  switch (release)
+    {
+    case META_TEXTURE_RELEASE_CACHES:
+      return entry->usage.cache_size > 0;
+    case META_TEXTURE_RELEASE_CONTENTS:
+      return entry->usage.content_size > 0 && !entry->usage.has_snapshot;
+    }
+
+  g_assert_not_reached ();
+  return FALSE;
+}
+
+static size_t
+release_until_within_limit (MetaTextureBudget  *budget,
+                            GList              *candidates,
+                            MetaTextureRelease  release,
+                            size_t              usage)
+{
+  GList *l;
+
+  for (l = candidates; l && usage > budget->limit; l = l->next)
+    {
+      MetaTextureBudgetEntry *entry = l->data;
+      size_t old_size;
+
+      if (!can_release (entry, release))
+        continue;
+
+      old_size = get_entry_size (entry);
+
+      entry->release_func (entry->user_data, release);
+
+      entry->usage = (MetaTextureUsage) { 0 };
+      entry->usage_func (entry->user_data, &entry->usage);
+
+      usage = usage - old_size + get_entry_size (entry);
+    }
+
+  return usage;
+}
+
+/*
+ * meta_texture_budget_enforce:
+ * @budget: a #MetaTextureBudget
+ *
+ * Queries the usage of every entry, and if the total is over the limit,
+ * releases memory from hidden entries, least recently visible first,
+ * until it is within the limit again or nothing more can be released.
+ */
+void
+meta_texture_budget_enforce (MetaTextureBudget *budget)
+{
+  g_autoptr (GList) candidates = NULL;
+  size_t usage;
+  GList *l;
+
+  usage = update_usage (budget, NULL);
+  if (usage <= budget->limit)
+    return;
+
+  for (l = budget->entries; l; l = l->next)
+    {
+      MetaTextureBudgetEntry *entry = l->data;
+
+      if (!entry->usage.visible)
+        candidates = g_list_prepend (candidates, entry);
+    }
+
+  candidates = g_list_sort (candidates, compare_last_visible);
+
+  usage = release_until_within_limit (budget, candidates,
+                                      META_TEXTURE_RELEASE_CACHES,
+                                      usage);
+  usage = release_until_within_limit (budget, candidates,
+                                      META_TEXTURE_RELEASE_CONTENTS,
+                                      usage);
+
+  if (usage > budget->limit)
+    {
+      g_debug ("Window textures use %" G_GSIZE_FORMAT " bytes, "
+               "more than the budget of %" G_GSIZE_FORMAT " bytes",
+               usage, budget->limit);
+    }
+}
+
+static gboolean
+check_timeout (gpointer user_data)
+{
+  MetaTextureBudget *budget = user_data;
+
+  budget->check_id = 0;
+  meta_texture_budget_enforce (budget);
+
+  return G_SOURCE_REMOVE;
+}
+
+/*
+ * meta_texture_budget_queue_check:
+ * @budget: a #MetaTextureBudget
+ *
+ * Makes sure the budget is enforced within the next second. This is
+ * cheap enough to call every frame.
+ */
+void
+meta_texture_budget_queue_check (MetaTextureBudget *budget)
+{
+  if (budget->check_id)
+    return;
+
+  budget->check_id = g_timeout_add_seconds (CHECK_INTERVAL_S,
+                                            check_timeout,
+                                            budget);
+  g_source_set_name_by_id (budget->check_id,
+                           "[mutter] texture_budget_check");
+}
+
+MetaTextureBudgetEntry *
+meta_texture_budget_add_entry (MetaTextureBudget      *budget,
+                               MetaTextureUsageFunc    usage_func,
+                               MetaTextureReleaseFunc  release_func,
+                               gpointer                user_data)
+{
+  MetaTextureBudgetEntry *entry;
+
+  entry = g_new0 (MetaTextureBudgetEntry, 1);
+  entry->usage_func = usage_func;
+  entry->release_func = release_func;
+  entry->user_data = user_data;
+  entry->last_visible = budget->check_serial;
+
+  budget->entries = g_list_prepend (budget->entries, entry);
+
+  return entry;
+}
+
+void
+meta_texture_budget_remove_entry (MetaTextureBudget      *budget,
+                                  MetaTextureBudgetEntry *entry)
+{
+  budget->entries = g_list_remove (budget->entries, entry);
+  g_free (entry);
+}
+
+void
+meta_texture_budget_set_limit (MetaTextureBudget *budget,
+                               size_t             limit)
+{
+  budget->limit = limit;
+}
+
+size_t
+meta_texture_budget_get_limit (MetaTextureBudget *budget)
+{
+  return budget->limit;
+}
+
+size_t
+meta_texture_budget_get_usage (MetaTextureBudget *budget)
+{
+  return update_usage (budget, NULL);
+}
+
+static gboolean
+handle_get_usage (MetaDBusTextureBudget *skeleton,
+                  GDBusMethodInvocation *invocation)
+{
+  MetaTextureBudget *budget = META_TEXTURE_BUDGET (skeleton);
+  size_t usage, cache_usage;
+  unsigned int n_snapshots = 0;
+  GList *l;
+
+  usage = update_usage (budget, &cache_usage);
+
+  for (l = budget->entries; l; l = l->next)
+    {
+      MetaTextureBudgetEntry *entry = l->data;
+
+      if (entry->usage.has_snapshot)
+        n_snapshots++;
+    }
+
+  meta_dbus_texture_budget_complete_get_usage (skeleton, invocation,
+                                               budget->limit,
+                                               usage,
+                                               cache_usage,
+                                               g_list_length (budget->entries),
+                                               n_snapshots);
+
+  return TRUE;
+}
+
+static void
+meta_texture_budget_init_iface (MetaDBusTextureBudgetIface *iface)
+{
+  iface->handle_get_usage = handle_get_usage;
+}
+
+static void
+meta_texture_budget_constructed (GObject *object)
+{
+  MetaTextureBudget *budget = META_TEXTURE_BUDGET (object);
+
+  budget->dbus_name_id =
+    meta_dbus_own_name_for_skeleton (G_DBUS_INTERFACE_SKELETON (budget),
+                                     META_TEXTURE_BUDGET_DBUS_SERVICE,
+                                     META_TEXTURE_BUDGET_DBUS_PATH);
+
+  G_OBJECT_CLASS (meta_texture_budget_parent_class)->constructed (object);
+}
+
+static void
+meta_texture_budget_finalize (GObject *object)
+{
+  MetaTextureBudget *budget = META_TEXTURE_BUDGET (object);
+
+  if (budget->dbus_name_id != 0)
+    g_bus_unown_name (budget->dbus_name_id);
+
+  g_clear_handle_id (&budget->check_id, g_source_remove);
+  g_list_free_full (budget->entries, g_free);
+
+  G_OBJECT_CLASS (meta_texture_budget_parent_class)->finalize (object);
+}
+
+MetaTextureBudget *
+meta_texture_budget_new (void)
+{
+  return g_object_new (META_TYPE_TEXTURE_BUDGET, NULL);
+}
+
+static void
+meta_texture_budget_init (MetaTextureBudget *budget)
+{
+  const char *limit_str;
+  size_t limit_mb = DEFAULT_LIMIT_MB;
+
+  limit_str = g_getenv ("MUTTER_TEXTURE_BUDGET_MB");
+  if (limit_str)
+    {
+      int64_t value = g_ascii_strtoll (limit_str, NULL, 10);
+
+      if (value > 0)
+        limit_mb = value;
+      else
+        g_warning ("Ignoring invalid MUTTER_TEXTURE_BUDGET_MB value '%s'",
+                   limit_str);
+    }
+
+  budget->limit = limit_mb * 1024 * 1024;
+}
+
+static void
+meta_texture_budget_class_init (MetaTextureBudgetClass *klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+
+  object_class->constructed = meta_texture_budget_constructed;
+  object_class->finalize = meta_texture_budget_finalize;
+}
@@ -0,0 +1,74 @@
+/* -*- mode: C; c-file-style: "gnu"; indent-tabs-mode: nil; -*- */
+
+/*
+ * Copyright (C) 2020 Red Hat Inc.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef META_TEXTURE_BUDGET_H
+#define META_TEXTURE_BUDGET_H
+
+#include <glib-object.h>
+
+#include "meta-dbus-texture-budget.h"
+
+typedef enum _MetaTextureRelease
+{
+  META_TEXTURE_RELEASE_CACHES,
+  META_TEXTURE_RELEASE_CONTENTS,
+} MetaTextureRelease;
+
+typedef struct _MetaTextureUsage
+{
+  gboolean visible;
+  gboolean has_snapshot;
+  size_t cache_size;
+  size_t content_size;
+} MetaTextureUsage;
+
+typedef void (* MetaTextureUsageFunc) (gpointer          user_data,
+                                       MetaTextureUsage *usage);
+typedef void (* MetaTextureReleaseFunc) (gpointer           user_data,
+                                         MetaTextureRelease release);
+
+typedef struct _MetaTextureBudgetEntry MetaTextureBudgetEntry;
+
+#define META_TYPE_TEXTURE_BUDGET (meta_texture_budget_get_type ())
+G_DECLARE_FINAL_TYPE (MetaTextureBudget, meta_texture_budget,
+                      META, TEXTURE_BUDGET,
+                      MetaDBusTextureBudgetSkeleton)
+
+MetaTextureBudget * meta_texture_budget_new (void);
+
+MetaTextureBudgetEntry * meta_texture_budget_add_entry (MetaTextureBudget      *budget,
+                                                        MetaTextureUsageFunc    usage_func,
+                                                        MetaTextureReleaseFunc  release_func,
+                                                        gpointer                user_data);
+
+void meta_texture_budget_remove_entry (MetaTextureBudget      *budget,
+                                       MetaTextureBudgetEntry *entry);
+
+void meta_texture_budget_queue_check (MetaTextureBudget *budget);
+
+void meta_texture_budget_enforce (MetaTextureBudget *budget);
+
+void meta_texture_budget_set_limit (MetaTextureBudget *budget,
+                                    size_t             limit);
+
+size_t meta_texture_budget_get_limit (MetaTextureBudget *budget);
+
+size_t meta_texture_budget_get_usage (MetaTextureBudget *budget);
+
+#endif /* META_TEXTURE_BUDGET_H */
@@ -115,8 +115,6 @@ void
 meta_texture_tower_set_base_texture (MetaTextureTower *tower,
                                      CoglTexture      *texture)
 {
-  int i;
-
   g_return_if_fail (tower != NULL);
 
   if (texture == tower->textures[0])
@@ -124,21 +122,7 @@ meta_texture_tower_set_base_texture (MetaTextureTower *tower,
 
   if (tower->textures[0] != NULL)
     {
-      for (i = 1; i < tower->n_levels; i++)
-        {
-          if (tower->textures[i] != NULL)
-            {
-              cogl_object_unref (tower->textures[i]);
-              tower->textures[i] = NULL;
-            }
-
-          if (tower->fbos[i] != NULL)
-            {
-              cogl_object_unref (tower->fbos[i]);
-              tower->fbos[i] = NULL;
-            }
-        }
-
+      meta_texture_tower_release_levels (tower);
       cogl_object_unref (tower->textures[0]);
     }
 
@@ -478,3 +462,61 @@ meta_texture_tower_get_paint_texture (MetaTextureTower    *tower,
 
   return tower->textures[level];
 }
+
+/**
+ * meta_texture_tower_release_levels:
+ * @tower: a #MetaTextureTower
+ *
+ * Frees the scaled down textures of the tower, keeping only the base
+ * texture. They are recreated the next time they are needed for painting.
+ */
+void
+meta_texture_tower_release_levels (MetaTextureTower *tower)
+{
+  int i;
+
+  g_return_if_fail (tower != NULL);
+
+  for (i = 1; i < tower->n_levels; i++)
+    {
+      if (tower->textures[i] != NULL)
+        {
+          cogl_object_unref (tower->textures[i]);
+          tower->textures[i] = NULL;
+        }
+
+      if (tower->fbos[i] != NULL)
+        {
+          cogl_object_unref (tower->fbos[i]);
+          tower->fbos[i] = NULL;
+        }
+    }
+}
+
+/**
+ * meta_texture_tower_get_levels_size:
+ * @tower: a #MetaTextureTower
+ *
+ * Return value: an estimate, in bytes, of the memory used by the scaled
+ *  down textures of the tower, not including the base texture.
+ */
+size_t
+meta_texture_tower_get_levels_size (MetaTextureTower *tower)
+{
+  size_t size = 0;
+  int i;
+
+  g_return_val_if_fail (tower != NULL, 0);
+
+  for (i = 1; i < tower->n_levels; i++)
+    {
+      if (tower->textures[i] == NULL)
+        continue;
+
+      size += ((size_t) cogl_texture_get_width (tower->textures[i]) *
+               cogl_texture_get_height (tower->textures[i]) *
+               cogl_pixel_format_get_bytes_per_pixel (TEXTURE_FORMAT, 0));
+    }
+
+  return size;
+}
@@ -62,6 +62,8 @@ void              meta_texture_tower_update_area       (MetaTextureTower *tower,
                                                         int               height);
 CoglTexture      *meta_texture_tower_get_paint_texture (MetaTextureTower    *tower,
                                                         ClutterPaintContext *paint_context);
+void              meta_texture_tower_release_levels    (MetaTextureTower *tower);
+size_t            meta_texture_tower_get_levels_size   (MetaTextureTower *tower);
 
 G_END_DECLS
 
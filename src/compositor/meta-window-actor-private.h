@@ -7,6 +7,7 @@
 
 #include "compositor/meta-plugin-manager.h"
 #include "compositor/meta-surface-actor.h"
+#include "compositor/meta-texture-budget.h"
 #include "meta/compositor-mutter.h"
 
 struct _MetaWindowActorClass
@@ -14,6 +15,7 @@ struct _MetaWindowActorClass
   ClutterActorClass parent;
 
   void (*frame_complete) (MetaWindowActor  *actor,
+                          ClutterStageView *stage_view,
                           ClutterFrameInfo *frame_info,
                           int64_t           presentation_time);
 
@@ -33,6 +35,8 @@ struct _MetaWindowActorClass
                       gboolean         frozen);
   void (*update_regions) (MetaWindowActor *actor);
   gboolean (*can_freeze_commits) (MetaWindowActor *actor);
+  void (*release_textures) (MetaWindowActor    *actor,
+                            MetaTextureRelease  release);
 };
 
 typedef enum
@@ -58,6 +62,7 @@ void meta_window_actor_before_paint   (MetaWindowActor    *self,
 void meta_window_actor_after_paint    (MetaWindowActor    *self,
                                        ClutterStageView   *stage_view);
 void meta_window_actor_frame_complete (MetaWindowActor    *self,
+                                       ClutterStageView   *stage_view,
                                        ClutterFrameInfo   *frame_info,
                                        gint64              presentation_time);
 
@@ -99,4 +104,7 @@ void meta_window_actor_update_regions (MetaWindowActor *self);
 
 gboolean meta_window_actor_can_freeze_commits (MetaWindowActor *self);
 
+void meta_window_actor_get_texture_usage (MetaWindowActor  *self,
+                                          MetaTextureUsage *usage);
+
 #endif /* META_WINDOW_ACTOR_PRIVATE_H */
@@ -107,6 +107,7 @@ meta_window_actor_wayland_assign_surface_actor (MetaWindowActor  *actor,
 
 static void
 meta_window_actor_wayland_frame_complete (MetaWindowActor  *actor,
+                                          ClutterStageView *stage_view,
                                           ClutterFrameInfo *frame_info,
                                           int64_t           presentation_time)
 {
@@ -152,6 +153,15 @@ meta_window_actor_wayland_can_freeze_commits (MetaWindowActor *actor)
   return FALSE;
 }
 
+static void
+meta_window_actor_wayland_release_textures (MetaWindowActor    *actor,
+                                            MetaTextureRelease  release)
+{
+  /* Buffers are owned by the client; dropping our texture wouldn't free
+   * them, and shm contents couldn't be uploaded again without a new commit.
+   */
+}
+
 static void
 meta_window_actor_wayland_class_init (MetaWindowActorWaylandClass *klass)
 {
@@ -166,6 +176,7 @@ meta_window_actor_wayland_class_init (MetaWindowActorWaylandClass *klass)
   window_actor_class->set_frozen = meta_window_actor_wayland_set_frozen;
   window_actor_class->update_regions = meta_window_actor_wayland_update_regions;
   window_actor_class->can_freeze_commits = meta_window_actor_wayland_can_freeze_commits;
+  window_actor_class->release_textures = meta_window_actor_wayland_release_textures;
 }
 
 static void
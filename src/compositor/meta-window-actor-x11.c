@@ -24,7 +24,6 @@
 
 #include "compositor/meta-window-actor-x11.h"
 
-#include "backends/meta-logical-monitor.h"
 #include "clutter/clutter-frame-clock.h"
 #include "compositor/compositor-private.h"
 #include "compositor/meta-cullable.h"
@@ -104,6 +103,7 @@ struct _MetaWindowActorX11
   gboolean needs_reshape;
   gboolean recompute_focused_shadow;
   gboolean recompute_unfocused_shadow;
+  gboolean shadows_released;
   gboolean is_frozen;
 };
 
@@ -120,6 +120,11 @@ G_DEFINE_TYPE_WITH_CODE (MetaWindowActorX11, meta_window_actor_x11, META_TYPE_WI
  * Cogl counter for that frame, and send _NET_WM_FRAME_DRAWN at the end of the
  * frame. _NET_WM_FRAME_TIMINGS is sent when we get a frame_complete callback.
  *
+ * Frames are only tied to the stage view driving the frame clock of the
+ * window, so that the timings sent to the client come from the presentation
+ * feedback of the monitor it is paced by, rather than from whichever view
+ * happens to be painted or presented first.
+ *
  * As an exception, if a window is completely obscured, we try to throttle drawning
  * to a slower frame rate. In this case, frame_counter stays -1 until
  * send_frame_message_timeout() runs, at which point we send both the
@@ -130,6 +135,7 @@ typedef struct
   uint64_t sync_request_serial;
   int64_t frame_counter;
   int64_t frame_drawn_time;
+  ClutterStageView *stage_view;
 } FrameData;
 
 static void
@@ -287,31 +293,19 @@ queue_send_frame_messages_timeout (MetaWindowActorX11 *actor_x11)
   MetaWindow *window =
     meta_window_actor_get_meta_window (META_WINDOW_ACTOR (actor_x11));
   MetaDisplay *display = meta_window_get_display (window);
-  MetaLogicalMonitor *logical_monitor;
   int64_t now_us;
   int64_t current_time;
-  float refresh_rate;
+  float refresh_rate = 0.0f;
   int interval, offset;
 
   if (actor_x11->send_frame_messages_timer != 0)
     return;
 
-  logical_monitor = meta_window_get_main_logical_monitor (window);
-  if (logical_monitor)
-    {
-      GList *monitors = meta_logical_monitor_get_monitors (logical_monitor);
-      MetaMonitor *monitor;
-      MetaMonitorMode *mode;
+  if (actor_x11->frame_clock)
+    refresh_rate = clutter_frame_clock_get_refresh_rate (actor_x11->frame_clock);
 
-      monitor = g_list_first (monitors)->data;
-      mode = meta_monitor_get_current_mode (monitor);
-
-      refresh_rate = meta_monitor_mode_get_refresh_rate (mode);
-    }
-  else
-    {
-      refresh_rate = 60.0f;
-    }
+  if (refresh_rate < 1.0f)
+    refresh_rate = 60.0f;
 
   now_us = g_get_monotonic_time ();
   current_time =
@@ -332,8 +326,19 @@ queue_send_frame_messages_timeout (MetaWindowActorX11 *actor_x11)
                            "[mutter] send_frame_messages_timeout");
 }
 
+static gboolean
+is_main_stage_view (MetaWindowActorX11 *actor_x11,
+                    ClutterStageView   *stage_view)
+{
+  return (stage_view &&
+          actor_x11->frame_clock &&
+          clutter_stage_view_get_frame_clock (stage_view) ==
+          actor_x11->frame_clock);
+}
+
 static void
-assign_frame_counter_to_frames (MetaWindowActorX11 *actor_x11)
+assign_frame_counter_to_frames (MetaWindowActorX11 *actor_x11,
+                                ClutterStageView   *stage_view)
 {
   MetaWindow *window =
     meta_window_actor_get_meta_window (META_WINDOW_ACTOR (actor_x11));
@@ -352,12 +357,16 @@ assign_frame_counter_to_frames (MetaWindowActorX11 *actor_x11)
       FrameData *frame = l->data;
 
       if (frame->frame_counter == -1)
-        frame->frame_counter = clutter_stage_get_frame_counter (stage);
+        {
+          frame->frame_counter = clutter_stage_get_frame_counter (stage);
+          frame->stage_view = stage_view;
+        }
     }
 }
 
 static void
 meta_window_actor_x11_frame_complete (MetaWindowActor  *actor,
+                                      ClutterStageView *stage_view,
                                       ClutterFrameInfo *frame_info,
                                       int64_t           presentation_time)
 {
@@ -373,7 +382,9 @@ meta_window_actor_x11_frame_complete (MetaWindowActor  *actor,
       FrameData *frame = l->data;
       int64_t frame_counter = frame_info->frame_counter;
 
-      if (frame->frame_counter != -1 && frame->frame_counter <= frame_counter)
+      if (frame->frame_counter != -1 &&
+          frame->frame_counter <= frame_counter &&
+          frame->stage_view == stage_view)
         {
           MetaWindow *window =
             meta_window_actor_get_meta_window (actor);
@@ -581,6 +592,56 @@ meta_window_actor_x11_should_unredirect (MetaWindowActorX11 *actor_x11)
   return meta_surface_actor_x11_should_unredirect (surface_x11);
 }
 
+/* Xwayland windows are backed by a wl_surface, so they can be scanned out
+ * like Wayland windows, as long as they would have been unredirected on an
+ * X11 compositor. The damage heuristics don't apply, as switching between
+ * direct scanout and compositing is cheap.
+ */
+gboolean
+meta_window_actor_x11_can_scanout (MetaWindowActorX11 *actor_x11)
+{
+  MetaWindowActor *window_actor = META_WINDOW_ACTOR (actor_x11);
+  MetaWindow *window = meta_window_actor_get_meta_window (window_actor);
+  MetaSurfaceActor *surface;
+
+  if (meta_window_actor_is_destroyed (window_actor))
+    return FALSE;
+
+  if (meta_window_actor_is_frozen (window_actor))
+    return FALSE;
+
+  /* The frame is drawn into the buffer of the frame window, which is only
+   * equivalent to the client contents when it has no visible borders.
+   */
+  if (window->frame)
+    {
+      MetaFrameBorders borders;
+
+      if (!window->fullscreen)
+        return FALSE;
+
+      meta_frame_calc_borders (window->frame, &borders);
+      if (borders.visible.left != 0 || borders.visible.right != 0 ||
+          borders.visible.top != 0 || borders.visible.bottom != 0)
+        return FALSE;
+    }
+
+  if (!meta_window_x11_can_unredirect (META_WINDOW_X11 (window)))
+    return FALSE;
+
+  surface = meta_window_actor_get_surface (window_actor);
+  if (!surface)
+    return FALSE;
+
+  if (!meta_surface_actor_is_opaque (surface))
+    return FALSE;
+
+  if (!meta_cullable_is_untransformed (META_CULLABLE (surface)))
+    return FALSE;
+
+  return TRUE;
+}
+
 void
 meta_window_actor_x11_set_unredirected (MetaWindowActorX11 *actor_x11,
                                         gboolean            unredirected)
@@ -748,6 +809,17 @@ check_needs_shadow (MetaWindowActorX11 *actor_x11)
   gboolean should_have_shadow;
   gboolean appears_focused;
 
+  /* Don't bring back shadows released by the texture budget before
+   * the window is shown again.
+   */
+  if (actor_x11->shadows_released)
+    {
+      if (!clutter_actor_is_mapped (CLUTTER_ACTOR (actor_x11)))
+        return;
+
+      actor_x11->shadows_released = FALSE;
+    }
+
   /* Calling has_shadow() here at every pre-paint is cheap
    * and avoids the need to explicitly handle window type changes, which
    * we would do if tried to keep track of when we might be adding or removing
@@ -894,29 +966,236 @@ get_client_area_rect (MetaWindowActorX11    *actor_x11,
 }
 
 static void
-build_and_scan_frame_mask (MetaWindowActorX11    *actor_x11,
-                           cairo_region_t        *shape_region)
+get_frame_paint_region (MetaWindowActorX11     *actor_x11,
+                        MetaShapedTexture      *stex,
+                        cairo_region_t        **frame_paint_region,
+                        cairo_rectangle_int_t  *frame_rect)
+{
+  MetaWindow *window =
+    meta_window_actor_get_meta_window (META_WINDOW_ACTOR (actor_x11));
+  cairo_rectangle_int_t rect = {
+    0, 0,
+    meta_shaped_texture_get_width (stex),
+    meta_shaped_texture_get_height (stex)
+  };
+  cairo_rectangle_int_t client_area;
+
+  /* If we update the shape regardless of the frozen state of the actor,
+   * as with Xwayland to avoid the black shadow effect, we ought to base
+   * the frame size on the buffer size rather than the reported window's
+   * frame size, as the buffer may not have been committed yet at this
+   * point.
+   */
+  if (meta_window_x11_always_update_shape (window))
+    {
+      meta_window_x11_surface_rect_to_frame_rect (window, &rect, frame_rect);
+      get_client_area_rect_from_texture (actor_x11, stex, &client_area);
+    }
+  else
+    {
+      meta_window_get_frame_rect (window, frame_rect);
+      meta_window_get_client_area_rect (window, &client_area);
+    }
+
+  /* Make sure we don't paint the frame over the client window. */
+  *frame_paint_region = cairo_region_create_rectangle (&rect);
+  cairo_region_subtract_rectangle (*frame_paint_region, &client_area);
+}
+
+static void
+paint_frame_mask (MetaWindow            *window,
+                  cairo_t               *cr,
+                  cairo_region_t        *shape_region,
+                  cairo_region_t        *frame_paint_region,
+                  cairo_rectangle_int_t *frame_rect)
+{
+  gdk_cairo_region (cr, shape_region);
+  cairo_fill (cr);
+
+  gdk_cairo_region (cr, frame_paint_region);
+  cairo_clip (cr);
+
+  meta_frame_get_mask (window->frame, frame_rect, cr);
+}
+
+/* Only the frame needs to be rasterized on the CPU, as its mask is drawn
+ * by the theme. It covers a thin border around the client area, which is
+ * rasterized and scanned one rectangle at a time and uploaded into the
+ * mask texture, while the shape region itself is drawn on the GPU. This
+ * keeps interactive resizes from rasterizing and uploading the whole
+ * window on every motion event.
+ */
+static CoglTexture *
+build_frame_mask_texture_gpu (MetaWindowActorX11 *actor_x11,
+                              MetaShapedTexture  *stex,
+                              cairo_region_t     *shape_region)
+{
+  ClutterBackend *backend = clutter_get_default_backend ();
+  CoglContext *ctx = clutter_backend_get_cogl_context (backend);
+  MetaWindow *window =
+    meta_window_actor_get_meta_window (META_WINDOW_ACTOR (actor_x11));
+  unsigned int tex_width, tex_height;
+  CoglTexture2D *mask_texture;
+  CoglOffscreen *offscreen;
+  CoglFramebuffer *framebuffer;
+  CoglPipeline *pipeline;
+  float *rectangles;
+  int n_rects, i;
+  GError *error = NULL;
+
+  tex_width = meta_shaped_texture_get_width (stex);
+  tex_height = meta_shaped_texture_get_height (stex);
+
+  mask_texture = cogl_texture_2d_new_with_size (ctx, tex_width, tex_height);
+  cogl_primitive_texture_set_auto_mipmap (COGL_PRIMITIVE_TEXTURE (mask_texture),
+                                          FALSE);
+
+  offscreen = cogl_offscreen_new_with_texture (COGL_TEXTURE (mask_texture));
+  framebuffer = COGL_FRAMEBUFFER (offscreen);
+  if (!cogl_framebuffer_allocate (framebuffer, &error))
+    {
+      g_error_free (error);
+      cogl_object_unref (framebuffer);
+      cogl_object_unref (mask_texture);
+      return NULL;
+    }
+
+  cogl_framebuffer_orthographic (framebuffer,
+                                 0, 0, tex_width, tex_height,
+                                 0, 1.0);
+  cogl_framebuffer_clear4f (framebuffer, COGL_BUFFER_BIT_COLOR,
+                            0.0, 0.0, 0.0, 0.0);
+
+  n_rects = cairo_region_num_rectangles (shape_region);
+  if (n_rects > 0)
+    {
+      rectangles = g_new (float, n_rects * 4);
+      for (i = 0; i < n_rects; i++)
+        {
+          cairo_rectangle_int_t rect;
+
+          cairo_region_get_rectangle (shape_region, i, &rect);
+          rectangles[i * 4] = rect.x;
+          rectangles[i * 4 + 1] = rect.y;
+          rectangles[i * 4 + 2] = rect.x + rect.width;
+          rectangles[i * 4 + 3] = rect.y + rect.height;
+        }
+
+      pipeline = cogl_pipeline_new (ctx);
+      cogl_pipeline_set_color4ub (pipeline, 0xff, 0xff, 0xff, 0xff);
+      cogl_framebuffer_draw_rectangles (framebuffer, pipeline,
+                                        rectangles, n_rects);
+      cogl_object_unref (pipeline);
+      g_free (rectangles);
+    }
+
+  /* The frame is uploaded directly into the texture, so the rectangles
+   * drawn so far must reach the GPU first. */
+  cogl_framebuffer_flush (framebuffer);
+
+  if (window->frame)
+    {
+      cairo_region_t *frame_paint_region, *scanned_region;
+      cairo_rectangle_int_t frame_rect;
+      MetaRegionBuilder builder;
+
+      get_frame_paint_region (actor_x11, stex,
+                              &frame_paint_region, &frame_rect);
+
+      meta_region_builder_init (&builder);
+
+      n_rects = cairo_region_num_rectangles (frame_paint_region);
+      for (i = 0; i < n_rects; i++)
+        {
+          cairo_rectangle_int_t rect;
+          cairo_rectangle_int_t scan_rect;
+          cairo_region_t *scan_area;
+          cairo_region_t *rect_scanned_region;
+          cairo_surface_t *image;
+          uint8_t *mask_data;
+          cairo_t *cr;
+          int stride;
+          int j;
+
+          cairo_region_get_rectangle (frame_paint_region, i, &rect);
+
+          stride = cairo_format_stride_for_width (CAIRO_FORMAT_A8, rect.width);
+          mask_data = g_malloc0 (stride * rect.height);
+
+          image = cairo_image_surface_create_for_data (mask_data,
+                                                       CAIRO_FORMAT_A8,
+                                                       rect.width,
+                                                       rect.height,
+                                                       stride);
+          cr = cairo_create (image);
+          cairo_translate (cr, -rect.x, -rect.y);
+
+          paint_frame_mask (window, cr,
+                            shape_region, frame_paint_region, &frame_rect);
+
+          cairo_destroy (cr);
+          cairo_surface_flush (image);
+
+          scan_rect = (cairo_rectangle_int_t) { 0, 0, rect.width, rect.height };
+          scan_area = cairo_region_create_rectangle (&scan_rect);
+          rect_scanned_region = scan_visible_region (mask_data, stride,
+                                                     scan_area);
+
+          for (j = 0; j < cairo_region_num_rectangles (rect_scanned_region); j++)
+            {
+              cairo_rectangle_int_t scanned_rect;
+
+              cairo_region_get_rectangle (rect_scanned_region, j,
+                                          &scanned_rect);
+              meta_region_builder_add_rectangle (&builder,
+                                                 scanned_rect.x + rect.x,
+                                                 scanned_rect.y + rect.y,
+                                                 scanned_rect.width,
+                                                 scanned_rect.height);
+            }
+
+          cogl_texture_set_region (COGL_TEXTURE (mask_texture),
+                                   0, 0,
+                                   rect.x, rect.y,
+                                   rect.width, rect.height,
+                                   rect.width, rect.height,
+                                   COGL_PIXEL_FORMAT_A_8,
+                                   stride, mask_data);
+
+          cairo_region_destroy (rect_scanned_region);
+          cairo_region_destroy (scan_area);
+          cairo_surface_destroy (image);
+          g_free (mask_data);
+        }
+
+      scanned_region = meta_region_builder_finish (&builder);
+      cairo_region_union (shape_region, scanned_region);
+      cairo_region_destroy (scanned_region);
+      cairo_region_destroy (frame_paint_region);
+    }
+
+  cogl_object_unref (framebuffer);
+
+  return COGL_TEXTURE (mask_texture);
+}
+
+static CoglTexture *
+build_frame_mask_texture_cpu (MetaWindowActorX11 *actor_x11,
+                              MetaShapedTexture  *stex,
+                              cairo_region_t     *shape_region)
 {
   ClutterBackend *backend = clutter_get_default_backend ();
   MetaWindow *window =
     meta_window_actor_get_meta_window (META_WINDOW_ACTOR (actor_x11));
   CoglContext *ctx = clutter_backend_get_cogl_context (backend);
-  MetaSurfaceActor *surface =
-    meta_window_actor_get_surface (META_WINDOW_ACTOR (actor_x11));
   uint8_t *mask_data;
   unsigned int tex_width, tex_height;
-  MetaShapedTexture *stex;
   CoglTexture2D *mask_texture;
   int stride;
   cairo_t *cr;
   cairo_surface_t *image;
   GError *error = NULL;
 
-  stex = meta_surface_actor_get_texture (surface);
-  g_return_if_fail (stex);
-
-  meta_shaped_texture_set_mask_texture (stex, NULL);
-
   tex_width = meta_shaped_texture_get_width (stex);
   tex_height = meta_shaped_texture_get_height (stex);
 
@@ -932,41 +1211,16 @@ build_and_scan_frame_mask (MetaWindowActorX11    *actor_x11,
                                                stride);
   cr = cairo_create (image);
 
-  gdk_cairo_region (cr, shape_region);
-  cairo_fill (cr);
-
   if (window->frame)
     {
       cairo_region_t *frame_paint_region, *scanned_region;
-      cairo_rectangle_int_t rect = { 0, 0, tex_width, tex_height };
-      cairo_rectangle_int_t client_area;
       cairo_rectangle_int_t frame_rect;
 
-      /* If we update the shape regardless of the frozen state of the actor,
-       * as with Xwayland to avoid the black shadow effect, we ought to base
-       * the frame size on the buffer size rather than the reported window's
-       * frame size, as the buffer may not have been committed yet at this
-       * point.
-       */
-      if (meta_window_x11_always_update_shape (window))
-        {
-          meta_window_x11_surface_rect_to_frame_rect (window, &rect, &frame_rect);
-          get_client_area_rect_from_texture (actor_x11, stex, &client_area);
-        }
-      else
-        {
-          meta_window_get_frame_rect (window, &frame_rect);
-          meta_window_get_client_area_rect (window, &client_area);
-        }
+      get_frame_paint_region (actor_x11, stex,
+                              &frame_paint_region, &frame_rect);
 
-      /* Make sure we don't paint the frame over the client window. */
-      frame_paint_region = cairo_region_create_rectangle (&rect);
-      cairo_region_subtract_rectangle (frame_paint_region, &client_area);
-
-      gdk_cairo_region (cr, frame_paint_region);
-      cairo_clip (cr);
-
-      meta_frame_get_mask (window->frame, &frame_rect, cr);
+      paint_frame_mask (window, cr,
+                        shape_region, frame_paint_region, &frame_rect);
 
       cairo_surface_flush (image);
       scanned_region = scan_visible_region (mask_data, stride, frame_paint_region);
@@ -974,6 +1228,11 @@ build_and_scan_frame_mask (MetaWindowActorX11    *actor_x11,
       cairo_region_destroy (scanned_region);
       cairo_region_destroy (frame_paint_region);
     }
+  else
+    {
+      gdk_cairo_region (cr, shape_region);
+      cairo_fill (cr);
+    }
 
   cairo_destroy (cr);
   cairo_surface_destroy (image);
@@ -988,17 +1247,34 @@ build_and_scan_frame_mask (MetaWindowActorX11    *actor_x11,
       g_error_free (error);
     }
 
+  g_free (mask_data);
+
+  return COGL_TEXTURE (mask_texture);
+}
+
+static void
+build_and_scan_frame_mask (MetaWindowActorX11    *actor_x11,
+                           cairo_region_t        *shape_region)
+{
+  MetaSurfaceActor *surface =
+    meta_window_actor_get_surface (META_WINDOW_ACTOR (actor_x11));
+  MetaShapedTexture *stex;
+  CoglTexture *mask_texture;
+
+  stex = meta_surface_actor_get_texture (surface);
+  g_return_if_fail (stex);
+
+  meta_shaped_texture_set_mask_texture (stex, NULL);
+
+  mask_texture = build_frame_mask_texture_gpu (actor_x11, stex, shape_region);
+  if (!mask_texture)
+    mask_texture = build_frame_mask_texture_cpu (actor_x11, stex, shape_region);
+
   if (mask_texture)
     {
-      meta_shaped_texture_set_mask_texture (stex, COGL_TEXTURE (mask_texture));
+      meta_shaped_texture_set_mask_texture (stex, mask_texture);
       cogl_object_unref (mask_texture);
     }
-  else
-    {
-      meta_shaped_texture_set_mask_texture (stex, NULL);
-    }
-
-  g_free (mask_data);
 }
 
 static void
@@ -1217,7 +1493,14 @@ handle_updates (MetaWindowActorX11 *actor_x11)
        * However, with Xwayland, we still might need to update the shape
        * region as the wl_buffer will be set to plain black on resize,
        * which causes the shadows to look bad.
+       *
+       * A scaled down snapshot is only good enough for a hidden window, so
+       * a window remapped while frozen gets its pixmap back right away
+       * instead of being animated with the snapshot stretched.
        */
+      if (META_IS_SURFACE_ACTOR_X11 (surface))
+        meta_surface_actor_x11_restore_from_snapshot (META_SURFACE_ACTOR_X11 (surface));
+
       if (surface && meta_window_x11_always_update_shape (window))
         check_needs_reshape (actor_x11);
 
@@ -1244,6 +1527,8 @@ static void
 handle_stage_views_changed (MetaWindowActorX11 *actor_x11)
 {
   ClutterActor *actor = CLUTTER_ACTOR (actor_x11);
+  GList *stage_views;
+  GList *l;
 
   actor_x11->frame_clock = clutter_actor_pick_frame_clock (actor, NULL);
   if (actor_x11->frame_clock && actor_x11->pending_schedule_update_now)
@@ -1251,6 +1536,35 @@ handle_stage_views_changed (MetaWindowActorX11 *actor_x11)
       clutter_frame_clock_schedule_update_now (actor_x11->frame_clock);
       actor_x11->pending_schedule_update_now = FALSE;
     }
+
+  /* The views frames were assigned to may be going away, in which case
+   * they would never be presented. Complete the frames that were already
+   * drawn without timings, and leave the others to the new main view. */
+  stage_views = clutter_actor_peek_stage_views (actor);
+  for (l = actor_x11->frames; l;)
+    {
+      GList *l_next = l->next;
+      FrameData *frame = l->data;
+
+      if (frame->stage_view &&
+          !g_list_find (stage_views, frame->stage_view))
+        {
+          if (frame->frame_drawn_time != 0)
+            {
+              do_send_frame_timings (actor_x11, frame, 0, 0);
+
+              actor_x11->frames = g_list_delete_link (actor_x11->frames, l);
+              frame_data_free (frame);
+            }
+          else
+            {
+              frame->frame_counter = -1;
+              frame->stage_view = NULL;
+            }
+        }
+
+      l = l_next;
+    }
 }
 
 static void
@@ -1261,7 +1575,8 @@ meta_window_actor_x11_before_paint (MetaWindowActor  *actor,
 
   handle_updates (actor_x11);
 
-  assign_frame_counter_to_frames (actor_x11);
+  if (is_main_stage_view (actor_x11, stage_view))
+    assign_frame_counter_to_frames (actor_x11, stage_view);
 }
 
 static void
@@ -1269,6 +1584,7 @@ meta_window_actor_x11_paint (ClutterActor        *actor,
                              ClutterPaintContext *paint_context)
 {
   MetaWindowActorX11 *actor_x11 = META_WINDOW_ACTOR_X11 (actor);
+  ClutterStageView *stage_view;
   MetaWindow *window;
   gboolean appears_focused;
   MetaShadow *shadow;
@@ -1277,10 +1593,12 @@ meta_window_actor_x11_paint (ClutterActor        *actor,
   * to send frame completion events, but since we're drawing
   * the window now (for some other reason) cancel the timer
   * and send the completion events normally */
-  if (actor_x11->send_frame_messages_timer != 0)
+  stage_view = clutter_paint_context_get_stage_view (paint_context);
+  if (actor_x11->send_frame_messages_timer != 0 &&
+      is_main_stage_view (actor_x11, stage_view))
     {
       remove_frame_messages_timer (actor_x11);
-      assign_frame_counter_to_frames (actor_x11);
+      assign_frame_counter_to_frames (actor_x11, stage_view);
     }
 
   window = meta_window_actor_get_meta_window (META_WINDOW_ACTOR (actor_x11));
@@ -1349,7 +1667,8 @@ meta_window_actor_x11_after_paint (MetaWindowActor  *actor,
    * sending _NET_WM_FRAME_* messages.
    */
   if (actor_x11->send_frame_messages_timer == 0 &&
-      actor_x11->needs_frame_drawn)
+      actor_x11->needs_frame_drawn &&
+      is_main_stage_view (actor_x11, stage_view))
     {
       GList *l;
 
@@ -1357,7 +1676,8 @@ meta_window_actor_x11_after_paint (MetaWindowActor  *actor,
         {
           FrameData *frame = l->data;
 
-          if (frame->frame_drawn_time == 0)
+          if (frame->frame_drawn_time == 0 &&
+              frame->stage_view == stage_view)
             do_send_frame_drawn (actor_x11, frame);
         }
 
@@ -1467,6 +1787,30 @@ meta_window_actor_x11_can_freeze_commits (MetaWindowActor *actor)
   return clutter_actor_is_mapped (clutter_actor);
 }
 
+static void
+meta_window_actor_x11_release_textures (MetaWindowActor    *actor,
+                                        MetaTextureRelease  release)
+{
+  MetaWindowActorX11 *actor_x11 = META_WINDOW_ACTOR_X11 (actor);
+  MetaSurfaceActor *surface;
+
+  switch (release)
+    {
+    case META_TEXTURE_RELEASE_CACHES:
+      g_clear_pointer (&actor_x11->focused_shadow, meta_shadow_unref);
+      g_clear_pointer (&actor_x11->unfocused_shadow, meta_shadow_unref);
+      actor_x11->recompute_focused_shadow = TRUE;
+      actor_x11->recompute_unfocused_shadow = TRUE;
+      actor_x11->shadows_released = TRUE;
+      break;
+    case META_TEXTURE_RELEASE_CONTENTS:
+      surface = meta_window_actor_get_surface (actor);
+      if (META_IS_SURFACE_ACTOR_X11 (surface))
+        meta_surface_actor_x11_replace_with_snapshot (META_SURFACE_ACTOR_X11 (surface));
+      break;
+    }
+}
+
 static void
 meta_window_actor_x11_set_property (GObject      *object,
                                     guint         prop_id,
@@ -1642,6 +1986,7 @@ meta_window_actor_x11_class_init (MetaWindowActorX11Class *klass)
   window_actor_class->set_frozen = meta_window_actor_x11_set_frozen;
   window_actor_class->update_regions = meta_window_actor_x11_update_regions;
   window_actor_class->can_freeze_commits = meta_window_actor_x11_can_freeze_commits;
+  window_actor_class->release_textures = meta_window_actor_x11_release_textures;
 
   actor_class->paint = meta_window_actor_x11_paint;
   actor_class->get_paint_volume = meta_window_actor_x11_get_paint_volume;
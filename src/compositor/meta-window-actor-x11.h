@@ -36,6 +36,8 @@ void meta_window_actor_x11_process_x11_damage (MetaWindowActorX11 *actor_x11,
 
 gboolean meta_window_actor_x11_should_unredirect (MetaWindowActorX11 *actor_x11);
 
+gboolean meta_window_actor_x11_can_scanout (MetaWindowActorX11 *actor_x11);
+
 void meta_window_actor_x11_set_unredirected (MetaWindowActorX11 *actor_x11,
                                              gboolean            unredirected);
 
@@ -70,6 +70,8 @@ typedef struct _MetaWindowActorPrivate
 
   guint             freeze_count;
 
+  MetaTextureBudgetEntry *texture_budget_entry;
+
   guint		    visible                : 1;
   guint		    disposed               : 1;
 
@@ -397,6 +399,55 @@ init_surface_actor (MetaWindowActor *self)
     meta_window_actor_assign_surface_actor (self, surface_actor);
 }
 
+void
+meta_window_actor_get_texture_usage (MetaWindowActor  *self,
+                                     MetaTextureUsage *usage)
+{
+  MetaWindowActorPrivate *priv =
+    meta_window_actor_get_instance_private (self);
+  ClutterActor *actor = CLUTTER_ACTOR (self);
+
+  /* Windows only shown through clones, e.g. in the overview, still need
+   * their textures */
+  usage->visible = (clutter_actor_is_mapped (actor) ||
+                    clutter_actor_has_mapped_clones (actor));
+
+  if (!priv->surface)
+    return;
+
+  meta_shaped_texture_get_memory_usage (meta_surface_actor_get_texture (priv->surface),
+                                        &usage->cache_size,
+                                        &usage->content_size);
+
+  if (META_IS_SURFACE_ACTOR_X11 (priv->surface))
+    {
+      MetaSurfaceActorX11 *surface_x11 = META_SURFACE_ACTOR_X11 (priv->surface);
+
+      usage->has_snapshot = meta_surface_actor_x11_has_snapshot (surface_x11);
+    }
+}
+
+static void
+get_texture_usage (gpointer          user_data,
+                   MetaTextureUsage *usage)
+{
+  meta_window_actor_get_texture_usage (META_WINDOW_ACTOR (user_data), usage);
+}
+
+static void
+release_textures (gpointer           user_data,
+                  MetaTextureRelease release)
+{
+  MetaWindowActor *self = META_WINDOW_ACTOR (user_data);
+  MetaWindowActorPrivate *priv =
+    meta_window_actor_get_instance_private (self);
+
+  if (release == META_TEXTURE_RELEASE_CACHES && priv->surface)
+    meta_shaped_texture_release_caches (meta_surface_actor_get_texture (priv->surface));
+
+  META_WINDOW_ACTOR_GET_CLASS (self)->release_textures (self, release);
+}
+
 static void
 meta_window_actor_constructed (GObject *object)
 {
@@ -422,6 +473,12 @@ meta_window_actor_constructed (GObject *object)
     priv->first_frame_state = DRAWING_FIRST_FRAME;
 
   meta_window_actor_sync_actor_geometry (self, priv->window->placed);
+
+  priv->texture_budget_entry =
+    meta_texture_budget_add_entry (meta_compositor_get_texture_budget (priv->compositor),
+                                   get_texture_usage,
+                                   release_textures,
+                                   self);
 }
 
 static void
@@ -442,6 +499,13 @@ meta_window_actor_dispose (GObject *object)
 
   meta_compositor_remove_window_actor (compositor, self);
 
+  if (priv->texture_budget_entry)
+    {
+      meta_texture_budget_remove_entry (meta_compositor_get_texture_budget (compositor),
+                                        priv->texture_budget_entry);
+      priv->texture_budget_entry = NULL;
+    }
+
   g_clear_object (&priv->window);
 
   if (priv->surface)
@@ -1059,10 +1123,12 @@ meta_window_actor_after_paint (MetaWindowActor  *self,
 
 void
 meta_window_actor_frame_complete (MetaWindowActor  *self,
+                                  ClutterStageView *stage_view,
                                   ClutterFrameInfo *frame_info,
                                   gint64            presentation_time)
 {
   META_WINDOW_ACTOR_GET_CLASS (self)->frame_complete (self,
+                                                      stage_view,
                                                       frame_info,
                                                       presentation_time);
 }
@@ -1233,6 +1299,55 @@ meta_window_actor_transform_cursor_position (MetaScreenCastWindow *screen_cast_w
   return TRUE;
 }
 
+/*
+ * Returns the client buffer texture if the window content is exactly that
+ * buffer, in which case it can be copied into a stream as is instead of
+ * painting the window actor tree.
+ */
+static CoglTexture *
+get_forwardable_texture (MetaWindowActor *window_actor)
+{
+  MetaWindowActorPrivate *priv =
+    meta_window_actor_get_instance_private (window_actor);
+  MetaShapedTexture *stex;
+
+  if (!priv->surface)
+    return NULL;
+
+  /* Subsurfaces or other actors stacked with the window need compositing. */
+  if (clutter_actor_get_n_children (CLUTTER_ACTOR (window_actor)) != 1 ||
+      clutter_actor_get_n_children (CLUTTER_ACTOR (priv->surface)) != 0)
+    return NULL;
+
+  /* Copying the buffer as is would drop any translucency applied to it */
+  if (clutter_actor_get_opacity (CLUTTER_ACTOR (window_actor)) != 0xff ||
+      clutter_actor_get_opacity (CLUTTER_ACTOR (priv->surface)) != 0xff)
+    return NULL;
+
+  stex = meta_surface_actor_get_texture (priv->surface);
+
+  return meta_shaped_texture_get_untransformed_texture (stex);
+}
+
+static gboolean
+capture_texture_into (CoglTexture   *texture,
+                      MetaRectangle *bounds,
+                      uint8_t       *data)
+{
+  int bpp = 4;
+
+  if (cogl_texture_get_width (texture) != bounds->width ||
+      cogl_texture_get_height (texture) != bounds->height)
+    return FALSE;
+
+  if (!cogl_texture_is_get_data_supported (texture))
+    return FALSE;
+
+  return cogl_texture_get_data (texture, CLUTTER_CAIRO_FORMAT_ARGB32,
+                                bounds->width * bpp,
+                                data) > 0;
+}
+
 static void
 meta_window_actor_capture_into (MetaScreenCastWindow *screen_cast_window,
                                 MetaRectangle        *bounds,
@@ -1244,11 +1359,16 @@ meta_window_actor_capture_into (MetaScreenCastWindow *screen_cast_window,
   int cr_stride;
   int cr_width;
   int cr_height;
+  CoglTexture *texture;
   int bpp = 4;
 
   if (meta_window_actor_is_destroyed (window_actor))
     return;
 
+  texture = get_forwardable_texture (window_actor);
+  if (texture && capture_texture_into (texture, bounds, data))
+    return;
+
   image = meta_window_actor_get_image (window_actor, bounds);
   cr_data = cairo_image_surface_get_data (image);
   cr_width = cairo_image_surface_get_width (image);
@@ -1289,6 +1409,54 @@ meta_window_actor_capture_into (MetaScreenCastWindow *screen_cast_window,
   cairo_surface_destroy (image);
 }
 
+static void
+blit_texture_to_framebuffer (CoglTexture     *texture,
+                             CoglFramebuffer *framebuffer)
+{
+  CoglContext *cogl_context = cogl_framebuffer_get_context (framebuffer);
+  CoglPipeline *pipeline;
+  int framebuffer_width;
+  int framebuffer_height;
+  int texture_width;
+  int texture_height;
+
+  framebuffer_width = cogl_framebuffer_get_width (framebuffer);
+  framebuffer_height = cogl_framebuffer_get_height (framebuffer);
+  texture_width = cogl_texture_get_width (texture);
+  texture_height = cogl_texture_get_height (texture);
+
+  if (texture_width < framebuffer_width ||
+      texture_height < framebuffer_height)
+    {
+      CoglColor clear_color;
+
+      cogl_color_init_from_4ub (&clear_color, 0, 0, 0, 0);
+      cogl_framebuffer_clear (framebuffer, COGL_BUFFER_BIT_COLOR,
+                              &clear_color);
+    }
+
+  cogl_framebuffer_orthographic (framebuffer,
+                                 0, 0,
+                                 framebuffer_width, framebuffer_height,
+                                 0, 1.0);
+  cogl_framebuffer_set_viewport (framebuffer,
+                                 0, 0,
+                                 framebuffer_width, framebuffer_height);
+
+  pipeline = cogl_pipeline_new (cogl_context);
+  cogl_pipeline_set_layer_texture (pipeline, 0, texture);
+  cogl_pipeline_set_layer_filters (pipeline, 0,
+                                   COGL_PIPELINE_FILTER_NEAREST,
+                                   COGL_PIPELINE_FILTER_NEAREST);
+  cogl_pipeline_set_blend (pipeline, "RGBA = ADD (SRC_COLOR, 0)", NULL);
+
+  cogl_framebuffer_draw_rectangle (framebuffer, pipeline,
+                                   0, 0,
+                                   texture_width, texture_height);
+
+  cogl_object_unref (pipeline);
+}
+
 static gboolean
 meta_window_actor_blit_to_framebuffer (MetaScreenCastWindow *screen_cast_window,
                                        MetaRectangle        *bounds,
@@ -1299,6 +1467,7 @@ meta_window_actor_blit_to_framebuffer (MetaScreenCastWindow *screen_cast_window,
   ClutterPaintContext *paint_context;
   MetaRectangle scaled_clip;
   CoglColor clear_color;
+  CoglTexture *texture;
   float resource_scale;
   float width, height;
   float x, y;
@@ -1306,6 +1475,13 @@ meta_window_actor_blit_to_framebuffer (MetaScreenCastWindow *screen_cast_window,
   if (meta_window_actor_is_destroyed (window_actor))
     return FALSE;
 
+  texture = get_forwardable_texture (window_actor);
+  if (texture)
+    {
+      blit_texture_to_framebuffer (texture, framebuffer);
+      return TRUE;
+    }
+
   clutter_actor_get_size (actor, &width, &height);
 
   if (width == 0 || height == 0)
@@ -10,6 +10,7 @@
 #include "compositor/meta-cullable.h"
 #include "compositor/meta-window-actor-private.h"
 #include "compositor/meta-window-group-private.h"
+#include "compositor/region-utils.h"
 #include "core/display-private.h"
 #include "core/window-private.h"
 
@@ -51,6 +52,83 @@ cullable_iface_init (MetaCullableInterface *iface)
   iface->reset_culling = meta_window_group_reset_culling;
 }
 
+static gboolean
+get_painting_transform (ClutterPaintContext *paint_context,
+                        int                  paint_width,
+                        int                  paint_height,
+                        float               *x_origin,
+                        float               *y_origin,
+                        float               *x_scale,
+                        float               *y_scale)
+{
+  CoglFramebuffer *fb;
+  ClutterStageView *view;
+  cairo_rectangle_int_t view_layout;
+  float view_scale;
+
+  fb = clutter_paint_context_get_framebuffer (paint_context);
+  if (!meta_actor_painting_axis_aligned (fb,
+                                         paint_width,
+                                         paint_height,
+                                         x_origin,
+                                         y_origin,
+                                         x_scale,
+                                         y_scale))
+    return FALSE;
+
+  /* The painting transform ends in framebuffer pixels, which on a scaled
+   * or offset stage view differ from the stage coordinates of the redraw
+   * clip. */
+  view = clutter_paint_context_get_stage_view (paint_context);
+  if (!view || fb != clutter_stage_view_get_framebuffer (view))
+    return TRUE;
+
+  clutter_stage_view_get_layout (view, &view_layout);
+  view_scale = clutter_stage_view_get_scale (view);
+
+  *x_origin = *x_origin / view_scale + view_layout.x;
+  *y_origin = *y_origin / view_scale + view_layout.y;
+  *x_scale /= view_scale;
+  *y_scale /= view_scale;
+
+  return TRUE;
+}
+
+/* The window group has no size of its own (see
+ * meta_window_group_get_preferred_width()), so the transform is measured
+ * on a box of the size of the screen instead of on its allocation. */
+static gboolean
+get_stage_transform (ClutterActor *actor,
+                     int           screen_width,
+                     int           screen_height,
+                     float        *x_origin,
+                     float        *y_origin,
+                     float        *x_scale,
+                     float        *y_scale)
+{
+  graphene_point3d_t corners[4];
+  graphene_point3d_t verts[4];
+  int i;
+
+  corners[0] = GRAPHENE_POINT3D_INIT (0, 0, 0);
+  corners[1] = GRAPHENE_POINT3D_INIT (screen_width, 0, 0);
+  corners[2] = GRAPHENE_POINT3D_INIT (0, screen_height, 0);
+  corners[3] = GRAPHENE_POINT3D_INIT (screen_width, screen_height, 0);
+
+  for (i = 0; i < 4; i++)
+    {
+      clutter_actor_apply_transform_to_point (actor, &corners[i], &verts[i]);
+
+      /* The projected depth is not meaningful here */
+      verts[i].z = 0;
+    }
+
+  return meta_actor_vertices_are_axis_aligned (verts,
+                                               screen_width, screen_height,
+                                               x_origin, y_origin,
+                                               x_scale, y_scale);
+}
+
 static void
 meta_window_group_paint (ClutterActor        *actor,
                          ClutterPaintContext *paint_context)
@@ -62,8 +140,12 @@ meta_window_group_paint (ClutterActor        *actor,
   const cairo_region_t *redraw_clip;
   cairo_region_t *clip_region;
   cairo_region_t *unobscured_region;
+  cairo_region_t *visible_region;
   cairo_rectangle_int_t visible_rect;
-  int paint_x_origin, paint_y_origin;
+  float paint_x_origin, paint_y_origin;
+  float paint_x_scale, paint_y_scale;
+  float stage_x_origin, stage_y_origin;
+  float stage_x_scale, stage_y_scale;
   int screen_width, screen_height;
 
   redraw_clip = clutter_paint_context_get_redraw_clip (paint_context);
@@ -79,8 +161,9 @@ meta_window_group_paint (ClutterActor        *actor,
    * However, if we're inside the paint of a ClutterClone, that won't be the
    * case and we need to compensate. We look at the position of the window
    * group under the current model-view matrix and the position of the actor.
-   * If they are both simply integer translations, then we can compensate
-   * easily, otherwise we give up.
+   * If they are both only scaled along the axes and translated, then we can
+   * compensate by converting the regions with conservative rounding,
+   * otherwise we give up.
    *
    * Possible cleanup: work entirely in paint space - we can compute the
    * combination of the model-view matrix with the local matrix for each child
@@ -88,19 +171,20 @@ meta_window_group_paint (ClutterActor        *actor,
    * painting currently, and never worry about how actors are positioned
    * on the stage.
    */
+  if (!get_stage_transform (actor, screen_width, screen_height,
+                            &stage_x_origin, &stage_y_origin,
+                            &stage_x_scale, &stage_y_scale))
+    {
+      parent_actor_class->paint (actor, paint_context);
+      return;
+    }
+
   if (clutter_actor_is_in_clone_paint (actor))
     {
-      CoglFramebuffer *fb;
-
-      fb = clutter_paint_context_get_framebuffer (paint_context);
-      if (!meta_actor_painting_untransformed (fb,
-                                              screen_width,
-                                              screen_height,
-                                              screen_width,
-                                              screen_height,
-                                              &paint_x_origin,
-                                              &paint_y_origin) ||
-          !meta_cullable_is_untransformed (META_CULLABLE (actor)))
+      if (!get_painting_transform (paint_context,
+                                   screen_width, screen_height,
+                                   &paint_x_origin, &paint_y_origin,
+                                   &paint_x_scale, &paint_y_scale))
         {
           parent_actor_class->paint (actor, paint_context);
           return;
@@ -108,24 +192,40 @@ meta_window_group_paint (ClutterActor        *actor,
     }
   else
     {
-      paint_x_origin = 0;
-      paint_y_origin = 0;
+      paint_x_origin = stage_x_origin;
+      paint_y_origin = stage_y_origin;
+      paint_x_scale = stage_x_scale;
+      paint_y_scale = stage_y_scale;
     }
 
   visible_rect.x = visible_rect.y = 0;
   visible_rect.width = clutter_actor_get_width (CLUTTER_ACTOR (stage));
   visible_rect.height = clutter_actor_get_height (CLUTTER_ACTOR (stage));
 
-  unobscured_region = cairo_region_create_rectangle (&visible_rect);
+  /* Both regions are grown when converted into the coordinate space of the
+   * window group, so that nothing that might be visible is culled out. */
+  visible_region = meta_region_pool_acquire_rectangle (&visible_rect);
+  unobscured_region =
+    meta_region_scale_and_translate_double (visible_region,
+                                            1.0 / stage_x_scale,
+                                            1.0 / stage_y_scale,
+                                            -stage_x_origin / stage_x_scale,
+                                            -stage_y_origin / stage_y_scale,
+                                            META_ROUNDING_STRATEGY_GROW);
+  meta_region_pool_release (visible_region);
 
   /* Get the clipped redraw bounds so that we can avoid painting shadows on
    * windows that don't need to be painted in this frame. In the case of a
    * multihead setup with mismatched monitor sizes, we could intersect this
    * with an accurate union of the monitors to avoid painting shadows that are
    * visible only in the holes. */
-  clip_region = cairo_region_copy (redraw_clip);
-
-  cairo_region_translate (clip_region, -paint_x_origin, -paint_y_origin);
+  clip_region =
+    meta_region_scale_and_translate_double (redraw_clip,
+                                            1.0 / paint_x_scale,
+                                            1.0 / paint_y_scale,
+                                            -paint_x_origin / paint_x_scale,
+                                            -paint_y_origin / paint_y_scale,
+                                            META_ROUNDING_STRATEGY_GROW);
 
   meta_cullable_cull_out (META_CULLABLE (window_group), unobscured_region, clip_region);
 
@@ -136,6 +136,81 @@ meta_region_builder_finish (MetaRegionBuilder *builder)
 }
 
 
+/* Region pool */
+
+/* Culling creates and destroys a handful of temporary regions per window
+ * on every frame. Most of them hold a single rectangle, which pixman stores
+ * inline, so recycling the regions themselves makes them free to create.
+ *
+ * Regions may only be released into the pool by the holder of their only
+ * reference, and the pool may only be used from the main thread. Regions
+ * that outlive the culling pass, such as the ones cullables keep for
+ * painting, should be plain copies, as they are not returned to the pool.
+ */
+#define MAX_POOLED_REGIONS 32
+
+static cairo_region_t *region_pool[MAX_POOLED_REGIONS];
+static int n_pooled_regions;
+static unsigned int n_pool_hits;
+static unsigned int n_pool_misses;
+
+cairo_region_t *
+meta_region_pool_acquire (void)
+{
+  if (n_pooled_regions > 0)
+    {
+      n_pool_hits++;
+      return region_pool[--n_pooled_regions];
+    }
+
+  n_pool_misses++;
+  return cairo_region_create ();
+}
+
+cairo_region_t *
+meta_region_pool_acquire_copy (const cairo_region_t *region)
+{
+  cairo_region_t *copy;
+
+  copy = meta_region_pool_acquire ();
+  cairo_region_union (copy, region);
+
+  return copy;
+}
+
+cairo_region_t *
+meta_region_pool_acquire_rectangle (const cairo_rectangle_int_t *rect)
+{
+  cairo_region_t *region;
+
+  region = meta_region_pool_acquire ();
+  cairo_region_union_rectangle (region, rect);
+
+  return region;
+}
+
+void
+meta_region_pool_release (cairo_region_t *region)
+{
+  if (n_pooled_regions == MAX_POOLED_REGIONS ||
+      cairo_region_status (region) != CAIRO_STATUS_SUCCESS)
+    {
+      cairo_region_destroy (region);
+      return;
+    }
+
+  cairo_region_subtract (region, region);
+  region_pool[n_pooled_regions++] = region;
+}
+
+void
+meta_region_pool_get_stats (unsigned int *n_hits,
+                            unsigned int *n_misses)
+{
+  *n_hits = n_pool_hits;
+  *n_misses = n_pool_misses;
+}
+
 /* MetaRegionIterator */
 
 void
@@ -214,6 +289,108 @@ meta_region_scale_double (cairo_region_t       *region,
   return scaled_region;
 }
 
+/* Coordinates within this distance of a pixel boundary are snapped to it,
+ * so that floating point noise doesn't grow or shrink regions by a pixel.
+ */
+#define PIXEL_SNAP_EPSILON 1e-4
+
+static double
+snap_to_pixel (double value)
+{
+  double rounded = round (value);
+
+  if (fabs (value - rounded) < PIXEL_SNAP_EPSILON)
+    return rounded;
+  else
+    return value;
+}
+
+static int
+round_edge (double               value,
+            gboolean             is_start,
+            MetaRoundingStrategy rounding_strategy)
+{
+  value = snap_to_pixel (value);
+
+  switch (rounding_strategy)
+    {
+    case META_ROUNDING_STRATEGY_SHRINK:
+      return is_start ? ceil (value) : floor (value);
+    case META_ROUNDING_STRATEGY_GROW:
+      return is_start ? floor (value) : ceil (value);
+    case META_ROUNDING_STRATEGY_ROUND:
+      break;
+    }
+
+  return round (value);
+}
+
+/* Scales @region by @x_scale and @y_scale, then translates it by @x_offset
+ * and @y_offset. Unlike meta_region_scale_double(), the rounding is applied
+ * to the edges of each rectangle: growing results in every pixel touched by
+ * the transformed region, shrinking in only the pixels that are fully
+ * covered by it.
+ */
+cairo_region_t *
+meta_region_scale_and_translate_double (const cairo_region_t *region,
+                                        double                x_scale,
+                                        double                y_scale,
+                                        double                x_offset,
+                                        double                y_offset,
+                                        MetaRoundingStrategy  rounding_strategy)
+{
+  int n_rects, n_scaled_rects, i;
+  cairo_rectangle_int_t *rects;
+
+  g_return_val_if_fail (x_scale > 0.0 && y_scale > 0.0, NULL);
+
+  if (G_APPROX_VALUE (x_scale, 1.0, FLT_EPSILON) &&
+      G_APPROX_VALUE (y_scale, 1.0, FLT_EPSILON) &&
+      snap_to_pixel (x_offset) == round (x_offset) &&
+      snap_to_pixel (y_offset) == round (y_offset))
+    {
+      cairo_region_t *translated_region;
+
+      translated_region = cairo_region_copy (region);
+      cairo_region_translate (translated_region,
+                              round (x_offset), round (y_offset));
+
+      return translated_region;
+    }
+
+  n_rects = cairo_region_num_rectangles (region);
+  META_REGION_CREATE_RECTANGLE_ARRAY_SCOPED (n_rects, rects);
+  n_scaled_rects = 0;
+  for (i = 0; i < n_rects; i++)
+    {
+      cairo_rectangle_int_t rect;
+      int x1, y1, x2, y2;
+
+      cairo_region_get_rectangle (region, i, &rect);
+
+      x1 = round_edge (rect.x * x_scale + x_offset,
+                       TRUE, rounding_strategy);
+      y1 = round_edge (rect.y * y_scale + y_offset,
+                       TRUE, rounding_strategy);
+      x2 = round_edge ((rect.x + rect.width) * x_scale + x_offset,
+                       FALSE, rounding_strategy);
+      y2 = round_edge ((rect.y + rect.height) * y_scale + y_offset,
+                       FALSE, rounding_strategy);
+
+      if (x2 <= x1 || y2 <= y1)
+        continue;
+
+      rects[n_scaled_rects++] = (cairo_rectangle_int_t) {
+        .x = x1,
+        .y = y1,
+        .width = x2 - x1,
+        .height = y2 - y1,
+      };
+    }
+
+  return cairo_region_create_rectangles (rects, n_scaled_rects);
+}
+
 cairo_region_t *
 meta_region_scale (cairo_region_t *region, int scale)
 {
@@ -89,6 +89,13 @@ void     meta_region_builder_add_rectangle (MetaRegionBuilder *builder,
                                             int                height);
 cairo_region_t * meta_region_builder_finish (MetaRegionBuilder *builder);
 
+cairo_region_t * meta_region_pool_acquire           (void);
+cairo_region_t * meta_region_pool_acquire_copy      (const cairo_region_t        *region);
+cairo_region_t * meta_region_pool_acquire_rectangle (const cairo_rectangle_int_t *rect);
+void             meta_region_pool_release           (cairo_region_t              *region);
+void             meta_region_pool_get_stats         (unsigned int                *n_hits,
+                                                     unsigned int                *n_misses);
+
 void     meta_region_iterator_init      (MetaRegionIterator *iter,
                                          cairo_region_t     *region);
 gboolean meta_region_iterator_at_end    (MetaRegionIterator *iter);
@@ -101,6 +108,13 @@ cairo_region_t * meta_region_scale_double (cairo_region_t       *region,
                                            double                scale,
                                            MetaRoundingStrategy  rounding_strategy);
 
+cairo_region_t * meta_region_scale_and_translate_double (const cairo_region_t *region,
+                                                         double                x_scale,
+                                                         double                y_scale,
+                                                         double                x_offset,
+                                                         double                y_offset,
+                                                         MetaRoundingStrategy  rounding_strategy);
+
 cairo_region_t * meta_make_border_region (cairo_region_t *region,
                                           int             x_amount,
                                           int             y_amount,
@@ -1101,6 +1101,7 @@ meta_display_close (MetaDisplay *display,
 
   meta_display_shutdown_x11 (display);
 
+  meta_display_cleanup_edges (display);
   g_clear_object (&display->stack);
   g_clear_pointer (&display->stack_tracker,
                    meta_stack_tracker_free);
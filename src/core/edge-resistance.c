@@ -61,6 +61,8 @@ struct MetaEdgeResistanceData
   ResistanceDataForAnEdge right_data;
   ResistanceDataForAnEdge top_data;
   ResistanceDataForAnEdge bottom_data;
+
+  gulong stack_changed_id;
 };
 
 static void compute_resistance_and_snapping_edges (MetaDisplay *display);
@@ -551,7 +553,8 @@ apply_edge_resistance_to_each_side (MetaDisplay         *display,
   gboolean                modified;
   int new_left, new_right, new_top, new_bottom;
 
-  if (display->grab_edge_resistance_data == NULL)
+  if (display->grab_edge_resistance_data == NULL ||
+      display->grab_edge_resistance_data->left_edges == NULL)
     compute_resistance_and_snapping_edges (display);
 
   edge_data = display->grab_edge_resistance_data;
@@ -711,16 +714,12 @@ apply_edge_resistance_to_each_side (MetaDisplay         *display,
   return modified;
 }
 
-void
-meta_display_cleanup_edges (MetaDisplay *display)
+static void
+free_edges (MetaEdgeResistanceData *edge_data)
 {
   guint i,j;
-  MetaEdgeResistanceData *edge_data = display->grab_edge_resistance_data;
   GHashTable *edges_to_be_freed;
 
-  if (edge_data == NULL) /* Not currently cached */
-    return;
-
   /* We first need to clean out any window edges */
   edges_to_be_freed = g_hash_table_new_full (g_direct_hash, g_direct_equal,
                                              g_free, NULL);
@@ -769,7 +768,7 @@ meta_display_cleanup_edges (MetaDisplay *display)
   /* Now free all the window edges (the key destroy function is g_free) */
   g_hash_table_destroy (edges_to_be_freed);
 
-  /* Now free the arrays and data */
+  /* Now free the arrays */
   g_array_free (edge_data->left_edges, TRUE);
   g_array_free (edge_data->right_edges, TRUE);
   g_array_free (edge_data->top_edges, TRUE);
@@ -778,6 +777,20 @@ meta_display_cleanup_edges (MetaDisplay *display)
   edge_data->right_edges = NULL;
   edge_data->top_edges = NULL;
   edge_data->bottom_edges = NULL;
+}
+
+void
+meta_display_cleanup_edges (MetaDisplay *display)
+{
+  MetaEdgeResistanceData *edge_data = display->grab_edge_resistance_data;
+
+  if (edge_data == NULL) /* Not currently cached */
+    return;
+
+  if (edge_data->left_edges != NULL)
+    free_edges (edge_data);
+
+  g_clear_signal_handler (&edge_data->stack_changed_id, display->stack);
 
   /* Cleanup the timeouts */
   if (edge_data->left_data.timeout_setup)
@@ -887,9 +900,8 @@ cache_edges (MetaDisplay *display,
   /*
    * 2nd: Allocate the edges
    */
-  g_assert (display->grab_edge_resistance_data == NULL);
-  display->grab_edge_resistance_data = g_new0 (MetaEdgeResistanceData, 1);
   edge_data = display->grab_edge_resistance_data;
+  g_assert (edge_data->left_edges == NULL);
   edge_data->left_edges   = g_array_sized_new (FALSE,
                                                FALSE,
                                                sizeof(MetaEdge*),
@@ -982,26 +994,201 @@ initialize_grab_edge_resistance_data (MetaDisplay *display)
   edge_data->bottom_data.keyboard_buildup = 0;
 }
 
+/* Windows that may obscure the edges of the windows below them are kept
+ * in a grid of cells of this size, so that the edges of a window only
+ * need to be checked against the windows near it.
+ */
+#define OBSCURING_CELL_SIZE 256
+
+typedef struct _ObscuringWindow
+{
+  MetaRectangle rect;
+  int           stack_position;
+  guint         query_serial;
+} ObscuringWindow;
+
+typedef struct _ObscuringGrid
+{
+  MetaRectangle bounds;
+  int           n_columns;
+  int           n_rows;
+  GPtrArray   **cells;
+  guint         query_serial;
+} ObscuringGrid;
+
+static int
+get_cell_index (int start,
+                int pos,
+                int n_cells)
+{
+  int index = (pos - start) / OBSCURING_CELL_SIZE;
+
+  /* Windows partly offscreen are kept in the cells along the border */
+  return CLAMP (index, 0, n_cells - 1);
+}
+
+/* Calls func for each cell touched by rect, including its boundary, as
+ * edges touching a window are still split by it.
+ */
 static void
-compute_resistance_and_snapping_edges (MetaDisplay *display)
+obscuring_grid_foreach_cell (ObscuringGrid       *grid,
+                             const MetaRectangle *rect,
+                             GFunc                func,
+                             gpointer             user_data)
+{
+  int first_column, last_column, first_row, last_row;
+  int column, row;
+
+  first_column = get_cell_index (grid->bounds.x, rect->x, grid->n_columns);
+  last_column = get_cell_index (grid->bounds.x, BOX_RIGHT (*rect),
+                                grid->n_columns);
+  first_row = get_cell_index (grid->bounds.y, rect->y, grid->n_rows);
+  last_row = get_cell_index (grid->bounds.y, BOX_BOTTOM (*rect),
+                             grid->n_rows);
+
+  for (row = first_row; row <= last_row; row++)
+    {
+      for (column = first_column; column <= last_column; column++)
+        func (grid->cells[row * grid->n_columns + column], user_data);
+    }
+}
+
+static ObscuringGrid *
+obscuring_grid_new (const MetaRectangle *bounds)
+{
+  ObscuringGrid *grid;
+  int i;
+
+  grid = g_new0 (ObscuringGrid, 1);
+  grid->bounds = *bounds;
+  grid->n_columns = MAX (1, (bounds->width + OBSCURING_CELL_SIZE - 1) /
+                            OBSCURING_CELL_SIZE);
+  grid->n_rows = MAX (1, (bounds->height + OBSCURING_CELL_SIZE - 1) /
+                         OBSCURING_CELL_SIZE);
+  grid->cells = g_new (GPtrArray *, grid->n_columns * grid->n_rows);
+  for (i = 0; i < grid->n_columns * grid->n_rows; i++)
+    grid->cells[i] = g_ptr_array_new ();
+
+  return grid;
+}
+
+static void
+obscuring_grid_free (ObscuringGrid *grid)
+{
+  int i;
+
+  for (i = 0; i < grid->n_columns * grid->n_rows; i++)
+    g_ptr_array_free (grid->cells[i], TRUE);
+  g_free (grid->cells);
+  g_free (grid);
+}
+
+static void
+add_to_cell (gpointer data,
+             gpointer user_data)
+{
+  g_ptr_array_add (data, user_data);
+}
+
+static void
+obscuring_grid_add (ObscuringGrid   *grid,
+                    ObscuringWindow *window)
+{
+  obscuring_grid_foreach_cell (grid, &window->rect, add_to_cell, window);
+}
+
+typedef struct
+{
+  ObscuringGrid *grid;
+  int            stack_position;
+  GPtrArray     *found;
+} ObscuringQuery;
+
+static void
+find_in_cell (gpointer data,
+              gpointer user_data)
+{
+  GPtrArray *cell = data;
+  ObscuringQuery *query = user_data;
+  guint i;
+
+  for (i = 0; i < cell->len; i++)
+    {
+      ObscuringWindow *window = g_ptr_array_index (cell, i);
+
+      if (window->stack_position <= query->stack_position ||
+          window->query_serial == query->grid->query_serial)
+        continue;
+
+      window->query_serial = query->grid->query_serial;
+      g_ptr_array_add (query->found, window);
+    }
+}
+
+static int
+compare_stack_position (gconstpointer a,
+                        gconstpointer b)
+{
+  const ObscuringWindow *window_a = *(ObscuringWindow **) a;
+  const ObscuringWindow *window_b = *(ObscuringWindow **) b;
+
+  return window_a->stack_position - window_b->stack_position;
+}
+
+/* Returns the rectangles of the windows stacked above stack_position that
+ * may obscure part of rect, from bottom to top.
+ */
+static GSList *
+obscuring_grid_find_above (ObscuringGrid       *grid,
+                           const MetaRectangle *rect,
+                           int                  stack_position)
+{
+  ObscuringQuery query;
+  GSList *rects = NULL;
+  guint i;
+
+  query.grid = grid;
+  query.stack_position = stack_position;
+  query.found = g_ptr_array_new ();
+
+  grid->query_serial++;
+  obscuring_grid_foreach_cell (grid, rect, find_in_cell, &query);
+
+  g_ptr_array_sort (query.found, compare_stack_position);
+  for (i = query.found->len; i > 0; i--)
+    {
+      ObscuringWindow *window = g_ptr_array_index (query.found, i - 1);
+
+      rects = g_slist_prepend (rects, &window->rect);
+    }
+
+  g_ptr_array_free (query.found, TRUE);
+
+  return rects;
+}
+
+static void
+compute_window_edges (MetaDisplay *display)
 {
   GList *stacked_windows;
   GList *cur_window_iter;
   GList *edges;
-  /* Lists of window positions (rects) and their relative stacking positions */
+  /* Windows that can obscure the edges of those below them */
   int stack_position;
-  GSList *obscuring_windows, *window_stacking;
-  /* The portions of the above lists that still remain at the stacking position
-   * in the layer that we are working on
-   */
-  GSList *rem_windows, *rem_win_stacking;
+  GArray *obscuring_windows;
+  ObscuringGrid *grid;
+  MetaRectangle display_rect = { 0 };
   MetaWorkspaceManager *workspace_manager = display->workspace_manager;
+  guint i;
 
   g_assert (display->grab_window != NULL);
   meta_topic (META_DEBUG_WINDOW_OPS,
               "Computing edges to resist-movement or snap-to for %s.\n",
               display->grab_window->desc);
 
+  meta_display_get_size (display,
+                         &display_rect.width, &display_rect.height);
+
   /*
    * 1st: Get the list of relevant windows, from bottom to top
    */
@@ -1010,12 +1197,11 @@ compute_resistance_and_snapping_edges (MetaDisplay *display)
                              workspace_manager->active_workspace);
 
   /*
-   * 2nd: we need to separate that stacked list into a list of windows that
-   * can obscure other edges.  To make sure we only have windows obscuring
-   * those below it instead of going both ways, we also need to keep a
-   * counter list.  Messy, I know.
+   * 2nd: we need to index the windows that can obscure other edges by
+   * location.  To make sure we only have windows obscuring those below
+   * it instead of going both ways, we also keep their stacking position.
    */
-  obscuring_windows = window_stacking = NULL;
+  obscuring_windows = g_array_new (FALSE, FALSE, sizeof (ObscuringWindow));
   cur_window_iter = stacked_windows;
   stack_position = 0;
   while (cur_window_iter != NULL)
@@ -1023,25 +1209,26 @@ compute_resistance_and_snapping_edges (MetaDisplay *display)
       MetaWindow *cur_window = cur_window_iter->data;
       if (WINDOW_EDGES_RELEVANT (cur_window, display))
         {
-          MetaRectangle *new_rect;
-          new_rect = g_new (MetaRectangle, 1);
-          meta_window_get_frame_rect (cur_window, new_rect);
-          obscuring_windows = g_slist_prepend (obscuring_windows, new_rect);
-          window_stacking =
-            g_slist_prepend (window_stacking, GINT_TO_POINTER (stack_position));
+          ObscuringWindow obscuring = { 0 };
+
+          meta_window_get_frame_rect (cur_window, &obscuring.rect);
+          obscuring.stack_position = stack_position;
+          g_array_append_val (obscuring_windows, obscuring);
         }
 
       stack_position++;
       cur_window_iter = cur_window_iter->next;
     }
-  /* Put 'em in bottom to top order */
-  rem_windows = obscuring_windows = g_slist_reverse (obscuring_windows);
-  rem_win_stacking = window_stacking = g_slist_reverse (window_stacking);
+
+  /* The array doesn't grow anymore, so pointers to its elements are stable */
+  grid = obscuring_grid_new (&display_rect);
+  for (i = 0; i < obscuring_windows->len; i++)
+    obscuring_grid_add (grid, &g_array_index (obscuring_windows,
+                                              ObscuringWindow, i));
 
   /*
    * 3rd: loop over the windows again, this time getting the edges from
-   * them and removing intersections with the relevant obscuring_windows &
-   * obscuring_docks.
+   * them and removing intersections with the obscuring windows above them.
    */
   edges = NULL;
   stack_position = 0;
@@ -1060,13 +1247,10 @@ compute_resistance_and_snapping_edges (MetaDisplay *display)
           cur_window->type != META_WINDOW_DOCK)
         {
           GList *new_edges;
+          GSList *rem_windows;
           MetaEdge *new_edge;
-          MetaRectangle display_rect = { 0 };
           MetaRectangle reduced;
 
-          meta_display_get_size (display,
-                                 &display_rect.width, &display_rect.height);
-
           /* We don't care about snapping to any portion of the window that
            * is offscreen (we also don't care about parts of edges covered
            * by other windows or DOCKS, but that's handled below).
@@ -1119,21 +1303,18 @@ compute_resistance_and_snapping_edges (MetaDisplay *display)
           new_edge->edge_type = META_EDGE_WINDOW;
           new_edges = g_list_prepend (new_edges, new_edge);
 
-          /* Update the remaining windows to only those at a higher
-           * stacking position than this one.
+          /* Find the windows at a higher stacking position than this one
+           * that are close enough to overlap its edges.
            */
-          while (rem_win_stacking &&
-                 stack_position >= GPOINTER_TO_INT (rem_win_stacking->data))
-            {
-              rem_windows      = rem_windows->next;
-              rem_win_stacking = rem_win_stacking->next;
-            }
+          rem_windows = obscuring_grid_find_above (grid, &reduced,
+                                                   stack_position);
 
           /* Remove edge portions overlapped by rem_windows and rem_docks */
           new_edges =
             meta_rectangle_remove_intersections_with_boxes_from_edges (
               new_edges,
               rem_windows);
+          g_slist_free (rem_windows);
 
           /* Save the new edges */
           edges = g_list_concat (new_edges, edges);
@@ -1147,9 +1328,9 @@ compute_resistance_and_snapping_edges (MetaDisplay *display)
    * 4th: Free the extra memory not needed and sort the list
    */
   g_list_free (stacked_windows);
-  /* Free the memory used by the obscuring windows/docks lists */
-  g_slist_free (window_stacking);
-  g_slist_free_full (obscuring_windows, g_free);
+  /* Free the memory used by the obscuring windows index */
+  obscuring_grid_free (grid);
+  g_array_free (obscuring_windows, TRUE);
 
   /* Sort the list.  FIXME: Should I bother with this sorting?  I just
    * sort again later in cache_edges() anyway...
@@ -1166,11 +1347,58 @@ compute_resistance_and_snapping_edges (MetaDisplay *display)
                workspace_manager->active_workspace->monitor_edges,
                workspace_manager->active_workspace->screen_edges);
   g_list_free (edges);
+}
 
-  /*
-   * 6th: Initialize the resistance timeouts and buildups
-   */
-  initialize_grab_edge_resistance_data (display);
+static void
+on_stack_changed (MetaStack   *stack,
+                  MetaDisplay *display)
+{
+  meta_display_invalidate_edges (display);
+}
+
+static void
+compute_resistance_and_snapping_edges (MetaDisplay *display)
+{
+  MetaEdgeResistanceData *edge_data;
+
+  if (display->grab_edge_resistance_data == NULL)
+    {
+      display->grab_edge_resistance_data = g_new0 (MetaEdgeResistanceData, 1);
+      edge_data = display->grab_edge_resistance_data;
+
+      /* Edges obscured by windows raised or lowered during the grab change */
+      edge_data->stack_changed_id =
+        g_signal_connect (display->stack, "changed",
+                          G_CALLBACK (on_stack_changed), display);
+
+      /* Initialize the resistance timeouts and buildups */
+      initialize_grab_edge_resistance_data (display);
+    }
+
+  compute_window_edges (display);
+}
+
+/**
+ * meta_display_invalidate_edges:
+ * @display: a #MetaDisplay
+ *
+ * Makes the edges used for resistance and snapping during the current grab
+ * be computed again on the next motion, as windows other than the grabbed
+ * one moved or changed stacking. The resistance timeouts and buildups are
+ * kept.
+ */
+void
+meta_display_invalidate_edges (MetaDisplay *display)
+{
+  MetaEdgeResistanceData *edge_data = display->grab_edge_resistance_data;
+
+  if (edge_data == NULL || edge_data->left_edges == NULL)
+    return;
+
+  meta_topic (META_DEBUG_EDGE_RESISTANCE,
+              "Windows changed during the grab, invalidating edges\n");
+
+  free_edges (edge_data);
 }
 
 void
@@ -75,6 +75,7 @@
 #endif
 
 #include "backends/meta-backend-private.h"
+#include "backends/meta-frame-stats.h"
 #include "backends/x11/cm/meta-backend-x11-cm.h"
 #include "backends/x11/meta-backend-x11.h"
 #include "clutter/clutter.h"
@@ -173,6 +174,7 @@ static gchar    *opt_client_id;
 static gboolean  opt_replace_wm;
 static gboolean  opt_disable_sm;
 static gboolean  opt_sync;
+static gboolean  opt_frame_stats;
 #ifdef HAVE_WAYLAND
 static gboolean  opt_wayland;
 static gboolean  opt_nested;
@@ -219,6 +221,12 @@ static GOptionEntry meta_options[] = {
     N_("Make X calls synchronous"),
     NULL
   },
+  {
+    "frame-stats", 0, 0, G_OPTION_ARG_NONE,
+    &opt_frame_stats,
+    N_("Periodically log frame timing statistics"),
+    NULL
+  },
 #ifdef HAVE_WAYLAND
   {
     "wayland", 0, 0, G_OPTION_ARG_NONE,
@@ -593,6 +601,9 @@ meta_init (void)
 
   meta_init_backend (backend_gtype);
 
+  if (opt_frame_stats)
+    meta_frame_stats_start_logging (meta_backend_get_frame_stats (meta_get_backend ()));
+
   meta_set_syncing (opt_sync || (g_getenv ("MUTTER_SYNC") != NULL));
 
   if (opt_replace_wm)
@@ -49,6 +49,12 @@ static void stack_do_relayer (MetaStack *stack);
 static void stack_do_constrain (MetaStack *stack);
 static void stack_do_resort (MetaStack *stack);
 static void stack_ensure_sorted (MetaStack *stack);
+static void invalidate_constraints (MetaStack  *stack,
+                                    MetaWindow *window);
+static void remove_window_constraints (MetaStack  *stack,
+                                       MetaWindow *window,
+                                       gboolean    include_children);
+static void free_constraints (MetaStack *stack);
 
 enum
 {
@@ -155,6 +161,11 @@ on_stack_changed (MetaStack *stack)
 static void
 meta_stack_init (MetaStack *stack)
 {
+  stack->constraints_above = g_hash_table_new (NULL, NULL);
+  stack->constraints_below = g_hash_table_new (NULL, NULL);
+  stack->dirty_constraints = g_hash_table_new (NULL, NULL);
+  stack->changed_windows = g_hash_table_new (NULL, NULL);
+
   g_signal_connect (stack, "changed",
                     G_CALLBACK (on_stack_changed), NULL);
 }
@@ -166,6 +177,12 @@ meta_stack_finalize (GObject *object)
 
   g_list_free (stack->sorted);
 
+  free_constraints (stack);
+  g_hash_table_unref (stack->constraints_above);
+  g_hash_table_unref (stack->constraints_below);
+  g_hash_table_unref (stack->dirty_constraints);
+  g_hash_table_unref (stack->changed_windows);
+
   G_OBJECT_CLASS (meta_stack_parent_class)->finalize (object);
 }
 
@@ -269,6 +286,7 @@ meta_stack_add (MetaStack  *stack,
                 MetaWindow *window)
 {
   MetaWorkspaceManager *workspace_manager = window->display->workspace_manager;
+  GList *l;
 
   COGL_TRACE_BEGIN_SCOPED (MetaStackAdd,
                            "Stack (add window)");
@@ -282,7 +300,6 @@ meta_stack_add (MetaStack  *stack,
 
   stack->sorted = g_list_prepend (stack->sorted, window);
   stack->need_resort = TRUE; /* may not be needed as we add to top */
-  stack->need_constrain = TRUE;
   stack->need_relayer = TRUE;
 
   g_signal_emit (stack, signals[WINDOW_ADDED], 0, window);
@@ -293,6 +310,18 @@ meta_stack_add (MetaStack  *stack,
               "Window %s has stack_position initialized to %d\n",
               window->desc, window->stack_position);
 
+  g_hash_table_add (stack->changed_windows, window);
+  invalidate_constraints (stack, window);
+
+  /* Transients added before their parent are now constrained above it */
+  for (l = stack->sorted; l; l = l->next)
+    {
+      MetaWindow *w = l->data;
+
+      if (w->transient_for == window)
+        g_hash_table_add (stack->dirty_constraints, w);
+    }
+
   meta_stack_changed (stack);
   meta_stack_update_window_tile_matches (stack, workspace_manager->active_workspace);
 }
@@ -318,6 +347,10 @@ meta_stack_remove (MetaStack  *stack,
 
   stack->sorted = g_list_remove (stack->sorted, window);
 
+  remove_window_constraints (stack, window, TRUE);
+  g_hash_table_remove (stack->dirty_constraints, window);
+  g_hash_table_remove (stack->changed_windows, window);
+
   g_signal_emit (stack, signals[WINDOW_REMOVED], 0, window);
 
   meta_stack_changed (stack);
@@ -331,6 +364,9 @@ meta_stack_update_layer (MetaStack  *stack,
   MetaWorkspaceManager *workspace_manager = window->display->workspace_manager;
   stack->need_relayer = TRUE;
 
+  /* Transient-for-group constraints depend on the window type */
+  invalidate_constraints (stack, window);
+
   meta_stack_changed (stack);
   meta_stack_update_window_tile_matches (stack, workspace_manager->active_workspace);
 }
@@ -340,7 +376,8 @@ meta_stack_update_transient (MetaStack  *stack,
                              MetaWindow *window)
 {
   MetaWorkspaceManager *workspace_manager = window->display->workspace_manager;
-  stack->need_constrain = TRUE;
+
+  invalidate_constraints (stack, window);
 
   meta_stack_changed (stack);
   meta_stack_update_window_tile_matches (stack, workspace_manager->active_workspace);
@@ -499,6 +536,10 @@ compare_window_position (void *a,
  * that they appear, we will apply them correctly. Note that the
  * graph MAY have cycles, so we have to guard against that.
  *
+ * The graph is kept between updates; the constraints of a window are
+ * only recreated when it is added, or its transiency or layer changes.
+ * After windows move, only the chains containing them are walked again.
+ *
  */
 
 typedef struct Constraint Constraint;
@@ -508,213 +549,239 @@ struct Constraint
   MetaWindow *above;
   MetaWindow *below;
 
-  /* used to keep the constraint in the
-   * list of constraints for window "below"
-   */
-  Constraint *next;
-
-  /* used to create the graph. */
-  GSList *next_nodes;
-
-  /* constraint has been applied, used
-   * to detect cycles.
+  /* serial of the last pass that applied the
+   * constraint, used to detect cycles.
    */
-  unsigned int applied : 1;
-
-  /* constraint has a previous node in the graph,
-   * used to find places to start in the graph.
-   * (I think this also has the side effect
-   * of preventing cycles, since cycles will
-   * have no starting point - so maybe
-   * the "applied" flag isn't needed.)
-   */
-  unsigned int has_prev : 1;
+  unsigned int applied_serial;
 };
 
-/* We index the array of constraints by window
- * stack positions, just because the stack
- * positions are a convenient index.
- */
 static void
-add_constraint (Constraint **constraints,
-                MetaWindow  *above,
-                MetaWindow  *below)
+set_constraint_list (GHashTable *table,
+                     MetaWindow *window,
+                     GList      *constraints)
 {
+  if (constraints)
+    g_hash_table_insert (table, window, constraints);
+  else
+    g_hash_table_remove (table, window);
+}
+
+static void
+add_constraint (MetaStack  *stack,
+                MetaWindow *above,
+                MetaWindow *below)
+{
+  GList *constraints;
+  GList *l;
   Constraint *c;
 
   /* check if constraint is a duplicate */
-  c = constraints[below->stack_position];
-  while (c != NULL)
+  constraints = g_hash_table_lookup (stack->constraints_above, above);
+  for (l = constraints; l; l = l->next)
     {
-      if (c->above == above)
+      c = l->data;
+      if (c->below == below)
         return;
-      c = c->next;
     }
 
   /* if not, add the constraint */
-  c = g_new (Constraint, 1);
+  c = g_new0 (Constraint, 1);
   c->above = above;
   c->below = below;
-  c->next = constraints[below->stack_position];
-  c->next_nodes = NULL;
-  c->applied = FALSE;
-  c->has_prev = FALSE;
 
-  constraints[below->stack_position] = c;
+  set_constraint_list (stack->constraints_above, above,
+                       g_list_prepend (constraints, c));
+  set_constraint_list (stack->constraints_below, below,
+                       g_list_prepend (g_hash_table_lookup (stack->constraints_below,
+                                                            below),
+                                       c));
 }
 
 static void
-create_constraints (Constraint **constraints,
-                    GList       *windows)
+remove_constraint (MetaStack  *stack,
+                   Constraint *c)
 {
-  GList *tmp;
+  set_constraint_list (stack->constraints_above, c->above,
+                       g_list_remove (g_hash_table_lookup (stack->constraints_above,
+                                                           c->above),
+                                      c));
+  set_constraint_list (stack->constraints_below, c->below,
+                       g_list_remove (g_hash_table_lookup (stack->constraints_below,
+                                                           c->below),
+                                      c));
+  g_free (c);
+}
 
-  tmp = windows;
-  while (tmp != NULL)
+static void
+remove_window_constraints (MetaStack  *stack,
+                           MetaWindow *window,
+                           gboolean    include_children)
+{
+  GList *constraints;
+
+  while ((constraints = g_hash_table_lookup (stack->constraints_above, window)))
+    remove_constraint (stack, constraints->data);
+
+  if (!include_children)
+    return;
+
+  while ((constraints = g_hash_table_lookup (stack->constraints_below, window)))
+    remove_constraint (stack, constraints->data);
+}
+
+static void
+create_window_constraints (MetaStack  *stack,
+                           MetaWindow *w)
+{
+  if (!meta_window_is_in_stack (w))
     {
-      MetaWindow *w = tmp->data;
+      meta_topic (META_DEBUG_STACK, "Window %s not in the stack, not constraining it\n",
+                  w->desc);
+      return;
+    }
 
-      if (!meta_window_is_in_stack (w))
-        {
-          meta_topic (META_DEBUG_STACK, "Window %s not in the stack, not constraining it\n",
-                      w->desc);
-          tmp = tmp->next;
-          continue;
-        }
+  if (WINDOW_TRANSIENT_FOR_WHOLE_GROUP (w))
+    {
+      GSList *group_windows;
+      GSList *tmp2;
+      MetaGroup *group;
 
-      if (WINDOW_TRANSIENT_FOR_WHOLE_GROUP (w))
-        {
-          GSList *group_windows;
-          GSList *tmp2;
-          MetaGroup *group;
+      group = meta_window_get_group (w);
 
-          group = meta_window_get_group (w);
+      if (group != NULL)
+        group_windows = meta_group_list_windows (group);
+      else
+        group_windows = NULL;
 
-          if (group != NULL)
-            group_windows = meta_group_list_windows (group);
-          else
-            group_windows = NULL;
+      tmp2 = group_windows;
 
-          tmp2 = group_windows;
+      while (tmp2 != NULL)
+        {
+          MetaWindow *group_window = tmp2->data;
 
-          while (tmp2 != NULL)
+          if (!meta_window_is_in_stack (group_window) ||
+              group_window->override_redirect)
             {
-              MetaWindow *group_window = tmp2->data;
-
-              if (!meta_window_is_in_stack (group_window) ||
-                  group_window->override_redirect)
-                {
-                  tmp2 = tmp2->next;
-                  continue;
-                }
+              tmp2 = tmp2->next;
+              continue;
+            }
 
 #if 0
-              /* old way of doing it */
-              if (!(meta_window_is_ancestor_of_transient (w, group_window)) &&
-                  !WINDOW_TRANSIENT_FOR_WHOLE_GROUP (group_window))  /* note */;/*note*/
+          /* old way of doing it */
+          if (!(meta_window_is_ancestor_of_transient (w, group_window)) &&
+              !WINDOW_TRANSIENT_FOR_WHOLE_GROUP (group_window))  /* note */;/*note*/
 #else
-              /* better way I think, so transient-for-group are constrained
-               * only above non-transient-type windows in their group
-               */
-              if (!meta_window_has_transient_type (group_window))
+          /* better way I think, so transient-for-group are constrained
+           * only above non-transient-type windows in their group
+           */
+          if (!meta_window_has_transient_type (group_window))
 #endif
-                {
-                  meta_topic (META_DEBUG_STACK, "Constraining %s above %s as it's transient for its group\n",
-                              w->desc, group_window->desc);
-                  add_constraint (constraints, w, group_window);
-                }
-
-              tmp2 = tmp2->next;
+            {
+              meta_topic (META_DEBUG_STACK, "Constraining %s above %s as it's transient for its group\n",
+                          w->desc, group_window->desc);
+              add_constraint (stack, w, group_window);
             }
 
-          g_slist_free (group_windows);
+          tmp2 = tmp2->next;
         }
-      else if (w->transient_for != NULL)
-        {
-          MetaWindow *parent;
 
-          parent = w->transient_for;
+      g_slist_free (group_windows);
+    }
+  else if (w->transient_for != NULL)
+    {
+      MetaWindow *parent;
 
-          if (parent && meta_window_is_in_stack (parent))
-            {
-              meta_topic (META_DEBUG_STACK, "Constraining %s above %s due to transiency\n",
-                          w->desc, parent->desc);
-              add_constraint (constraints, w, parent);
-            }
-        }
+      parent = w->transient_for;
 
-      tmp = tmp->next;
+      if (parent && meta_window_is_in_stack (parent))
+        {
+          meta_topic (META_DEBUG_STACK, "Constraining %s above %s due to transiency\n",
+                      w->desc, parent->desc);
+          add_constraint (stack, w, parent);
+        }
     }
 }
 
+/* Marks the constraints of @window as needing to be recreated, along
+ * with the constraints of the windows that depend on it; i.e. its
+ * current children and the windows transient for its group.
+ */
 static void
-graph_constraints (Constraint **constraints,
-                   int          n_constraints)
+invalidate_constraints (MetaStack  *stack,
+                        MetaWindow *window)
 {
-  int i;
+  MetaGroup *group;
+  GList *l;
 
-  i = 0;
-  while (i < n_constraints)
-    {
-      Constraint *c;
+  /* Windows get constrained once they are added */
+  if (!meta_window_is_in_stack (window))
+    return;
 
-      /* If we have "A below B" and "B below C" then AB -> BC so we
-       * add BC to next_nodes in AB.
-       */
+  g_hash_table_add (stack->dirty_constraints, window);
 
-      c = constraints[i];
-      while (c != NULL)
-        {
-          Constraint *n;
+  for (l = g_hash_table_lookup (stack->constraints_below, window); l; l = l->next)
+    {
+      Constraint *c = l->data;
 
-          g_assert (c->below->stack_position == i);
+      g_hash_table_add (stack->dirty_constraints, c->above);
+    }
 
-          /* Constraints where ->above is below are our
-           * next_nodes and we are their previous
-           */
-          n = constraints[c->above->stack_position];
-          while (n != NULL)
-            {
-              c->next_nodes = g_slist_prepend (c->next_nodes,
-                                               n);
-              /* c is a previous node of n */
-              n->has_prev = TRUE;
+  group = meta_window_get_group (window);
+  if (group)
+    {
+      GSList *group_windows;
+      GSList *tmp;
 
-              n = n->next;
-            }
+      group_windows = meta_group_list_windows (group);
+      for (tmp = group_windows; tmp; tmp = tmp->next)
+        {
+          MetaWindow *group_window = tmp->data;
 
-          c = c->next;
+          if (WINDOW_TRANSIENT_FOR_WHOLE_GROUP (group_window) &&
+              meta_window_is_in_stack (group_window))
+            g_hash_table_add (stack->dirty_constraints, group_window);
         }
-
-      ++i;
+      g_slist_free (group_windows);
     }
+
+  stack->need_constrain = TRUE;
 }
 
 static void
-free_constraints (Constraint **constraints,
-                  int          n_constraints)
+update_dirty_constraints (MetaStack *stack)
 {
-  int i;
+  GHashTableIter iter;
+  MetaWindow *window;
 
-  i = 0;
-  while (i < n_constraints)
+  g_hash_table_iter_init (&iter, stack->dirty_constraints);
+  while (g_hash_table_iter_next (&iter, (gpointer *) &window, NULL))
     {
-      Constraint *c;
+      remove_window_constraints (stack, window, FALSE);
+      create_window_constraints (stack, window);
 
-      c = constraints[i];
-      while (c != NULL)
-        {
-          Constraint *next = c->next;
+      /* Make sure the new constraints get applied */
+      g_hash_table_add (stack->changed_windows, window);
+    }
 
-          g_slist_free (c->next_nodes);
+  g_hash_table_remove_all (stack->dirty_constraints);
+}
 
-          g_free (c);
+static void
+free_constraints (MetaStack *stack)
+{
+  GHashTableIter iter;
+  GList *constraints;
 
-          c = next;
-        }
+  g_hash_table_iter_init (&iter, stack->constraints_above);
+  while (g_hash_table_iter_next (&iter, NULL, (gpointer *) &constraints))
+    g_list_free_full (constraints, g_free);
 
-      ++i;
-    }
+  g_hash_table_iter_init (&iter, stack->constraints_below);
+  while (g_hash_table_iter_next (&iter, NULL, (gpointer *) &constraints))
+    g_list_free (constraints);
+
+  g_hash_table_remove_all (stack->constraints_above);
+  g_hash_table_remove_all (stack->constraints_below);
 }
 
 static void
@@ -731,6 +798,8 @@ ensure_above (MetaWindow *above,
 		  "Promoting window %s from layer %u to %u due to constraint\n",
 		  above->desc, above->layer, below->layer);
       above->layer = below->layer;
+      g_hash_table_add (above->display->stack->changed_windows, above);
+      above->display->stack->need_resort = TRUE;
     }
 
   if (above->stack_position < below->stack_position)
@@ -745,64 +814,90 @@ ensure_above (MetaWindow *above,
 }
 
 static void
-traverse_constraint (Constraint *c)
+traverse_constraint (MetaStack  *stack,
+                     Constraint *c)
 {
-  GSList *tmp;
+  GList *l;
 
-  if (c->applied)
+  if (c->applied_serial == stack->constraint_serial)
     return;
 
   ensure_above (c->above, c->below);
-  c->applied = TRUE;
+  c->applied_serial = stack->constraint_serial;
 
-  tmp = c->next_nodes;
-  while (tmp != NULL)
-    {
-      traverse_constraint (tmp->data);
+  /* Constraints where ->above is below are our next nodes */
+  for (l = g_hash_table_lookup (stack->constraints_below, c->above); l; l = l->next)
+    traverse_constraint (stack, l->data);
+}
 
-      tmp = tmp->next;
-    }
+static int
+compare_head_position (gconstpointer a,
+                       gconstpointer b)
+{
+  const Constraint *constraint_a = a;
+  const Constraint *constraint_b = b;
+
+  /* Topmost first, as when they were listed by stack position */
+  return constraint_b->below->stack_position - constraint_a->below->stack_position;
 }
 
-static void
-apply_constraints (Constraint **constraints,
-                   int          n_constraints)
+/* Lists the heads of the constraint chains that the changed windows are
+ * part of. Only the positions of changed windows relative to other windows
+ * changed, so constraints between other windows still hold.
+ */
+static GSList *
+find_changed_heads (MetaStack *stack)
 {
-  GSList *heads;
-  GSList *tmp;
-  int i;
+  g_autoptr (GHashTable) visited = NULL;
+  g_autoptr (GPtrArray) pending = NULL;
+  GHashTableIter iter;
+  MetaWindow *window;
+  GSList *heads = NULL;
 
-  /* List all heads in an ordered constraint chain */
-  heads = NULL;
-  i = 0;
-  while (i < n_constraints)
+  visited = g_hash_table_new (NULL, NULL);
+  pending = g_ptr_array_new ();
+
+  g_hash_table_iter_init (&iter, stack->changed_windows);
+  while (g_hash_table_iter_next (&iter, (gpointer *) &window, NULL))
     {
-      Constraint *c;
+      if (g_hash_table_add (visited, window))
+        g_ptr_array_add (pending, window);
+    }
 
-      c = constraints[i];
-      while (c != NULL)
-        {
-          if (!c->has_prev)
-            heads = g_slist_prepend (heads, c);
+  while (pending->len > 0)
+    {
+      GList *above, *below;
+      GList *l;
+
+      window = g_ptr_array_remove_index_fast (pending, pending->len - 1);
+      above = g_hash_table_lookup (stack->constraints_above, window);
+      below = g_hash_table_lookup (stack->constraints_below, window);
 
-          c = c->next;
+      /* A window that isn't above anything starts a chain */
+      if (!above)
+        {
+          for (l = below; l; l = l->next)
+            heads = g_slist_prepend (heads, l->data);
         }
 
-      ++i;
-    }
+      for (l = above; l; l = l->next)
+        {
+          Constraint *c = l->data;
 
-  /* Now traverse the chain and apply constraints */
-  tmp = heads;
-  while (tmp != NULL)
-    {
-      Constraint *c = tmp->data;
+          if (g_hash_table_add (visited, c->below))
+            g_ptr_array_add (pending, c->below);
+        }
 
-      traverse_constraint (c);
+      for (l = below; l; l = l->next)
+        {
+          Constraint *c = l->data;
 
-      tmp = tmp->next;
+          if (g_hash_table_add (visited, c->above))
+            g_ptr_array_add (pending, c->above);
+        }
     }
 
-  g_slist_free (heads);
+  return g_slist_sort (heads, compare_head_position);
 }
 
 /**
@@ -838,6 +933,7 @@ stack_do_relayer (MetaStack *stack)
           meta_topic (META_DEBUG_STACK,
                       "Window %s moved from layer %u to %u\n",
                       w->desc, old_layer, w->layer);
+          g_hash_table_add (stack->changed_windows, w);
           stack->need_resort = TRUE;
           stack->need_constrain = TRUE;
           /* don't need to constrain as constraining
@@ -861,9 +957,8 @@ stack_do_relayer (MetaStack *stack)
 static void
 stack_do_constrain (MetaStack *stack)
 {
-  Constraint **constraints;
-
-  /* It'd be nice if this were all faster, probably */
+  GSList *heads;
+  GSList *tmp;
 
   if (!stack->need_constrain)
     return;
@@ -871,21 +966,25 @@ stack_do_constrain (MetaStack *stack)
   meta_topic (META_DEBUG_STACK,
               "Reapplying constraints\n");
 
-  constraints = g_new0 (Constraint*,
-                        stack->n_positions);
+  update_dirty_constraints (stack);
 
-  create_constraints (constraints, stack->sorted);
+  heads = find_changed_heads (stack);
 
-  graph_constraints (constraints, stack->n_positions);
+  /* Now traverse the chains and apply constraints */
+  stack->constraint_serial++;
+  for (tmp = heads; tmp; tmp = tmp->next)
+    traverse_constraint (stack, tmp->data);
 
-  apply_constraints (constraints, stack->n_positions);
-
-  free_constraints (constraints, stack->n_positions);
-  g_free (constraints);
+  g_slist_free (heads);
 
   stack->need_constrain = FALSE;
 }
 
+/* Above this many changed windows, sorting the whole list is cheaper
+ * than moving each of them to its place.
+ */
+#define MAX_REPOSITIONED_WINDOWS 8
+
 /**
  * stack_do_resort:
  *
@@ -897,11 +996,35 @@ stack_do_resort (MetaStack *stack)
   if (!stack->need_resort)
     return;
 
-  meta_topic (META_DEBUG_STACK,
-              "Sorting stack list\n");
+  if (g_hash_table_size (stack->changed_windows) > MAX_REPOSITIONED_WINDOWS)
+    {
+      meta_topic (META_DEBUG_STACK,
+                  "Sorting stack list\n");
+
+      stack->sorted = g_list_sort (stack->sorted,
+                                   (GCompareFunc) compare_window_position);
+    }
+  else
+    {
+      GHashTableIter iter;
+      MetaWindow *window;
 
-  stack->sorted = g_list_sort (stack->sorted,
-                               (GCompareFunc) compare_window_position);
+      meta_topic (META_DEBUG_STACK,
+                  "Repositioning %u windows in the stack list\n",
+                  g_hash_table_size (stack->changed_windows));
+
+      /* The other windows kept their relative order, so take the changed
+       * ones out and insert them back at their place.
+       */
+      g_hash_table_iter_init (&iter, stack->changed_windows);
+      while (g_hash_table_iter_next (&iter, (gpointer *) &window, NULL))
+        stack->sorted = g_list_remove (stack->sorted, window);
+
+      g_hash_table_iter_init (&iter, stack->changed_windows);
+      while (g_hash_table_iter_next (&iter, (gpointer *) &window, NULL))
+        stack->sorted = g_list_insert_sorted (stack->sorted, window,
+                                              (GCompareFunc) compare_window_position);
+    }
 
   meta_display_queue_check_fullscreen (stack->display);
 
@@ -914,10 +1037,10 @@ stack_do_resort (MetaStack *stack)
  * Puts the stack into canonical form.
  *
  * Honour the removed and added lists of the stack, and then recalculate
- * all the layers (if the flag is set), re-run all the constraint calculations
- * (if the flag is set), and finally re-sort the stack (if the flag is set,
- * and if it wasn't already it might have become so during all the previous
- * activity).
+ * all the layers (if the flag is set), re-run the constraint calculations
+ * for the windows that changed (if the flag is set), and finally re-sort
+ * the stack (if the flag is set, and if it wasn't already it might have
+ * become so during all the previous activity).
  */
 static void
 stack_ensure_sorted (MetaStack *stack)
@@ -925,6 +1048,8 @@ stack_ensure_sorted (MetaStack *stack)
   stack_do_relayer (stack);
   stack_do_constrain (stack);
   stack_do_resort (stack);
+
+  g_hash_table_remove_all (stack->changed_windows);
 }
 
 MetaWindow *
@@ -1259,6 +1384,7 @@ meta_stack_set_positions (MetaStack *stack,
     {
       MetaWindow *w = tmp->data;
       w->stack_position = i++;
+      g_hash_table_add (stack->changed_windows, w);
       tmp = tmp->next;
     }
 
@@ -1291,6 +1417,12 @@ meta_window_set_stack_position_no_sync (MetaWindow *window,
   window->display->stack->need_resort = TRUE;
   window->display->stack->need_constrain = TRUE;
 
+  /* The windows in between are shifted by one, keeping their order
+   * relative to each other; only this window needs to be constrained
+   * and moved in the sorted list.
+   */
+  g_hash_table_add (window->display->stack->changed_windows, window);
+
   if (position < window->stack_position)
     {
       low = position;
@@ -95,6 +95,26 @@ struct _MetaStack
    * recalculated with respect to transiency (parent and child windows)?
    */
   unsigned int need_constrain : 1;
+
+  /**
+   * The transiency constraints, kept between updates. Both map a window
+   * to a list of constraints: constraints_above to those keeping it above
+   * its parents, constraints_below to those keeping its children above it.
+   */
+  GHashTable *constraints_above;
+  GHashTable *constraints_below;
+
+  /** Windows whose constraints need to be recreated. */
+  GHashTable *dirty_constraints;
+
+  /**
+   * Windows whose stack position or layer changed since the stack was
+   * last sorted; only these are constrained and moved in the sorted list.
+   */
+  GHashTable *changed_windows;
+
+  /** Serial of the last pass applying constraints. */
+  unsigned int constraint_serial;
 };
 
 #define META_TYPE_STACK (meta_stack_get_type ())
@@ -4126,6 +4126,17 @@ meta_window_move_resize_internal (MetaWindow          *window,
   if (moved_or_resized || did_placement)
     window->unconstrained_rect = unconstrained_rect;
 
+  /* Other windows moving during a grab change the edges to resist to;
+   * attached dialogs following the grabbed window are ignored, like the
+   * grabbed window itself.
+   */
+  if (moved_or_resized &&
+      window->display->grab_window &&
+      window != window->display->grab_window &&
+      !meta_window_is_ancestor_of_transient (window->display->grab_window,
+                                             window))
+    meta_display_invalidate_edges (window->display);
+
   if ((moved_or_resized ||
        did_placement ||
        (result & META_MOVE_RESIZE_RESULT_STATE_CHANGED) != 0) &&
@@ -92,7 +92,66 @@ actor_margin_layout (void)
   clutter_actor_destroy (vase);
 }
 
+static void
+actor_deferred_layout (void)
+{
+  ClutterActor *stage = clutter_test_get_stage ();
+  ClutterActor *vase;
+  ClutterActor *flower[3];
+  ClutterActor *petal[3];
+  graphene_point_t p;
+  int i;
+
+  vase = clutter_actor_new ();
+  clutter_actor_set_name (vase, "Vase");
+  clutter_actor_set_layout_manager (vase, clutter_box_layout_new ());
+  clutter_actor_add_child (stage, vase);
+
+  /* The flowers have no fixed size, so their relayouts are deferred and
+   * only propagated to the vase if their size requests change */
+  for (i = 0; i < G_N_ELEMENTS (flower); i++)
+    {
+      flower[i] = clutter_actor_new ();
+      clutter_actor_set_layout_manager (flower[i],
+                                        clutter_bin_layout_new (CLUTTER_BIN_ALIGNMENT_FILL,
+                                                                CLUTTER_BIN_ALIGNMENT_FILL));
+      clutter_actor_add_child (vase, flower[i]);
+
+      petal[i] = clutter_actor_new ();
+      clutter_actor_set_background_color (petal[i], CLUTTER_COLOR_Red);
+      clutter_actor_set_size (petal[i], 100, 100);
+      clutter_actor_add_child (flower[i], petal[i]);
+    }
+
+  graphene_point_init (&p, 250, 50);
+  clutter_test_assert_actor_at_point (stage, &p, petal[2]);
+
+  /* Relayouts not changing the size requests leave the layout alone */
+  clutter_actor_queue_relayout (flower[1]);
+  clutter_actor_queue_relayout (petal[1]);
+
+  graphene_point_init (&p, 150, 50);
+  clutter_test_assert_actor_at_point (stage, &p, petal[1]);
+
+  graphene_point_init (&p, 250, 50);
+  clutter_test_assert_actor_at_point (stage, &p, petal[2]);
+
+  /* Growing a flower moves its siblings */
+  clutter_actor_set_width (petal[1], 150);
+
+  graphene_point_init (&p, 225, 50);
+  clutter_test_assert_actor_at_point (stage, &p, petal[1]);
+
+  graphene_point_init (&p, 275, 50);
+  clutter_test_assert_actor_at_point (stage, &p, petal[2]);
+
+  g_assert_cmpfloat (clutter_actor_get_width (vase), ==, 350);
+
+  clutter_actor_destroy (vase);
+}
+
 CLUTTER_TEST_SUITE (
   CLUTTER_TEST_UNIT ("/actor/layout/basic", actor_basic_layout)
   CLUTTER_TEST_UNIT ("/actor/layout/margin", actor_margin_layout)
+  CLUTTER_TEST_UNIT ("/actor/layout/deferred", actor_deferred_layout)
 )
@@ -547,6 +547,101 @@ text_idempotent_use_markup (void)
   clutter_actor_destroy (CLUTTER_ACTOR (text));
 }
 
+static void
+text_shared_layout (void)
+{
+  ClutterText *a, *b, *editable;
+  PangoLayout *layout_a;
+  gfloat width_a, width_b;
+  guint n_hits;
+
+  a = CLUTTER_TEXT (clutter_text_new_with_text ("Sans 10", "Shared"));
+  b = CLUTTER_TEXT (clutter_text_new_with_text ("Sans 10", "Shared"));
+  editable = CLUTTER_TEXT (clutter_text_new_with_text ("Sans 10", "Shared"));
+  g_object_ref_sink (a);
+  g_object_ref_sink (b);
+  g_object_ref_sink (editable);
+  clutter_text_set_editable (editable, TRUE);
+
+  /* Identical non-editable text is only shaped once */
+  n_hits = _clutter_text_get_n_shared_layout_hits ();
+  clutter_actor_get_preferred_width (CLUTTER_ACTOR (a), -1, NULL, &width_a);
+  g_assert_cmpuint (_clutter_text_get_n_shared_layout_hits (), ==, n_hits);
+  clutter_actor_get_preferred_width (CLUTTER_ACTOR (b), -1, NULL, &width_b);
+  g_assert_cmpuint (_clutter_text_get_n_shared_layout_hits (), ==, n_hits + 1);
+  g_assert_cmpfloat (width_a, ==, width_b);
+
+  /* Editable text never uses the shared cache */
+  clutter_actor_get_preferred_width (CLUTTER_ACTOR (editable), -1,
+                                     NULL, &width_b);
+  g_assert_cmpuint (_clutter_text_get_n_shared_layout_hits (), ==, n_hits + 1);
+
+  /* Layouts handed out are never shared with other actors, even when the
+   * text is identical */
+  layout_a = clutter_text_get_layout (a);
+  g_assert_true (layout_a != clutter_text_get_layout (b));
+  g_assert_true (layout_a != clutter_text_get_layout (editable));
+
+  /* Modifying the layout of one actor doesn't affect the other */
+  pango_layout_set_text (layout_a, "Modified", -1);
+  g_assert_cmpstr (pango_layout_get_text (clutter_text_get_layout (b)),
+                   ==, "Shared");
+
+  /* Changing the font of one actor doesn't affect the other */
+  clutter_text_set_font_name (b, "Sans 12");
+  g_assert_cmpstr (pango_layout_get_text (clutter_text_get_layout (b)),
+                   ==, "Shared");
+
+  clutter_actor_destroy (CLUTTER_ACTOR (a));
+  clutter_actor_destroy (CLUTTER_ACTOR (b));
+  clutter_actor_destroy (CLUTTER_ACTOR (editable));
+}
+
+static void
+text_async_layout (void)
+{
+  ClutterText *text, *next;
+  gfloat previous_width, next_width, width;
+
+  text = CLUTTER_TEXT (clutter_text_new_with_text ("Sans 10", "Previous"));
+  next = CLUTTER_TEXT (clutter_text_new_with_text ("Sans 10", "Next"));
+  g_object_ref_sink (text);
+  g_object_ref_sink (next);
+
+  clutter_actor_get_preferred_width (CLUTTER_ACTOR (text), -1,
+                                     NULL, &previous_width);
+  clutter_actor_get_preferred_width (CLUTTER_ACTOR (next), -1,
+                                     NULL, &next_width);
+  g_assert_cmpfloat (previous_width, !=, next_width);
+
+  clutter_text_set_async_layout (text, TRUE);
+  g_assert_true (clutter_text_get_async_layout (text));
+
+  /* The previous layout is used until the new one has been shaped */
+  clutter_text_set_text (text, "Next");
+  clutter_actor_get_preferred_width (CLUTTER_ACTOR (text), -1, NULL, &width);
+  g_assert_cmpfloat (width, ==, previous_width);
+
+  while (width != next_width)
+    {
+      g_main_context_iteration (NULL, TRUE);
+      clutter_actor_get_preferred_width (CLUTTER_ACTOR (text), -1,
+                                         NULL, &width);
+    }
+
+  /* Layouts handed out are always shaped in the main thread */
+  g_assert_cmpstr (pango_layout_get_text (clutter_text_get_layout (text)),
+                   ==, "Next");
+  clutter_text_set_text (text, "Previous");
+  g_assert_cmpstr (pango_layout_get_text (clutter_text_get_layout (text)),
+                   ==, "Previous");
+  clutter_actor_get_preferred_width (CLUTTER_ACTOR (text), -1, NULL, &width);
+  g_assert_cmpfloat (width, ==, previous_width);
+
+  clutter_actor_destroy (CLUTTER_ACTOR (text));
+  clutter_actor_destroy (CLUTTER_ACTOR (next));
+}
+
 CLUTTER_TEST_SUITE (
   CLUTTER_TEST_UNIT ("/text/utf8-validation", text_utf8_validation)
   CLUTTER_TEST_UNIT ("/text/set-empty", text_set_empty)
@@ -561,4 +656,6 @@ CLUTTER_TEST_SUITE (
   CLUTTER_TEST_UNIT ("/text/cursor", text_cursor)
   CLUTTER_TEST_UNIT ("/text/event", text_event)
   CLUTTER_TEST_UNIT ("/text/idempotent-use-markup", text_idempotent_use_markup)
+  CLUTTER_TEST_UNIT ("/text/shared-layout", text_shared_layout)
+  CLUTTER_TEST_UNIT ("/text/async-layout", text_async_layout)
 )
@@ -0,0 +1,203 @@
+#include <glib.h>
+#include <gmodule.h>
+#include <stdlib.h>
+#include <string.h>
+#include <clutter/clutter.h>
+#include <cogl/cogl.h>
+
+#include "tests/clutter-test-utils.h"
+
+/* Run with COGL_DEBUG=disable-simd to compare against the portable
+ * implementation of the matrix functions. */
+
+#define N_ITERATIONS 1000000
+#define N_POINTS 4096
+
+static int n_iterations = N_ITERATIONS;
+
+static GOptionEntry entries[] = {
+  {
+    "iterations", 'i',
+    0,
+    G_OPTION_ARG_INT, &n_iterations,
+    "Number of iterations per test", "N"
+  },
+  { NULL }
+};
+
+typedef struct _Point3
+{
+  float x, y, z;
+} Point3;
+
+typedef struct _Point4
+{
+  float x, y, z, w;
+} Point4;
+
+static void
+init_perspective_matrix (CoglMatrix *matrix)
+{
+  cogl_matrix_init_identity (matrix);
+  cogl_matrix_perspective (matrix, 60.0f, 4.0f / 3.0f, 0.1f, 100.0f);
+  cogl_matrix_translate (matrix, -0.5f, -0.5f, -2.0f);
+  cogl_matrix_rotate (matrix, 30.0f, 0.0f, 1.0f, 0.0f);
+}
+
+static void
+report (const char *name,
+        GTimer     *timer,
+        int         n_ops,
+        float       checksum)
+{
+  double elapsed = g_timer_elapsed (timer, NULL);
+
+  g_print ("%-24s %10.3f ms %10.2f ns/op (checksum %f)\n",
+           name,
+           elapsed * 1000.0,
+           elapsed * 1e9 / n_ops,
+           checksum);
+}
+
+static void
+test_multiply (GTimer *timer)
+{
+  CoglMatrix a, b, result;
+  int i;
+
+  init_perspective_matrix (&a);
+  cogl_matrix_init_identity (&b);
+  cogl_matrix_rotate (&b, 0.01f, 0.0f, 0.0f, 1.0f);
+
+  g_timer_start (timer);
+  for (i = 0; i < n_iterations; i++)
+    {
+      cogl_matrix_multiply (&result, &a, &b);
+      a.xw = result.xw * 0.5f;
+    }
+  g_timer_stop (timer);
+
+  report ("multiply", timer, n_iterations, result.xx + result.ww);
+}
+
+static void
+test_invert (GTimer *timer)
+{
+  CoglMatrix matrix, inverse;
+  float array[16];
+  float checksum = 0.0f;
+  int i;
+
+  init_perspective_matrix (&matrix);
+  memcpy (array, cogl_matrix_get_array (&matrix), sizeof (array));
+
+  g_timer_start (timer);
+  for (i = 0; i < n_iterations; i++)
+    {
+      /* Reinitializing the matrix forces the inverse to be recalculated */
+      array[12] = (float) (i % 100) / 100.0f;
+      cogl_matrix_init_from_array (&matrix, array);
+      cogl_matrix_get_inverse (&matrix, &inverse);
+      checksum += inverse.xw;
+    }
+  g_timer_stop (timer);
+
+  report ("invert", timer, n_iterations, checksum);
+}
+
+static void
+test_transform_points (GTimer *timer)
+{
+  CoglMatrix matrix;
+  Point3 *points_in = g_new (Point3, N_POINTS);
+  Point3 *points_out = g_new (Point3, N_POINTS);
+  int n_batches = MAX (n_iterations / N_POINTS, 1);
+  int i;
+
+  init_perspective_matrix (&matrix);
+
+  for (i = 0; i < N_POINTS; i++)
+    {
+      points_in[i].x = g_random_double ();
+      points_in[i].y = g_random_double ();
+      points_in[i].z = g_random_double ();
+    }
+
+  g_timer_start (timer);
+  for (i = 0; i < n_batches; i++)
+    cogl_matrix_transform_points (&matrix, 3,
+                                  sizeof (Point3), points_in,
+                                  sizeof (Point3), points_out,
+                                  N_POINTS);
+  g_timer_stop (timer);
+
+  report ("transform_points", timer, n_batches * N_POINTS,
+          points_out[N_POINTS - 1].z);
+
+  g_free (points_in);
+  g_free (points_out);
+}
+
+static void
+test_project_points (GTimer *timer)
+{
+  CoglMatrix matrix;
+  Point4 *points_in = g_new (Point4, N_POINTS);
+  Point4 *points_out = g_new (Point4, N_POINTS);
+  int n_batches = MAX (n_iterations / N_POINTS, 1);
+  int i;
+
+  init_perspective_matrix (&matrix);
+
+  for (i = 0; i < N_POINTS; i++)
+    {
+      points_in[i].x = g_random_double ();
+      points_in[i].y = g_random_double ();
+      points_in[i].z = g_random_double ();
+      points_in[i].w = 1.0f;
+    }
+
+  g_timer_start (timer);
+  for (i = 0; i < n_batches; i++)
+    cogl_matrix_project_points (&matrix, 4,
+                                sizeof (Point4), points_in,
+                                sizeof (Point4), points_out,
+                                N_POINTS);
+  g_timer_stop (timer);
+
+  report ("project_points", timer, n_batches * N_POINTS,
+          points_out[N_POINTS - 1].w);
+
+  g_free (points_in);
+  g_free (points_out);
+}
+
+int
+main (int argc, char *argv[])
+{
+  g_autoptr (GOptionContext) context = NULL;
+  g_autoptr (GError) error = NULL;
+  GTimer *timer;
+
+  context = g_option_context_new (NULL);
+  g_option_context_add_main_entries (context, entries, NULL);
+  if (!g_option_context_parse (context, &argc, &argv, &error))
+    {
+      g_printerr ("Invalid arguments: %s\n", error->message);
+      return EXIT_FAILURE;
+    }
+
+  /* Initializes Cogl, which also parses COGL_DEBUG */
+  clutter_test_init (&argc, &argv);
+
+  timer = g_timer_new ();
+
+  test_multiply (timer);
+  test_invert (timer);
+  test_transform_points (timer);
+  test_project_points (timer);
+
+  g_timer_destroy (timer);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,195 @@
+#include <glib.h>
+#include <gmodule.h>
+#include <stdlib.h>
+#include <string.h>
+#include <clutter/clutter.h>
+
+#include "tests/clutter-test-utils.h"
+
+/* Run with CLUTTER_PAINT=disable-deferred-relayout to compare against
+ * relaying out every ancestor of the changed actors. */
+
+#define N_CELLS 2000
+#define N_COLUMNS 40
+#define N_ITERATIONS 1000
+#define N_CHANGES_PER_ITERATION 4
+
+static int n_cells = N_CELLS;
+static int n_iterations = N_ITERATIONS;
+static gboolean use_grid = FALSE;
+static gboolean resize = FALSE;
+
+static GOptionEntry entries[] = {
+  {
+    "cells", 'c',
+    0,
+    G_OPTION_ARG_INT, &n_cells,
+    "Number of cells", "N"
+  },
+  {
+    "iterations", 'i',
+    0,
+    G_OPTION_ARG_INT, &n_iterations,
+    "Number of relayouts", "N"
+  },
+  {
+    "grid", 'g',
+    0,
+    G_OPTION_ARG_NONE, &use_grid,
+    "Use a ClutterGridLayout instead of nested ClutterBoxLayouts", NULL
+  },
+  {
+    "resize", 'r',
+    0,
+    G_OPTION_ARG_NONE, &resize,
+    "Change the size of the cells instead of only queueing relayouts", NULL
+  },
+  { NULL }
+};
+
+static ClutterActor *
+create_cell (void)
+{
+  ClutterActor *cell, *leaf;
+
+  /* The cell has no fixed size, so it follows the size of the leaf */
+  cell = clutter_actor_new ();
+  clutter_actor_set_layout_manager (cell,
+                                    clutter_bin_layout_new (CLUTTER_BIN_ALIGNMENT_FILL,
+                                                            CLUTTER_BIN_ALIGNMENT_FILL));
+
+  leaf = clutter_actor_new ();
+  clutter_actor_set_background_color (leaf, CLUTTER_COLOR_LightSkyBlue);
+  clutter_actor_set_size (leaf, 16, 16);
+  clutter_actor_add_child (cell, leaf);
+
+  return cell;
+}
+
+static ClutterActor *
+create_box_layout (ClutterActor **leaves)
+{
+  ClutterActor *root, *row = NULL;
+  int i;
+
+  root = clutter_actor_new ();
+  clutter_actor_set_layout_manager (root, clutter_box_layout_new ());
+  clutter_box_layout_set_orientation (CLUTTER_BOX_LAYOUT (clutter_actor_get_layout_manager (root)),
+                                      CLUTTER_ORIENTATION_VERTICAL);
+
+  for (i = 0; i < n_cells; i++)
+    {
+      ClutterActor *cell;
+
+      if (i % N_COLUMNS == 0)
+        {
+          row = clutter_actor_new ();
+          clutter_actor_set_layout_manager (row, clutter_box_layout_new ());
+          clutter_actor_add_child (root, row);
+        }
+
+      cell = create_cell ();
+      clutter_actor_add_child (row, cell);
+      leaves[i] = clutter_actor_get_first_child (cell);
+    }
+
+  return root;
+}
+
+static ClutterActor *
+create_grid_layout (ClutterActor **leaves)
+{
+  ClutterLayoutManager *layout;
+  ClutterActor *root;
+  int i;
+
+  layout = clutter_grid_layout_new ();
+
+  root = clutter_actor_new ();
+  clutter_actor_set_layout_manager (root, layout);
+
+  for (i = 0; i < n_cells; i++)
+    {
+      ClutterActor *cell = create_cell ();
+
+      clutter_grid_layout_attach (CLUTTER_GRID_LAYOUT (layout), cell,
+                                  i % N_COLUMNS, i / N_COLUMNS,
+                                  1, 1);
+      leaves[i] = clutter_actor_get_first_child (cell);
+    }
+
+  return root;
+}
+
+int
+main (int argc, char *argv[])
+{
+  g_autoptr (GOptionContext) context = NULL;
+  g_autoptr (GError) error = NULL;
+  ClutterActor *stage, *root;
+  ClutterActor **leaves;
+  ClutterActorBox box;
+  GTimer *timer;
+  double elapsed;
+  int i, j;
+
+  context = g_option_context_new (NULL);
+  g_option_context_add_main_entries (context, entries, NULL);
+  if (!g_option_context_parse (context, &argc, &argv, &error))
+    {
+      g_printerr ("Invalid arguments: %s\n", error->message);
+      return EXIT_FAILURE;
+    }
+
+  clutter_test_init (&argc, &argv);
+
+  n_cells = MAX (n_cells, 1);
+  leaves = g_new0 (ClutterActor *, n_cells);
+
+  stage = clutter_test_get_stage ();
+  clutter_stage_set_title (CLUTTER_STAGE (stage), "Relayout Performance");
+
+  root = use_grid ? create_grid_layout (leaves) : create_box_layout (leaves);
+  clutter_actor_add_child (stage, root);
+  clutter_actor_show (stage);
+
+  /* Initial layout */
+  clutter_actor_get_allocation_box (root, &box);
+
+  g_print ("%d cells in a %s, %s\n",
+           n_cells,
+           use_grid ? "ClutterGridLayout" : "ClutterBoxLayout",
+           resize ? "resizing cells" : "queueing relayouts");
+
+  timer = g_timer_new ();
+
+  for (i = 0; i < n_iterations; i++)
+    {
+      ClutterActor *leaf = NULL;
+
+      for (j = 0; j < N_CHANGES_PER_ITERATION; j++)
+        {
+          leaf = leaves[g_random_int_range (0, n_cells)];
+
+          if (resize)
+            clutter_actor_set_width (leaf, i % 2 ? 16 : 17);
+          else
+            clutter_actor_queue_relayout (leaf);
+        }
+
+      /* Forces the relayout */
+      clutter_actor_get_allocation_box (leaf, &box);
+    }
+
+  elapsed = g_timer_elapsed (timer, NULL);
+
+  g_print ("%d relayouts in %.3f ms, %.2f us/relayout\n",
+           n_iterations,
+           elapsed * 1000.0,
+           elapsed * 1e6 / MAX (n_iterations, 1));
+
+  g_timer_destroy (timer);
+  g_free (leaves);
+
+  return EXIT_SUCCESS;
+}
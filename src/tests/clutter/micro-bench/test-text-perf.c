@@ -11,6 +11,7 @@
 static int font_size;
 static int n_chars;
 static int rows, cols;
+static int n_widths;
 
 static void
 on_paint (ClutterActor        *actor,
@@ -39,9 +40,30 @@ on_paint (ClutterActor        *actor,
   ++fps;
 }
 
+/* Simulates layout managers and animations asking for the preferred
+ * height of the labels at a different width every frame */
+static void
+request_sizes (ClutterActor *stage)
+{
+  static int frame = 0;
+  ClutterActor *label;
+  float width;
+
+  width = STAGE_WIDTH / (float) cols;
+  width *= 1.0f - (frame++ % n_widths) / (float) (n_widths * 2);
+
+  for (label = clutter_actor_get_first_child (stage);
+       label != NULL;
+       label = clutter_actor_get_next_sibling (label))
+    clutter_actor_get_preferred_height (label, width, NULL, NULL);
+}
+
 static gboolean
 queue_redraw (gpointer stage)
 {
+  if (n_widths > 0)
+    request_sizes (CLUTTER_ACTOR (stage));
+
   clutter_actor_queue_redraw (CLUTTER_ACTOR (stage));
 
   return G_SOURCE_CONTINUE;
@@ -99,6 +121,10 @@ create_label (void)
   label = clutter_text_new_with_text (font_name, str->str);
   clutter_text_set_color (CLUTTER_TEXT (label), &label_color);
 
+  /* Wrapping makes the height depend on the width */
+  if (n_widths > 0)
+    clutter_text_set_line_wrap (CLUTTER_TEXT (label), TRUE);
+
   g_free (font_name);
   g_string_free (str, TRUE);
 
@@ -119,16 +145,19 @@ main (int argc, char *argv[])
 
   clutter_test_init (&argc, &argv);
 
-  if (argc != 3)
+  if (argc != 3 && argc != 4)
     {
-      g_printerr ("Usage test-text-perf FONT_SIZE N_CHARS\n");
+      g_printerr ("Usage test-text-perf FONT_SIZE N_CHARS [N_WIDTHS]\n");
       exit (1);
     }
 
   font_size = atoi (argv[1]);
   n_chars = atoi (argv[2]);
+  n_widths = argc == 4 ? atoi (argv[3]) : 0;
 
   g_print ("Monospace %dpx, string length = %d\n", font_size, n_chars);
+  if (n_widths > 0)
+    g_print ("Requesting the height for %d different widths\n", n_widths);
 
   stage = clutter_test_get_stage ();
   clutter_actor_set_size (stage, STAGE_WIDTH, STAGE_HEIGHT);
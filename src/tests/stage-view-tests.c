@@ -973,6 +973,121 @@ meta_test_actor_stage_views_parent_views_changed (void)
   clutter_actor_destroy (container);
 }
 
+static void
+on_after_paint_view (ClutterStage     *stage,
+                     ClutterStageView *view,
+                     ClutterStageView *expected_view)
+{
+  if (view == expected_view)
+    g_object_set_data (G_OBJECT (view), "painted", GINT_TO_POINTER (TRUE));
+}
+
+static void
+wait_for_view_paint (ClutterActor     *stage,
+                     ClutterStageView *view)
+{
+  gulong after_paint_id;
+
+  g_object_set_data (G_OBJECT (view), "painted", GINT_TO_POINTER (FALSE));
+  after_paint_id = g_signal_connect (CLUTTER_STAGE (stage),
+                                     "after-paint",
+                                     G_CALLBACK (on_after_paint_view),
+                                     view);
+
+  while (!g_object_get_data (G_OBJECT (view), "painted"))
+    g_main_context_iteration (NULL, FALSE);
+
+  g_signal_handler_disconnect (stage, after_paint_id);
+}
+
+static void
+meta_test_actor_stage_views_virtual (void)
+{
+  MetaBackend *backend = meta_get_backend ();
+  MetaRenderer *renderer = meta_backend_get_renderer (backend);
+  MetaMonitorManager *monitor_manager =
+    meta_backend_get_monitor_manager (backend);
+  MetaMonitorManagerTest *monitor_manager_test =
+    META_MONITOR_MANAGER_TEST (monitor_manager);
+  ClutterActor *stage = meta_backend_get_stage (backend);
+  MonitorTestCaseSetup hotplug_test_case_setup = initial_test_case_setup;
+  MetaMonitorTestSetup *test_setup;
+  MetaRectangle overlapping_layout = { 1000, 0, 640, 480 };
+  MetaRectangle virtual_layout = { 0, 0, 640, 480 };
+  MetaRendererView *virtual_view;
+  ClutterStageView *view;
+  ClutterActor *actor;
+  ClutterFrameClock *frame_clock;
+  GList *stage_views;
+  GError *error = NULL;
+
+  /* Virtual views must not overlap the monitors */
+  virtual_view = meta_renderer_add_virtual_view (renderer, &overlapping_layout,
+                                                 45.0, &error);
+  g_assert_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_ARGUMENT);
+  g_assert_null (virtual_view);
+  g_clear_error (&error);
+
+  meta_renderer_place_virtual_view (renderer, &virtual_layout);
+  g_assert_cmpint (virtual_layout.x, ==, 2048);
+  g_assert_cmpint (virtual_layout.y, ==, 0);
+  g_assert_cmpint (virtual_layout.width, ==, 640);
+  g_assert_cmpint (virtual_layout.height, ==, 480);
+
+  virtual_view = meta_renderer_add_virtual_view (renderer, &virtual_layout,
+                                                 45.0, &error);
+  g_assert_no_error (error);
+  g_assert_nonnull (virtual_view);
+  view = CLUTTER_STAGE_VIEW (virtual_view);
+
+  stage_views = clutter_stage_peek_stage_views (CLUTTER_STAGE (stage));
+  g_assert_cmpint (g_list_length (stage_views), ==, 3);
+  g_assert_nonnull (g_list_find (stage_views, view));
+  assert_is_stage_view (view, 2048, 0, 640, 480);
+  g_assert_cmpfloat (clutter_stage_view_get_refresh_rate (view), ==, 45.0);
+
+  actor = clutter_actor_new ();
+  clutter_actor_set_size (actor, 100, 100);
+  clutter_actor_set_position (actor, 2100, 100);
+  clutter_actor_add_child (stage, actor);
+
+  clutter_actor_show (stage);
+
+  wait_for_view_paint (stage, view);
+
+  is_on_stage_views (actor, 1, view);
+  frame_clock = clutter_actor_pick_frame_clock (actor, NULL);
+  g_assert (frame_clock == clutter_stage_view_get_frame_clock (view));
+
+  /* Damage within the virtual view drives its frame clock. */
+  clutter_actor_queue_redraw (actor);
+  wait_for_view_paint (stage, view);
+
+  /* Virtual views are not tied to monitors and survive a hotplug. */
+  test_setup = create_monitor_test_setup (&hotplug_test_case_setup,
+                                          MONITOR_TEST_FLAG_NO_STORED);
+  meta_monitor_manager_test_emulate_hotplug (monitor_manager_test, test_setup);
+
+  stage_views = clutter_stage_peek_stage_views (CLUTTER_STAGE (stage));
+  g_assert_cmpint (g_list_length (stage_views), ==, 3);
+  g_assert_nonnull (g_list_find (stage_views, view));
+
+  clutter_actor_queue_redraw (actor);
+  wait_for_view_paint (stage, view);
+  is_on_stage_views (actor, 1, view);
+
+  meta_renderer_remove_virtual_view (renderer, virtual_view);
+
+  stage_views = clutter_stage_peek_stage_views (CLUTTER_STAGE (stage));
+  g_assert_cmpint (g_list_length (stage_views), ==, 2);
+
+  clutter_actor_queue_redraw (stage);
+  wait_for_paint (stage);
+  is_on_stage_views (actor, 0);
+
+  clutter_actor_destroy (actor);
+}
+
 static void
 init_tests (int argc, char **argv)
 {
@@ -998,6 +1113,8 @@ init_tests (int argc, char **argv)
                    meta_test_actor_stage_views_parent_views_rebuilt);
   g_test_add_func ("/stage-views/actor-stage-views-parent-changed",
                    meta_test_actor_stage_views_parent_views_changed);
+  g_test_add_func ("/stage-views/actor-stage-views-virtual",
+                   meta_test_actor_stage_views_virtual);
 }
 
 int
@@ -22,10 +22,16 @@
 #include <glib.h>
 #include <stdlib.h>
 
+#include <meta/display.h>
 #include <meta/main.h>
+#include <meta/meta-background-group.h>
 #include <meta/util.h>
 
+#include "compositor/compositor-private.h"
+#include "compositor/meta-cullable.h"
 #include "compositor/meta-plugin-manager.h"
+#include "compositor/meta-window-actor-private.h"
+#include "compositor/region-utils.h"
 #include "core/boxes-private.h"
 #include "core/main-private.h"
 #include "tests/boxes-tests.h"
@@ -216,6 +222,465 @@ meta_test_adjacent_to (void)
     g_assert (!meta_rectangle_is_adjacent_to (&base, &not_adjacent[i]));
 }
 
+static void
+meta_test_region_scale_and_translate (void)
+{
+  cairo_rectangle_int_t rect = { .x = 10, .y = 10, .width = 10, .height = 10 };
+  cairo_rectangle_int_t extents;
+  cairo_region_t *region;
+  cairo_region_t *scaled_region;
+
+  region = cairo_region_create_rectangle (&rect);
+
+  /* 125%: [10, 20) maps to [12.5, 25) */
+  scaled_region = meta_region_scale_and_translate_double (region,
+                                                          1.25, 1.25,
+                                                          0, 0,
+                                                          META_ROUNDING_STRATEGY_GROW);
+  cairo_region_get_extents (scaled_region, &extents);
+  g_assert_cmpint (extents.x, ==, 12);
+  g_assert_cmpint (extents.width, ==, 13);
+  cairo_region_destroy (scaled_region);
+
+  scaled_region = meta_region_scale_and_translate_double (region,
+                                                          1.25, 1.25,
+                                                          0, 0,
+                                                          META_ROUNDING_STRATEGY_SHRINK);
+  cairo_region_get_extents (scaled_region, &extents);
+  g_assert_cmpint (extents.x, ==, 13);
+  g_assert_cmpint (extents.width, ==, 12);
+  cairo_region_destroy (scaled_region);
+
+  /* Converting back and forth never shrinks a grown region */
+  scaled_region = meta_region_scale_and_translate_double (region,
+                                                          1.0 / 1.5, 1.0 / 1.5,
+                                                          -0.5, -0.5,
+                                                          META_ROUNDING_STRATEGY_GROW);
+  cairo_region_destroy (region);
+  region = meta_region_scale_and_translate_double (scaled_region,
+                                                   1.5, 1.5,
+                                                   0.75, 0.75,
+                                                   META_ROUNDING_STRATEGY_GROW);
+  g_assert (cairo_region_contains_rectangle (region, &rect) ==
+            CAIRO_REGION_OVERLAP_IN);
+  cairo_region_destroy (scaled_region);
+
+  /* Slivers thinner than a pixel are dropped when shrinking */
+  scaled_region = meta_region_scale_and_translate_double (region,
+                                                          0.05, 0.05,
+                                                          0.5, 0.5,
+                                                          META_ROUNDING_STRATEGY_SHRINK);
+  g_assert (cairo_region_is_empty (scaled_region));
+  cairo_region_destroy (scaled_region);
+
+  cairo_region_destroy (region);
+}
+
+static void
+meta_test_region_pool (void)
+{
+  cairo_rectangle_int_t rects[] = {
+    { .x = 0, .y = 0, .width = 10, .height = 10 },
+    { .x = 20, .y = 0, .width = 10, .height = 10 },
+  };
+  cairo_region_t *region;
+  cairo_region_t *copy;
+
+  region = cairo_region_create_rectangles (rects, G_N_ELEMENTS (rects));
+
+  copy = meta_region_pool_acquire_copy (region);
+  g_assert (cairo_region_equal (copy, region));
+  meta_region_pool_release (copy);
+
+  /* Recycled regions are always empty */
+  copy = meta_region_pool_acquire ();
+  g_assert (cairo_region_is_empty (copy));
+  meta_region_pool_release (copy);
+
+  copy = meta_region_pool_acquire_rectangle (&rects[1]);
+  g_assert_cmpint (cairo_region_num_rectangles (copy), ==, 1);
+  g_assert (cairo_region_contains_rectangle (copy, &rects[0]) ==
+            CAIRO_REGION_OVERLAP_OUT);
+  meta_region_pool_release (copy);
+
+  cairo_region_destroy (region);
+}
+
+/* A cullable behaving like MetaSurfaceActor: it keeps copies of the
+ * regions it is culled with for painting, and subtracts its opaque area
+ * using a temporary region from the pool. */
+#define META_TYPE_TEST_CULLABLE (meta_test_cullable_get_type ())
+G_DECLARE_FINAL_TYPE (MetaTestCullable, meta_test_cullable,
+                      META, TEST_CULLABLE, ClutterActor)
+
+struct _MetaTestCullable
+{
+  ClutterActor parent;
+
+  cairo_region_t *unobscured_region;
+  cairo_region_t *clip_region;
+};
+
+static void meta_test_cullable_iface_init (MetaCullableInterface *iface);
+
+G_DEFINE_TYPE_WITH_CODE (MetaTestCullable, meta_test_cullable,
+                         CLUTTER_TYPE_ACTOR,
+                         G_IMPLEMENT_INTERFACE (META_TYPE_CULLABLE,
+                                                meta_test_cullable_iface_init))
+
+static void
+meta_test_cullable_cull_out (MetaCullable   *cullable,
+                             cairo_region_t *unobscured_region,
+                             cairo_region_t *clip_region)
+{
+  MetaTestCullable *test_cullable = META_TEST_CULLABLE (cullable);
+  cairo_rectangle_int_t opaque_rect = { 0, };
+  cairo_region_t *opaque_region;
+  float width, height;
+
+  g_clear_pointer (&test_cullable->unobscured_region, cairo_region_destroy);
+  g_clear_pointer (&test_cullable->clip_region, cairo_region_destroy);
+
+  if (!unobscured_region || !clip_region)
+    return;
+
+  test_cullable->unobscured_region = cairo_region_copy (unobscured_region);
+  test_cullable->clip_region = cairo_region_copy (clip_region);
+
+  clutter_actor_get_size (CLUTTER_ACTOR (cullable), &width, &height);
+  opaque_rect.width = width;
+  opaque_rect.height = height;
+
+  opaque_region = meta_region_pool_acquire_rectangle (&opaque_rect);
+  cairo_region_subtract (unobscured_region, opaque_region);
+  cairo_region_subtract (clip_region, opaque_region);
+  meta_region_pool_release (opaque_region);
+}
+
+static gboolean
+meta_test_cullable_is_untransformed (MetaCullable *cullable)
+{
+  double x_scale, y_scale;
+
+  clutter_actor_get_scale (CLUTTER_ACTOR (cullable), &x_scale, &y_scale);
+
+  return x_scale == 1.0 && y_scale == 1.0;
+}
+
+static void
+meta_test_cullable_reset_culling (MetaCullable *cullable)
+{
+  MetaTestCullable *test_cullable = META_TEST_CULLABLE (cullable);
+
+  g_clear_pointer (&test_cullable->unobscured_region, cairo_region_destroy);
+  g_clear_pointer (&test_cullable->clip_region, cairo_region_destroy);
+}
+
+static void
+meta_test_cullable_iface_init (MetaCullableInterface *iface)
+{
+  iface->cull_out = meta_test_cullable_cull_out;
+  iface->is_untransformed = meta_test_cullable_is_untransformed;
+  iface->reset_culling = meta_test_cullable_reset_culling;
+}
+
+static void
+meta_test_cullable_finalize (GObject *object)
+{
+  meta_test_cullable_reset_culling (META_CULLABLE (object));
+
+  G_OBJECT_CLASS (meta_test_cullable_parent_class)->finalize (object);
+}
+
+static void
+meta_test_cullable_class_init (MetaTestCullableClass *klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+
+  object_class->finalize = meta_test_cullable_finalize;
+}
+
+static void
+meta_test_cullable_init (MetaTestCullable *test_cullable)
+{
+}
+
+static ClutterActor *
+add_test_cullable (ClutterActor *parent,
+                   float         x,
+                   float         y,
+                   double        scale)
+{
+  ClutterActor *actor;
+
+  actor = g_object_new (META_TYPE_TEST_CULLABLE, NULL);
+  clutter_actor_set_position (actor, x, y);
+  clutter_actor_set_size (actor, 100, 100);
+  clutter_actor_set_scale (actor, scale, scale);
+  clutter_actor_add_child (parent, actor);
+
+  return actor;
+}
+
+static void
+cull_out_group (ClutterActor *group)
+{
+  cairo_rectangle_int_t visible_rect = { 0, 0, 400, 400 };
+  cairo_region_t *unobscured_region;
+  cairo_region_t *clip_region;
+
+  unobscured_region = meta_region_pool_acquire_rectangle (&visible_rect);
+  clip_region = meta_region_pool_acquire_rectangle (&visible_rect);
+
+  meta_cullable_cull_out (META_CULLABLE (group),
+                          unobscured_region, clip_region);
+  meta_cullable_reset_culling (META_CULLABLE (group));
+
+  meta_region_pool_release (unobscured_region);
+  meta_region_pool_release (clip_region);
+}
+
+static void
+meta_test_region_pool_culling (void)
+{
+  MetaBackend *backend = meta_get_backend ();
+  ClutterActor *stage = meta_backend_get_stage (backend);
+  ClutterActor *group;
+  unsigned int n_hits, n_misses;
+  unsigned int n_hits_before, n_misses_before;
+  int i;
+
+  group = meta_background_group_new ();
+  add_test_cullable (group, 0, 0, 1.0);
+  add_test_cullable (group, 200, 0, 0.5);
+  add_test_cullable (group, 0, 200, 1.0);
+  clutter_actor_add_child (stage, group);
+
+  /* The first pass may have to fill the pool */
+  cull_out_group (group);
+
+  meta_region_pool_get_stats (&n_hits_before, &n_misses_before);
+
+  for (i = 0; i < 10; i++)
+    cull_out_group (group);
+
+  /* Two regions for the group and one per child every pass; as long as
+   * every region taken from the pool is given back, all of them are
+   * recycled */
+  meta_region_pool_get_stats (&n_hits, &n_misses);
+  g_assert_cmpuint (n_misses, ==, n_misses_before);
+  g_assert_cmpuint (n_hits - n_hits_before, ==, 10 * (2 + 3));
+
+  clutter_actor_destroy (group);
+}
+
+#define N_FAKE_WINDOWS 200
+#define FAKE_CACHE_SIZE (1024 * 1024)
+#define FAKE_CONTENT_SIZE (4 * 1024 * 1024)
+#define FAKE_SNAPSHOT_SIZE (FAKE_CONTENT_SIZE / 16)
+
+typedef struct _FakeWindow
+{
+  gboolean visible;
+  gboolean has_snapshot;
+  size_t cache_size;
+  size_t content_size;
+
+  int *release_serial;
+  int caches_released;
+  int contents_released;
+} FakeWindow;
+
+static void
+fake_window_get_usage (gpointer          user_data,
+                       MetaTextureUsage *usage)
+{
+  FakeWindow *window = user_data;
+
+  usage->visible = window->visible;
+  usage->has_snapshot = window->has_snapshot;
+  usage->cache_size = window->cache_size;
+  usage->content_size = window->content_size;
+}
+
+static void
+fake_window_release (gpointer           user_data,
+                     MetaTextureRelease release)
+{
+  FakeWindow *window = user_data;
+
+  g_assert_false (window->visible);
+
+  switch (release)
+    {
+    case META_TEXTURE_RELEASE_CACHES:
+      window->cache_size = 0;
+      window->caches_released = ++(*window->release_serial);
+      break;
+    case META_TEXTURE_RELEASE_CONTENTS:
+      g_assert_false (window->has_snapshot);
+      window->content_size = FAKE_SNAPSHOT_SIZE;
+      window->has_snapshot = TRUE;
+      window->contents_released = ++(*window->release_serial);
+      break;
+    }
+}
+
+static void
+meta_test_texture_budget_evict (void)
+{
+  MetaDisplay *display = meta_get_display ();
+  MetaCompositor *compositor = meta_display_get_compositor (display);
+  MetaTextureBudget *budget = meta_compositor_get_texture_budget (compositor);
+  MetaTextureBudgetEntry *entries[N_FAKE_WINDOWS];
+  FakeWindow windows[N_FAKE_WINDOWS];
+  size_t old_limit;
+  size_t usage;
+  int release_serial = 0;
+  int n_hidden = N_FAKE_WINDOWS / 2;
+  int n_snapshots = 10;
+  int last_cache_release = 0;
+  int i;
+
+  old_limit = meta_texture_budget_get_limit (budget);
+  meta_texture_budget_set_limit (budget, G_MAXSIZE);
+
+  for (i = 0; i < N_FAKE_WINDOWS; i++)
+    {
+      windows[i] = (FakeWindow) {
+        .visible = TRUE,
+        .cache_size = FAKE_CACHE_SIZE,
+        .content_size = FAKE_CONTENT_SIZE,
+        .release_serial = &release_serial,
+      };
+      entries[i] = meta_texture_budget_add_entry (budget,
+                                                  fake_window_get_usage,
+                                                  fake_window_release,
+                                                  &windows[i]);
+    }
+
+  /* Hide windows one check at a time, so that the first one has been
+   * hidden the longest.
+   */
+  meta_texture_budget_enforce (budget);
+  for (i = 0; i < n_hidden; i++)
+    {
+      windows[i].visible = FALSE;
+      meta_texture_budget_enforce (budget);
+    }
+
+  g_assert_cmpint (release_serial, ==, 0);
+
+  /* Require all caches and a few textures of hidden windows to go */
+  usage = meta_texture_budget_get_usage (budget);
+  meta_texture_budget_set_limit (budget,
+                                 usage -
+                                 n_hidden * FAKE_CACHE_SIZE -
+                                 n_snapshots * (FAKE_CONTENT_SIZE -
+                                                FAKE_SNAPSHOT_SIZE));
+  meta_texture_budget_enforce (budget);
+
+  g_assert_cmpuint (meta_texture_budget_get_usage (budget), <=,
+                    meta_texture_budget_get_limit (budget));
+
+  for (i = 0; i < N_FAKE_WINDOWS; i++)
+    {
+      if (windows[i].visible)
+        {
+          g_assert_cmpuint (windows[i].cache_size, ==, FAKE_CACHE_SIZE);
+          g_assert_cmpuint (windows[i].content_size, ==, FAKE_CONTENT_SIZE);
+          continue;
+        }
+
+      g_assert_cmpint (windows[i].caches_released, >, last_cache_release);
+      last_cache_release = windows[i].caches_released;
+
+      /* Textures are only replaced once every cache is gone, and the
+       * least recently visible windows go first.
+       */
+      if (windows[i].has_snapshot)
+        {
+          g_assert_cmpint (windows[i].contents_released, >, n_hidden);
+          if (i > 0)
+            {
+              g_assert_true (windows[i - 1].has_snapshot);
+              g_assert_cmpint (windows[i].contents_released, >,
+                               windows[i - 1].contents_released);
+            }
+        }
+    }
+
+  g_assert_true (windows[0].has_snapshot);
+  g_assert_false (windows[n_hidden - 1].has_snapshot);
+
+  /* Enforcing again with nothing changed releases nothing more */
+  i = release_serial;
+  meta_texture_budget_enforce (budget);
+  g_assert_cmpint (release_serial, ==, i);
+
+  for (i = 0; i < N_FAKE_WINDOWS; i++)
+    meta_texture_budget_remove_entry (budget, entries[i]);
+
+  meta_texture_budget_set_limit (budget, old_limit);
+}
+
+static void
+meta_test_texture_budget_clone_visible (void)
+{
+  MetaBackend *backend = meta_get_backend ();
+  ClutterActor *stage = meta_backend_get_stage (backend);
+  TestClient *test_client;
+  MetaWindow *window;
+  MetaWindowActor *window_actor;
+  ClutterActor *clone;
+  MetaTextureUsage usage;
+  g_autoptr (GError) error = NULL;
+
+  test_client = test_client_new ("texture_budget_client",
+                                 META_WINDOW_CLIENT_TYPE_WAYLAND,
+                                 &error);
+  if (!test_client)
+    g_error ("Failed to launch test client: %s", error->message);
+
+  if (!test_client_do (test_client, &error,
+                       "create", "1",
+                       NULL) ||
+      !test_client_do (test_client, &error,
+                       "show", "1",
+                       NULL))
+    g_error ("Failed to show window: %s", error->message);
+
+  window = test_client_find_window (test_client, "1", &error);
+  if (!window)
+    g_error ("Failed to find the window: %s", error->message);
+  test_client_wait_for_window_shown (test_client, window);
+
+  window_actor = meta_window_actor_from_window (window);
+  meta_window_actor_get_texture_usage (window_actor, &usage);
+  g_assert_true (usage.visible);
+
+  clutter_actor_hide (CLUTTER_ACTOR (window_actor));
+  meta_window_actor_get_texture_usage (window_actor, &usage);
+  g_assert_false (usage.visible);
+
+  /* A window only shown through a clone still counts as visible */
+  clone = clutter_clone_new (CLUTTER_ACTOR (window_actor));
+  clutter_actor_add_child (stage, clone);
+  g_assert_true (clutter_actor_is_mapped (clone));
+  meta_window_actor_get_texture_usage (window_actor, &usage);
+  g_assert_true (usage.visible);
+
+  clutter_actor_destroy (clone);
+  meta_window_actor_get_texture_usage (window_actor, &usage);
+  g_assert_false (usage.visible);
+
+  clutter_actor_show (CLUTTER_ACTOR (window_actor));
+
+  if (!test_client_quit (test_client, &error))
+    g_error ("Failed to quit test client: %s", error->message);
+  test_client_destroy (test_client);
+}
+
 static gboolean
 run_tests (gpointer data)
 {
@@ -250,6 +715,18 @@ init_tests (int argc, char **argv)
 
   g_test_add_func ("/core/boxes/adjacent-to", meta_test_adjacent_to);
 
+  g_test_add_func ("/compositor/region-utils/scale-and-translate",
+                   meta_test_region_scale_and_translate);
+  g_test_add_func ("/compositor/region-utils/pool",
+                   meta_test_region_pool);
+  g_test_add_func ("/compositor/region-utils/pool-culling",
+                   meta_test_region_pool_culling);
+
+  g_test_add_func ("/compositor/texture-budget/evict",
+                   meta_test_texture_budget_evict);
+  g_test_add_func ("/compositor/texture-budget/clone-visible",
+                   meta_test_texture_budget_clone_visible);
+
   init_monitor_store_tests ();
   init_monitor_config_migration_tests ();
   init_monitor_tests ();
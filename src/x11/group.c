@@ -219,6 +219,10 @@ meta_window_group_leader_changed (MetaWindow *window)
 {
   remove_window_from_group (window);
   meta_window_compute_group (window);
+
+  /* Windows transient for either group are constrained differently now */
+  if (meta_window_is_in_stack (window))
+    meta_stack_update_transient (window->display->stack, window);
 }
 
 void